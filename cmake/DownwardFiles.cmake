@@ -5,6 +5,7 @@ create_library(
         downward/abstract_task
         downward/cached_heuristic
         downward/command_line
+        downward/concurrent_state_registry
         downward/evaluation_context
         downward/evaluation_result
         downward/evaluator
@@ -30,9 +31,10 @@ create_library(
         downward/state
         downward/state_id
         downward/state_registry
+        downward/state_storage
         downward/task_id
         downward/task_proxy
-    DEPENDS causal_graph int_hash_set int_packer ordered_set segmented_vector subscriber successor_generator task_properties
+    DEPENDS causal_graph flat_operator_table int_hash_set int_packer ordered_set segmented_vector subscriber successor_generator task_properties Threads::Threads
     TARGET downward
     CORE_LIBRARY
 )
@@ -120,6 +122,14 @@ create_library(
     TARGET downward
 )
 
+create_library(
+    NAME bucket_open_list
+    HELP "Open list that stores entries in buckets indexed by small integer keys"
+    SOURCES
+        downward/open_lists/bucket_open_list
+    TARGET downward
+)
+
 create_library(
     NAME epsilon_greedy_open_list
     HELP "Open list that chooses an entry randomly with probability epsilon"
@@ -128,6 +138,14 @@ create_library(
     TARGET downward
 )
 
+create_library(
+    NAME multi_queue_open_list
+    HELP "Open list that alternates between queues over shared entry storage"
+    SOURCES
+        downward/open_lists/multi_queue_open_list
+    TARGET downward
+)
+
 create_library(
     NAME pareto_open_list
     HELP "Pareto open list"
@@ -152,6 +170,14 @@ create_library(
     TARGET downward
 )
 
+create_library(
+    NAME mmap_state_storage
+    HELP "State storage in a memory-mapped file"
+    SOURCES
+        downward/state_storages/mmap_state_storage
+    TARGET downward
+)
+
 create_library(
     NAME int_hash_set
     HELP "Hash set storing non-negative integers"
@@ -159,11 +185,19 @@ create_library(
         downward/algorithms/int_hash_set
 )
 
+create_library(
+    NAME int_hash_set_64
+    HELP "Hash set storing non-negative 64-bit integers with SIMD lookups"
+    SOURCES
+        downward/algorithms/int_hash_set_64
+)
+
 create_library(
     NAME int_packer
     HELP "Greedy bin packing algorithm to pack integer variables with small domains tightly into memory"
     SOURCES
         downward/algorithms/int_packer
+    DEPENDS utils
 )
 
 create_library(
@@ -266,7 +300,7 @@ create_library(
     HELP "Basic classes used for all search engines"
     SOURCES
         downward/search_algorithms/search_common
-    DEPENDS alternation_open_list g_evaluator best_first_open_list sum_evaluator tiebreaking_open_list weighted_evaluator
+    DEPENDS alternation_open_list g_evaluator best_first_open_list bucket_open_list sum_evaluator weighted_evaluator
 )
 
 create_library(
@@ -313,6 +347,151 @@ create_library(
     TARGET downward
 )
 
+create_library(
+    NAME lazy_search
+    HELP "Lazy search algorithm"
+    SOURCES
+        downward/search_algorithms/lazy_search
+    DEPENDS successor_generator
+)
+
+create_library(
+    NAME plugin_lazy_greedy
+    HELP "Lazy greedy best-first search"
+    SOURCES
+        downward/search_algorithms/plugin_lazy_greedy
+    DEPENDS lazy_search search_common
+    TARGET downward
+)
+
+create_library(
+    NAME plugin_lazy_wastar
+    HELP "Weighted lazy A* search"
+    SOURCES
+        downward/search_algorithms/plugin_lazy_wastar
+    DEPENDS lazy_search search_common
+    TARGET downward
+)
+
+create_library(
+    NAME anytime_wastar
+    HELP "Anytime weighted A* search"
+    SOURCES
+        downward/search_algorithms/anytime_wastar
+    DEPENDS search_common successor_generator
+)
+
+create_library(
+    NAME plugin_anytime_wastar
+    HELP "Anytime weighted A* search"
+    SOURCES
+        downward/search_algorithms/plugin_anytime_wastar
+    DEPENDS anytime_wastar
+    TARGET downward
+)
+
+create_library(
+    NAME idastar
+    HELP "IDA* search"
+    SOURCES
+        downward/search_algorithms/idastar
+    DEPENDS successor_generator task_properties
+)
+
+create_library(
+    NAME plugin_idastar
+    HELP "IDA* search"
+    SOURCES
+        downward/search_algorithms/plugin_idastar
+    DEPENDS idastar
+    TARGET downward
+)
+
+create_library(
+    NAME rbfs
+    HELP "Recursive best-first search"
+    SOURCES
+        downward/search_algorithms/rbfs
+    DEPENDS successor_generator task_properties
+)
+
+create_library(
+    NAME plugin_rbfs
+    HELP "Recursive best-first search"
+    SOURCES
+        downward/search_algorithms/plugin_rbfs
+    DEPENDS rbfs
+    TARGET downward
+)
+
+create_library(
+    NAME bidirectional_astar
+    HELP "Bidirectional A* search"
+    SOURCES
+        downward/search_algorithms/bidirectional_astar
+    DEPENDS regression_successor_generator successor_generator task_properties
+)
+
+create_library(
+    NAME plugin_bidirectional_astar
+    HELP "Bidirectional A* search"
+    SOURCES
+        downward/search_algorithms/plugin_bidirectional_astar
+    DEPENDS bidirectional_astar
+    TARGET downward
+)
+
+create_library(
+    NAME beam_search
+    HELP "Beam search"
+    SOURCES
+        downward/search_algorithms/beam_search
+    DEPENDS successor_generator task_properties
+)
+
+create_library(
+    NAME plugin_beam
+    HELP "Beam search"
+    SOURCES
+        downward/search_algorithms/plugin_beam
+    DEPENDS beam_search
+    TARGET downward
+)
+
+create_library(
+    NAME external_bfs
+    HELP "External breadth-first search"
+    SOURCES
+        downward/search_algorithms/external_bfs
+    DEPENDS successor_generator task_properties
+)
+
+create_library(
+    NAME plugin_external_bfs
+    HELP "External breadth-first search"
+    SOURCES
+        downward/search_algorithms/plugin_external_bfs
+    DEPENDS external_bfs
+    TARGET downward
+)
+
+create_library(
+    NAME hda_astar
+    HELP "Hash-distributed A* search"
+    SOURCES
+        downward/search_algorithms/hda_astar
+    DEPENDS search_common successor_generator Threads::Threads
+)
+
+create_library(
+    NAME plugin_hda_astar
+    HELP "Hash-distributed A* search"
+    SOURCES
+        downward/search_algorithms/plugin_hda_astar
+    DEPENDS hda_astar
+    TARGET downward
+)
+
 create_library(
     NAME core_tasks
     HELP "Core task transformations"
@@ -331,6 +510,21 @@ create_library(
         downward/task_utils/causal_graph
 )
 
+create_library(
+    NAME flat_operator_table
+    HELP "Flat operator table"
+    SOURCES
+        downward/task_utils/flat_operator_table
+)
+
+create_library(
+    NAME regression_successor_generator
+    HELP "Regression of partial states for backward search"
+    SOURCES
+        downward/task_utils/regression_successor_generator
+    DEPENDS flat_operator_table
+)
+
 create_library(
     NAME sampling
     HELP "Sampling"
@@ -343,10 +537,13 @@ create_library(
     NAME successor_generator
     HELP "Successor generator"
     SOURCES
+        downward/task_utils/incremental_successor_generator
         downward/task_utils/successor_generator
+        downward/task_utils/successor_generator_bitset
         downward/task_utils/successor_generator_factory
         downward/task_utils/successor_generator_internals
-    DEPENDS task_properties
+        downward/task_utils/successor_generator_program
+    DEPENDS flat_operator_table int_packer task_properties
 )
 
 create_library(
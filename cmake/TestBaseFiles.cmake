@@ -23,6 +23,8 @@ create_library(
     HELP "Utility for test tasks"
     SOURCES
         tests/utils/task_utils
+    DEPENDS
+        test_domains
     TARGET project_tests
 )
 
@@ -50,6 +52,7 @@ create_library(
     SOURCES
         tests/utils/search_utils
     DEPENDS
+        GTest::gtest
         search_common
         eager_search
     TARGET project_tests
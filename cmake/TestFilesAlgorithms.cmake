@@ -0,0 +1,22 @@
+create_library(
+    NAME int_hash_set_public_tests
+    HELP "Int hash set public tests and benchmark"
+    SOURCES
+        tests/public/algorithm_tests/int_hash_set_tests
+    DEPENDS
+        GTest::gtest
+        int_hash_set
+        int_hash_set_64
+    TARGET project_tests
+)
+
+create_library(
+    NAME priority_queues_public_tests
+    HELP "Priority queue public tests and benchmark"
+    SOURCES
+        tests/public/algorithm_tests/priority_queues_tests
+    DEPENDS
+        GTest::gtest
+        priority_queues
+    TARGET project_tests
+)
@@ -0,0 +1,181 @@
+create_library(
+    NAME hda_astar_public_tests
+    HELP "Hash-distributed A* public tests"
+    SOURCES
+        tests/public/search_tests/hda_astar_tests
+    DEPENDS
+        GTest::gtest
+        blind_search_heuristic
+        hda_astar
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME state_registry_public_tests
+    HELP "State registry public tests"
+    SOURCES
+        tests/public/search_tests/concurrent_state_registry_tests
+        tests/public/search_tests/state_registry_tests
+        tests/public/search_tests/state_storage_tests
+    DEPENDS
+        GTest::gtest
+        blind_search_heuristic
+        mmap_state_storage
+        search_test_utils
+        test_domains
+        task_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME eager_search_public_tests
+    HELP "Eager search public tests"
+    SOURCES
+        tests/public/search_tests/eager_search_tests
+    DEPENDS
+        GTest::gtest
+        blind_search_heuristic
+        eager_search
+        goal_count_heuristic
+        search_common
+        search_test_utils
+        test_domains
+        task_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME anytime_wastar_public_tests
+    HELP "Anytime weighted A* public tests"
+    SOURCES
+        tests/public/search_tests/anytime_wastar_tests
+    DEPENDS
+        GTest::gtest
+        anytime_wastar
+        blind_search_heuristic
+        goal_count_heuristic
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME lazy_search_public_tests
+    HELP "Lazy search public tests"
+    SOURCES
+        tests/public/search_tests/lazy_search_tests
+    DEPENDS
+        GTest::gtest
+        blind_search_heuristic
+        lazy_search
+        search_common
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME successor_generator_public_tests
+    HELP "Successor generator public tests"
+    SOURCES
+        tests/public/search_tests/successor_generator_tests
+    DEPENDS
+        GTest::gtest
+        successor_generator
+        test_domains
+        task_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME linear_memory_search_public_tests
+    HELP "IDA* and RBFS public tests"
+    SOURCES
+        tests/public/search_tests/linear_memory_search_tests
+    DEPENDS
+        GTest::gtest
+        idastar
+        rbfs
+        blind_search_heuristic
+        goal_count_heuristic
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME bidirectional_astar_public_tests
+    HELP "Bidirectional A* public tests"
+    SOURCES
+        tests/public/search_tests/bidirectional_astar_tests
+    DEPENDS
+        GTest::gtest
+        bidirectional_astar
+        blind_search_heuristic
+        goal_count_heuristic
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME beam_search_public_tests
+    HELP "Beam search public tests"
+    SOURCES
+        tests/public/search_tests/beam_search_tests
+    DEPENDS
+        GTest::gtest
+        beam_search
+        blind_search_heuristic
+        goal_count_heuristic
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME external_bfs_public_tests
+    HELP "External breadth-first search public tests"
+    SOURCES
+        tests/public/search_tests/external_bfs_tests
+    DEPENDS
+        GTest::gtest
+        external_bfs
+        blind_search_heuristic
+        test_domains
+        task_utils
+        search_test_utils
+    TARGET project_tests
+)
+
+create_library(
+    NAME open_list_public_tests
+    HELP "Open list public tests"
+    SOURCES
+        tests/public/search_tests/open_list_tests
+    DEPENDS
+        GTest::gtest
+        best_first_open_list
+        bucket_open_list
+        eager_search
+        epsilon_greedy_open_list
+        g_evaluator
+        goal_count_heuristic
+        multi_queue_open_list
+        pareto_open_list
+        sum_evaluator
+        test_domains
+        tiebreaking_open_list
+        task_utils
+        type_based_open_list
+        weighted_evaluator
+    TARGET project_tests
+)
@@ -26,6 +26,7 @@ class ClassicalPlanningTask;
 class TaskID;
 class StateID;
 class StateRegistry;
+class StateRegistryBase;
 
 namespace causal_graph {
 class CausalGraph;
@@ -126,10 +127,11 @@ public:
 
 private:
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
 
-    // This method is meant to be called only by the state registry.
+    // This method is meant to be called only by the state registries.
     State create_state(
-        const StateRegistry& registry,
+        const StateRegistryBase& registry,
         StateID id,
         const PackedStateBin* buffer) const;
 };
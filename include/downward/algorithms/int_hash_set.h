@@ -120,7 +120,7 @@ class IntHashSet {
         buckets.resize(new_capacity);
         for (const Bucket& bucket : old_buckets) {
             if (bucket.full()) {
-                insert(bucket.key, bucket.hash);
+                insert_new_key(bucket.key, bucket.hash);
             }
         }
         (void)num_entries_before;
@@ -198,28 +198,20 @@ class IntHashSet {
 
     /*
       Private method that inserts a key and its corresponding hash into the
-      hash set.
+      hash set. The hash set must not contain an equal key yet.
 
       The method ensures that each key is at most "max_distance" buckets away
       from its ideal bucket by moving the closest free bucket towards the ideal
       bucket. If this can't be achieved, we resize the vector, reinsert the old
       keys and try inserting the new key again.
 
-      For the return type, see the public insert() method.
-
-      Note that the private insert() may call enlarge() and therefore rehash(),
-      which itself calls the private insert() again.
+      Note that insert_new_key() may call enlarge() and therefore rehash(),
+      which itself calls insert_new_key() again.
     */
-    std::pair<KeyType, bool> insert(KeyType key, HashType hash)
+    void insert_new_key(KeyType key, HashType hash)
     {
         assert(hasher(key) == hash);
-
-        /* If the hash set already contains the key, return the key and a
-           Boolean indicating that no new key has been inserted. */
-        KeyType equal_key = find_equal_key(key, hash);
-        if (equal_key != Bucket::empty_bucket_key) {
-            return std::make_pair(equal_key, false);
-        }
+        assert(find_equal_key(key, hash) == Bucket::empty_bucket_key);
 
         assert(num_entries <= capacity());
         if (num_entries == capacity()) {
@@ -264,13 +256,28 @@ class IntHashSet {
                 /* Free bucket could not be moved close enough to ideal bucket.
                    -> Enlarge and try inserting again. */
                 enlarge();
-                return insert(key, hash);
+                insert_new_key(key, hash);
+                return;
             }
         }
         assert(utils::in_bounds(free_index, buckets));
         assert(!buckets[free_index].full());
         buckets[free_index] = Bucket(key, hash);
         ++num_entries;
+    }
+
+    /*
+      For the return type, see the public insert() method.
+    */
+    std::pair<KeyType, bool> insert(KeyType key, HashType hash)
+    {
+        /* If the hash set already contains the key, return the key and a
+           Boolean indicating that no new key has been inserted. */
+        KeyType equal_key = find_equal_key(key, hash);
+        if (equal_key != Bucket::empty_bucket_key) {
+            return std::make_pair(equal_key, false);
+        }
+        insert_new_key(key, hash);
         return std::make_pair(key, true);
     }
 
@@ -299,6 +306,52 @@ public:
         return insert(key, hasher(key));
     }
 
+    /*
+      Insert a key whose hash is already known. The hash must be the one
+      computed by the hasher for the key. See insert(KeyType) for the return
+      value.
+    */
+    std::pair<KeyType, bool> insert_with_hash(KeyType key, HashType hash)
+    {
+        assert(key >= 0);
+        return insert(key, hash);
+    }
+
+    /*
+      Insert a key with a known hash that is not equal to any key in the hash
+      set, e.g., because find() just failed to find it. This saves the second
+      probe of insert_with_hash().
+    */
+    void insert_new_with_hash(KeyType key, HashType hash)
+    {
+        assert(key >= 0);
+        insert_new_key(key, hash);
+    }
+
+    /*
+      Find a key that is equal to an object which is not stored in the hash
+      set, e.g., because it is not stored in the data the keys refer to yet.
+      The caller passes the hash the hasher would compute for a key referring
+      to the object and a predicate that tells whether a given key is equal
+      to the object.
+
+      Return the equal key or -1 if the hash set contains no such key.
+    */
+    template <typename Predicate>
+    KeyType find(HashType hash, const Predicate& is_equal_key) const
+    {
+        int ideal_index = get_bucket(hash);
+        for (int i = 0; i < MAX_DISTANCE; ++i) {
+            int index = get_bucket(ideal_index + i);
+            const Bucket& bucket = buckets[index];
+            if (bucket.full() && bucket.hash == hash &&
+                is_equal_key(bucket.key)) {
+                return bucket.key;
+            }
+        }
+        return Bucket::empty_bucket_key;
+    }
+
     void dump(utils::LogProxy& log) const
     {
         int num_buckets = capacity();
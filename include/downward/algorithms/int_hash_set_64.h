@@ -0,0 +1,287 @@
+#ifndef ALGORITHMS_INT_HASH_SET_64_H
+#define ALGORITHMS_INT_HASH_SET_64_H
+
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace int_hash_set {
+using KeyType64 = std::int64_t;
+using HashType64 = std::uint64_t;
+
+/*
+  Variant of IntHashSet for very large hash sets. Keys are non-negative
+  64-bit integers, hashes have 64 bits and the number of buckets is only
+  limited by the available memory.
+
+  The interface is the same as the one of IntHashSet. Hasher has to map keys
+  to HashType64 and should distribute them uniformly over all 64 bits: the
+  lower bits select the ideal bucket and the upper bits the fingerprint (see
+  below).
+
+  Implementation:
+
+  Like IntHashSet, we use hopscotch hashing to keep each key less than
+  NEIGHBORHOOD_SIZE buckets away from its ideal bucket. Unlike IntHashSet,
+  the neighbourhood of a bucket does not wrap around: we allocate
+  NEIGHBORHOOD_SIZE - 1 additional buckets after the last ideal bucket.
+
+  One-byte fingerprints of the hashes are stored in a separate vector from
+  the keys and hashes. A lookup compares the fingerprints of the whole
+  neighbourhood with a single SIMD comparison (AVX2 or two SSE2 comparisons,
+  depending on the target) and only looks at the hashes and keys of the
+  matching buckets.
+  Fingerprint 0 marks empty buckets.
+
+  This requires 17 bytes per bucket compared to 8 bytes for IntHashSet, so
+  only use this class if IntHashSet is too small.
+*/
+template <typename Hasher, typename Equal>
+class IntHashSet64 {
+    static const int NEIGHBORHOOD_SIZE = 32;
+    static const std::uint8_t EMPTY_FINGERPRINT = 0;
+
+    struct Bucket {
+        HashType64 hash;
+        KeyType64 key;
+    };
+
+    Hasher hasher;
+    Equal equal;
+    // Number of ideal buckets, always a power of 2.
+    std::size_t num_buckets;
+    std::vector<std::uint8_t> fingerprints;
+    std::vector<Bucket> buckets;
+    std::size_t num_entries;
+    int num_resizes;
+
+    static std::uint8_t get_fingerprint(HashType64 hash)
+    {
+        // Setting the highest bit keeps the fingerprint non-empty.
+        return static_cast<std::uint8_t>((hash >> 57) | 0x80);
+    }
+
+    std::size_t get_ideal_bucket(HashType64 hash) const
+    {
+        return hash & (num_buckets - 1);
+    }
+
+    /*
+      Return a bitmask with bit i set iff bucket first_bucket + i has the
+      given fingerprint.
+    */
+    std::uint32_t
+    match_fingerprints(std::size_t first_bucket, std::uint8_t fingerprint) const
+    {
+        static_assert(NEIGHBORHOOD_SIZE == 32);
+        const std::uint8_t* data = fingerprints.data() + first_bucket;
+#if defined(__AVX2__)
+        __m256i block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i matches =
+            _mm256_cmpeq_epi8(block, _mm256_set1_epi8(fingerprint));
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+#elif defined(__SSE2__)
+        __m128i pattern = _mm_set1_epi8(fingerprint);
+        __m128i low =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i high =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        std::uint32_t low_mask =
+            _mm_movemask_epi8(_mm_cmpeq_epi8(low, pattern));
+        std::uint32_t high_mask =
+            _mm_movemask_epi8(_mm_cmpeq_epi8(high, pattern));
+        return low_mask | (high_mask << 16);
+#else
+        std::uint32_t mask = 0;
+        for (int i = 0; i < NEIGHBORHOOD_SIZE; ++i) {
+            if (data[i] == fingerprint) {
+                mask |= std::uint32_t(1) << i;
+            }
+        }
+        return mask;
+#endif
+    }
+
+    template <typename Predicate>
+    KeyType64 find_key(HashType64 hash, const Predicate& is_equal_key) const
+    {
+        std::size_t ideal_bucket = get_ideal_bucket(hash);
+        std::uint32_t candidates =
+            match_fingerprints(ideal_bucket, get_fingerprint(hash));
+        while (candidates) {
+            std::size_t bucket = ideal_bucket + std::countr_zero(candidates);
+            if (buckets[bucket].hash == hash &&
+                is_equal_key(buckets[bucket].key)) {
+                return buckets[bucket].key;
+            }
+            candidates &= candidates - 1;
+        }
+        return -1;
+    }
+
+    void allocate(std::size_t new_num_buckets)
+    {
+        num_buckets = new_num_buckets;
+        std::size_t num_slots = num_buckets + NEIGHBORHOOD_SIZE - 1;
+        fingerprints.assign(num_slots, EMPTY_FINGERPRINT);
+        buckets.assign(num_slots, Bucket{0, -1});
+    }
+
+    void move_bucket(std::size_t from, std::size_t to)
+    {
+        fingerprints[to] = fingerprints[from];
+        buckets[to] = buckets[from];
+        fingerprints[from] = EMPTY_FINGERPRINT;
+    }
+
+    void enlarge()
+    {
+        std::vector<Bucket> old_buckets = std::move(buckets);
+        std::vector<std::uint8_t> old_fingerprints = std::move(fingerprints);
+        std::size_t num_entries_before = num_entries;
+        num_entries = 0;
+        allocate(num_buckets * 2);
+        for (std::size_t i = 0; i < old_buckets.size(); ++i) {
+            if (old_fingerprints[i] != EMPTY_FINGERPRINT) {
+                insert_new_key(old_buckets[i].key, old_buckets[i].hash);
+            }
+        }
+        (void)num_entries_before;
+        assert(num_entries == num_entries_before);
+        ++num_resizes;
+    }
+
+    /*
+      Try to move a free bucket into the neighbourhood of ideal_bucket.
+      Return the index of the free bucket or -1 if this is not possible.
+    */
+    std::ptrdiff_t find_free_bucket(std::size_t ideal_bucket)
+    {
+        std::size_t free_bucket = ideal_bucket;
+        while (free_bucket < fingerprints.size() &&
+               fingerprints[free_bucket] != EMPTY_FINGERPRINT) {
+            ++free_bucket;
+        }
+        if (free_bucket == fingerprints.size()) {
+            return -1;
+        }
+
+        /*
+          While the free bucket is too far from the ideal bucket, move it
+          towards the ideal bucket by swapping it with a full bucket that
+          stays in the neighbourhood of its own ideal bucket.
+        */
+        while (free_bucket - ideal_bucket >= NEIGHBORHOOD_SIZE) {
+            bool moved = false;
+            for (std::size_t candidate = free_bucket - NEIGHBORHOOD_SIZE + 1;
+                 candidate < free_bucket;
+                 ++candidate) {
+                if (fingerprints[candidate] == EMPTY_FINGERPRINT) {
+                    continue;
+                }
+                std::size_t candidate_ideal_bucket =
+                    get_ideal_bucket(buckets[candidate].hash);
+                if (free_bucket - candidate_ideal_bucket < NEIGHBORHOOD_SIZE) {
+                    move_bucket(candidate, free_bucket);
+                    free_bucket = candidate;
+                    moved = true;
+                    break;
+                }
+            }
+            if (!moved) {
+                return -1;
+            }
+        }
+        return free_bucket;
+    }
+
+    // Insert a key that is known not to be contained in the hash set.
+    void insert_new_key(KeyType64 key, HashType64 hash)
+    {
+        assert(hasher(key) == hash);
+        if (num_entries == num_buckets) {
+            enlarge();
+        }
+        std::ptrdiff_t free_bucket = find_free_bucket(get_ideal_bucket(hash));
+        while (free_bucket == -1) {
+            if (num_buckets > (std::numeric_limits<std::size_t>::max() >> 2)) {
+                std::cerr << "IntHashSet64 surpassed maximum capacity."
+                          << std::endl;
+                utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+            }
+            enlarge();
+            free_bucket = find_free_bucket(get_ideal_bucket(hash));
+        }
+        fingerprints[free_bucket] = get_fingerprint(hash);
+        buckets[free_bucket] = Bucket{hash, key};
+        ++num_entries;
+    }
+
+public:
+    IntHashSet64(const Hasher& hasher, const Equal& equal)
+        : hasher(hasher)
+        , equal(equal)
+        , num_entries(0)
+        , num_resizes(0)
+    {
+        allocate(1);
+    }
+
+    std::size_t size() const { return num_entries; }
+
+    /*
+      Insert a key into the hash set.
+
+      Return a pair whose first item is the given key, or an equivalent key
+      already contained in the hash set. The second item in the pair is a bool
+      indicating whether a new key was inserted into the hash set.
+    */
+    std::pair<KeyType64, bool> insert(KeyType64 key)
+    {
+        return insert_with_hash(key, hasher(key));
+    }
+
+    // See IntHashSet::insert_with_hash.
+    std::pair<KeyType64, bool> insert_with_hash(KeyType64 key, HashType64 hash)
+    {
+        assert(key >= 0);
+        KeyType64 equal_key =
+            find_key(hash, [&](KeyType64 other) { return equal(other, key); });
+        if (equal_key != -1) {
+            return std::make_pair(equal_key, false);
+        }
+        insert_new_key(key, hash);
+        return std::make_pair(key, true);
+    }
+
+    // See IntHashSet::find.
+    template <typename Predicate>
+    KeyType64 find(HashType64 hash, const Predicate& is_equal_key) const
+    {
+        return find_key(hash, is_equal_key);
+    }
+
+    void print_statistics(utils::LogProxy& log) const
+    {
+        log << "Int hash set load factor: " << num_entries << "/"
+            << num_buckets << " = "
+            << static_cast<double>(num_entries) / num_buckets << std::endl;
+        log << "Int hash set resizes: " << num_resizes << std::endl;
+    }
+};
+} // namespace int_hash_set
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "downward/algorithms/int_packer_types.h"
 
+#include <cassert>
+#include <cstdint>
 #include <vector>
 
 /*
@@ -15,20 +17,169 @@
   range 4, storing them would theoretically require at least 80 bits,
   and this class would pack them into 12 bytes (three 4-byte "bins").
 
-  Uses a greedy bin-packing strategy to pack the variables, which
-  should be close to optimal in most cases. (See code comments for
-  details.)
+  By default, uses a greedy bin-packing strategy to pack the variables,
+  which should be close to optimal in most cases. (See code comments for
+  details.) Alternatively, variables may straddle the boundary between
+  two bins. Then the packed size is minimal, i.e., the sum of the bit
+  sizes of all variables rounded up to full bins, but accessing a
+  variable in two bins is slightly slower.
+
+  If the set of values that can occur for a variable is known to be a
+  subset of its domain, the values can also be encoded by their index
+  in this set (a "dictionary"). A variable with a single possible value
+  then takes no memory at all.
 */
 namespace int_packer {
+/*
+  Position of a variable in the packed data. A variable that straddles two
+  bins keeps its high bits in high_bin_index = bin_index + 1. For all other
+  variables, high_bin_index = bin_index.
+*/
+struct VariableInfo {
+    int range;
+    int bin_index;
+    int high_bin_index;
+    int shift;
+    // Bits of the variable in bin bin_index.
+    PackedStateBin read_mask;
+    PackedStateBin value_mask;
+};
+
+/*
+  Access to the variables of one layout. IntPacker::visit_layout selects the
+  layout once, so that loops over many variables do not need to check the
+  layout for each of them.
+*/
+
+// Every variable fits into one bin.
+class BinLayout {
+    const VariableInfo *var_infos;
+public:
+    explicit BinLayout(const VariableInfo *var_infos)
+        : var_infos(var_infos) {
+    }
+
+    int get(const PackedStateBin *buffer, int var) const {
+        const VariableInfo &info = var_infos[var];
+        return (buffer[info.bin_index] & info.read_mask) >> info.shift;
+    }
+
+    void set(PackedStateBin *buffer, int var, int value) const {
+        const VariableInfo &info = var_infos[var];
+        assert(value >= 0 && value < info.range);
+        PackedStateBin &bin = buffer[info.bin_index];
+        bin = (bin & ~info.read_mask) | (value << info.shift);
+    }
+};
+
+/*
+  Variables may straddle two bins. We always combine the two bins of a
+  variable into one 64-bit word. If the variable does not straddle, both are
+  the same bin and the bits from the upper copy are masked out.
+*/
+class StraddlingLayout {
+    static const int BITS_PER_BIN = sizeof(PackedStateBin) * 8;
+
+    const VariableInfo *var_infos;
+public:
+    explicit StraddlingLayout(const VariableInfo *var_infos)
+        : var_infos(var_infos) {
+    }
+
+    int get(const PackedStateBin *buffer, int var) const {
+        const VariableInfo &info = var_infos[var];
+        std::uint64_t word =
+            buffer[info.bin_index] |
+            (static_cast<std::uint64_t>(buffer[info.high_bin_index])
+             << BITS_PER_BIN);
+        return (word >> info.shift) & info.value_mask;
+    }
+
+    void set(PackedStateBin *buffer, int var, int value) const {
+        const VariableInfo &info = var_infos[var];
+        assert(value >= 0 && value < info.range);
+        std::uint64_t word =
+            buffer[info.bin_index] |
+            (static_cast<std::uint64_t>(buffer[info.high_bin_index])
+             << BITS_PER_BIN);
+        std::uint64_t mask = std::uint64_t(info.value_mask) << info.shift;
+        word = (word & ~mask) |
+               (static_cast<std::uint64_t>(value) << info.shift);
+        // Write the high bin first: it is overwritten if it is the same bin.
+        buffer[info.high_bin_index] =
+            static_cast<PackedStateBin>(word >> BITS_PER_BIN);
+        buffer[info.bin_index] = static_cast<PackedStateBin>(word);
+    }
+};
+
+[[noreturn]] void exit_with_value_not_in_dictionary(int var, int value);
+
+// Variables store the index of their value in a dictionary.
+class DictionaryLayout {
+    StraddlingLayout codes;
+    const std::vector<int> *code_to_value;
+    const std::vector<int> *value_to_code;
+public:
+    DictionaryLayout(
+        const VariableInfo *var_infos,
+        const std::vector<int> *code_to_value,
+        const std::vector<int> *value_to_code)
+        : codes(var_infos),
+          code_to_value(code_to_value),
+          value_to_code(value_to_code) {
+    }
+
+    int get(const PackedStateBin *buffer, int var) const {
+        return code_to_value[var][codes.get(buffer, var)];
+    }
+
+    void set(PackedStateBin *buffer, int var, int value) const {
+        int code = value_to_code[var][value];
+        if (code == -1) {
+            exit_with_value_not_in_dictionary(var, value);
+        }
+        codes.set(buffer, var, code);
+    }
+};
+
 class IntPacker {
-    class VariableInfo;
+    enum class Layout {
+        BINS,
+        STRADDLING,
+        DICTIONARY
+    };
 
+    Layout layout;
     std::vector<VariableInfo> var_infos;
     int num_bins;
 
+    // Only used for dictionary encoding, empty otherwise.
+    std::vector<std::vector<int>> code_to_value;
+    std::vector<std::vector<int>> value_to_code;
+
+    /*
+      Layout of the variables by bin for the bulk operations on the BINS
+      layout. The fields of bin b are
+      bin_fields[bin_field_begin[b], bin_field_begin[b + 1]). Variables that
+      need no bits are listed separately. The other layouts store the
+      variables in order and need no table.
+    */
+    struct BinField {
+        int var;
+        int shift;
+        PackedStateBin mask;
+    };
+    std::vector<BinField> bin_fields;
+    std::vector<int> bin_field_begin;
+    std::vector<int> zero_bit_vars;
+
     int pack_one_bin(const std::vector<int> &ranges,
                      std::vector<std::vector<int>> &bits_to_vars);
     void pack_bins(const std::vector<int> &ranges);
+    void pack_straddling(const std::vector<int> &ranges);
+    void compute_bin_layout();
+    template<typename GetCode>
+    void pack_in_order(const GetCode &get_code, PackedStateBin *buffer) const;
 public:
     /*
       The constructor takes the range for each variable. The domain of
@@ -36,11 +187,71 @@ public:
       ints for the ranges (and genenerally for the values of variables),
       a variable can take up at most 31 bits if int is 32-bit.
     */
-    explicit IntPacker(const std::vector<int> &ranges);
+    explicit IntPacker(const std::vector<int> &ranges,
+                       bool allow_straddling = false);
+    /*
+      Dictionary encoding: only the values in possible_values[i] can be
+      stored for variable i, which must be a subset of {0, ..., ranges[i] - 1}
+      without duplicates. Variables may straddle bins. Setting a value that
+      is not in the dictionary terminates the planner.
+    */
+    IntPacker(const std::vector<int> &ranges,
+              const std::vector<std::vector<int>> &possible_values);
     ~IntPacker();
 
-    int get(const PackedStateBin *buffer, int var) const;
-    void set(PackedStateBin *buffer, int var, int value) const;
+    /*
+      Call visitor(layout) with the BinLayout, StraddlingLayout or
+      DictionaryLayout of this packer and return its result. Use this for
+      loops over many variables.
+    */
+    template<typename Visitor>
+    decltype(auto) visit_layout(Visitor &&visitor) const {
+        switch (layout) {
+        case Layout::BINS:
+            return visitor(BinLayout(var_infos.data()));
+        case Layout::STRADDLING:
+            return visitor(StraddlingLayout(var_infos.data()));
+        default:
+            return visitor(DictionaryLayout(
+                               var_infos.data(),
+                               code_to_value.data(),
+                               value_to_code.data()));
+        }
+    }
+
+    int get(const PackedStateBin *buffer, int var) const {
+        return visit_layout([&](const auto &vars) {
+                                return vars.get(buffer, var);
+                            });
+    }
+
+    void set(PackedStateBin *buffer, int var, int value) const {
+        visit_layout([&](const auto &vars) {
+                         vars.set(buffer, var, value);
+                     });
+    }
+
+    // Return false iff the value is not in the dictionary of the variable.
+    bool can_store(int var, int value) const;
+
+    /*
+      Get or set the values of all variables at once. This selects the
+      layout only once and is much faster than calling get or set for each
+      variable. For the BINS layout, each bin is read or written once. For
+      the other layouts, the variables are processed in order. pack_all
+      overwrites all bins of the buffer, including unused bits, which are
+      set to zero.
+    */
+    void unpack_all(const PackedStateBin *buffer, int *values) const;
+    void pack_all(const int *values, PackedStateBin *buffer) const;
+
+    /*
+      Return true iff the two buffers hold the same values. This compares the
+      packed data directly, so unused bits must be zero in both buffers, as is
+      the case for all buffers created with pack_all or with set on zeroed
+      bins.
+    */
+    bool equal(const PackedStateBin *lhs, const PackedStateBin *rhs) const;
 
     int get_num_bins() const { return num_bins; }
 };
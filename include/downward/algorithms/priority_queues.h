@@ -3,6 +3,9 @@
 
 #include "downward/utils/collections.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <iostream>
 #include <queue>
@@ -10,14 +13,17 @@
 #include <vector>
 
 /*
-  We define three priority queue classes here: HeapQueue (heap-based),
-  BucketQueue (bucket-based), and AdaptiveQueue (starts out bucket-based,
-  transforms into heap-based if that seems to make sense).
+  We define four priority queue classes here: HeapQueue (heap-based),
+  BucketQueue (bucket-based), RadixHeapQueue (radix heap for monotone
+  keys), and AdaptiveQueue (starts out bucket-based, transforms into a
+  radix heap or a heap if that seems to make sense).
 
   More precisely, an AdaptiveQueue is converted from a BucketQueue to
-  a HeapQueue when the number of required buckets exceeds both
+  a RadixHeapQueue when the number of required buckets exceeds both
   BucketQueue::MIN_BUCKETS_BEFORE_SWITCH and the total number of
   pushes to the queue since it was last clear()ed or constructed.
+  The RadixHeapQueue is converted to a HeapQueue if a key smaller than
+  the last popped key is pushed, i.e., if the keys are not monotone.
 
   Note: AdaptiveQueue does not derive from AbstractQueue since this is
   currently not necessary, and by not deriving we can save virtual
@@ -121,6 +127,148 @@ public:
     virtual void add_virtual_pushes(int /*num_extra_pushes*/) {}
 };
 
+template <typename Value>
+class RadixHeapQueue : public AbstractQueue<int, Value> {
+    /*
+      Radix heap (Ahuja et al., 1990) for monotone keys, i.e., keys that
+      are never smaller than the last popped key. Bucket 0 holds the
+      entries whose key equals the last popped key, bucket i > 0 those
+      whose key first differs from it in bit i - 1 (counting from the
+      least significant bit). Popping from an empty bucket 0 moves the
+      entries of the first non-empty bucket to lower buckets. Every entry
+      moves at most 32 times, and the buckets keep their memory, so there
+      is no allocation per entry.
+
+      Keys are mapped to unsigned integers in an order-preserving way, so
+      negative keys are supported as well.
+    */
+    static const int NUM_BUCKETS = 33;
+    static const unsigned int NO_KEY = 0xffffffffu;
+    static const bool DEBUG = false;
+
+    typedef typename AbstractQueue<int, Value>::Entry Entry;
+
+    typedef std::vector<Entry> Bucket;
+    std::array<Bucket, NUM_BUCKETS> buckets;
+    // Smallest (unsigned) key in each bucket or NO_KEY if it is empty.
+    std::array<unsigned int, NUM_BUCKETS> min_keys;
+    unsigned int last_key;
+    int num_entries;
+
+    static unsigned int to_unsigned(int key)
+    {
+        return static_cast<unsigned int>(key) ^ 0x80000000u;
+    }
+
+    int get_bucket_no(unsigned int key) const
+    {
+        assert(key >= last_key);
+        return std::bit_width(key ^ last_key);
+    }
+
+    void add_to_bucket(const Entry& entry)
+    {
+        unsigned int key = to_unsigned(entry.first);
+        int bucket_no = get_bucket_no(key);
+        buckets[bucket_no].push_back(entry);
+        min_keys[bucket_no] = std::min(min_keys[bucket_no], key);
+    }
+
+    void extract_entries(std::vector<Entry>& result)
+    {
+        // Move all entries to result in arbitrary order.
+        result.reserve(result.size() + num_entries);
+        for (Bucket& bucket : buckets) {
+            result.insert(result.end(), bucket.begin(), bucket.end());
+            utils::release_vector_memory(bucket);
+        }
+        min_keys.fill(NO_KEY);
+        num_entries = 0;
+        last_key = 0;
+    }
+
+public:
+    RadixHeapQueue()
+        : last_key(0)
+        , num_entries(0)
+    {
+        min_keys.fill(NO_KEY);
+    }
+
+    virtual ~RadixHeapQueue() {}
+
+    virtual void push(const int& key, const Value& value)
+    {
+        ++num_entries;
+        add_to_bucket(std::make_pair(key, value));
+    }
+
+    virtual Entry pop()
+    {
+        assert(num_entries > 0);
+        --num_entries;
+        if (buckets[0].empty()) {
+            int bucket_no = 1;
+            while (buckets[bucket_no].empty())
+                ++bucket_no;
+            Bucket& bucket = buckets[bucket_no];
+            last_key = min_keys[bucket_no];
+            for (const Entry& entry : bucket)
+                add_to_bucket(entry);
+            bucket.clear();
+            min_keys[bucket_no] = NO_KEY;
+        }
+        Entry result = buckets[0].back();
+        buckets[0].pop_back();
+        return result;
+    }
+
+    virtual bool empty() const { return num_entries == 0; }
+
+    virtual void clear()
+    {
+        for (Bucket& bucket : buckets)
+            bucket.clear();
+        min_keys.fill(NO_KEY);
+        num_entries = 0;
+        last_key = 0;
+    }
+
+    virtual AbstractQueue<int, Value>* convert_if_necessary(const int& key)
+    {
+        if (to_unsigned(key) < last_key) {
+            if (DEBUG) {
+                std::cout << "Switch from radix heap to heap-based queue "
+                          << "at key = " << key << std::endl;
+            }
+            std::vector<Entry> entries;
+            extract_entries(entries);
+            std::sort(
+                entries.begin(),
+                entries.end(),
+                [](const Entry& lhs, const Entry& rhs) {
+                    return lhs.first < rhs.first;
+                });
+            return HeapQueue<int, Value>::
+                create_from_sorted_entries_destructively(entries);
+        }
+        return this;
+    }
+
+    static RadixHeapQueue<Value>*
+    create_from_entries_destructively(std::vector<Entry>& entries)
+    {
+        // The passed-in vector is cleared as a side effect.
+        RadixHeapQueue<Value>* result = new RadixHeapQueue<Value>;
+        for (const Entry& entry : entries)
+            result->push(entry.first, entry.second);
+        utils::release_vector_memory(entries);
+        return result;
+    }
+
+    virtual void add_virtual_pushes(int /*num_extra_pushes*/) {}
+};
+
 template <typename Value>
 class BucketQueue : public AbstractQueue<int, Value> {
     static const int MIN_BUCKETS_BEFORE_SWITCH = 100;
@@ -219,8 +367,8 @@ public:
             }
             std::vector<Entry> entries;
             extract_sorted_entries(entries);
-            return HeapQueue<int, Value>::
-                create_from_sorted_entries_destructively(entries);
+            return RadixHeapQueue<Value>::create_from_entries_destructively(
+                entries);
         }
         return this;
     }
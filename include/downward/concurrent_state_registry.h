@@ -0,0 +1,101 @@
+#ifndef DOWNWARD_CONCURRENT_STATE_REGISTRY_H
+#define DOWNWARD_CONCURRENT_STATE_REGISTRY_H
+
+#include "downward/state_registry.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+  Thread-safe variant of StateRegistry for multi-threaded search algorithms.
+
+  Registered states are partitioned into shards by a hash of their packed
+  data. Each shard has its own lock and its own hash set for duplicate
+  detection, so threads registering states in different shards do not
+  contend.
+
+  The state data is stored in fixed-size blocks that are never moved or freed
+  while the registry exists. Each shard appends new states to its own current
+  block and claims a new block once it is full. Duplicates are detected
+  before the data is copied to the block. Blocks are numbered globally
+  and the ID of a state is its block number times the block size plus its
+  position in the block, so IDs are unique across all shards. Looking up a
+  state by its ID is wait-free: it only reads the block directory, which is
+  allocated once upfront.
+
+  Since each shard claims a whole block at a time, up to one block per shard
+  is only partially used and the IDs are not contiguous. get_state_id_bound()
+  is an upper bound for all IDs handed out so far, which is all that
+  PerStateInformation and PerStateArray need to store information for the
+  states of this registry.
+
+  An ID may only be looked up in a thread if its registration happened before
+  the lookup in the sense of the C++ memory model, e.g., because the ID was
+  passed on through a mutex or an atomic variable.
+*/
+class ConcurrentStateRegistry : public StateRegistryBase {
+    struct Shard;
+
+    std::vector<std::atomic<PackedStateBin*>> blocks;
+    std::mutex block_allocation_mutex;
+    int num_blocks;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::once_flag initial_state_flag;
+    std::unique_ptr<State> cached_initial_state;
+
+    const PackedStateBin* get_state_data(int id) const;
+    PackedStateBin* allocate_block(int& block_id);
+    StateID insert(const PackedStateBin* buffer);
+
+public:
+    ConcurrentStateRegistry(
+        const AbstractPlanningTask& task,
+        int num_shards,
+        StatePacking state_packing = StatePacking::BINS);
+    virtual ~ConcurrentStateRegistry() override;
+
+    /*
+      Returns the state that was registered at the given ID. The ID must refer
+      to a state in this registry. This method is wait-free.
+    */
+    State lookup_state(StateID id) const;
+
+    /*
+      Returns a reference to the initial state and registers it if this was not
+      done before.
+    */
+    const State& get_initial_state();
+
+    State insert_state(std::vector<int>&& state);
+
+    /*
+      Registers the state given by its packed data if this was not done
+      before and returns it. The data must have been packed with the state
+      packer of this registry's task.
+    */
+    State insert_packed_state(const PackedStateBin* buffer);
+
+    /*
+      Returns the state that results from applying op to predecessor and
+      registers it if this was not done before. Only the shard of the
+      successor is locked.
+    */
+    State
+    get_successor_state(const State& predecessor, const OperatorProxy& op);
+
+    /*
+      Returns the number of states registered so far. While other threads
+      register states, the result is only a snapshot.
+    */
+    size_t size() const;
+
+    int get_num_shards() const { return shards.size(); }
+
+    void print_statistics(utils::LogProxy& log) const;
+};
+
+#endif
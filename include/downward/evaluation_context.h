@@ -8,6 +8,7 @@
 #include "downward/state.h"
 
 #include <unordered_map>
+#include <vector>
 
 class Evaluator;
 class SearchStatistics;
@@ -110,6 +111,16 @@ public:
     bool is_evaluator_value_infinite(Evaluator* eval);
     int get_evaluator_value(Evaluator* eval);
     int get_evaluator_value_or_infinity(Evaluator* eval);
+
+    /*
+      Evaluate eval for all given contexts with a single call to
+      Evaluator::compute_results and store the results in the caches of the
+      contexts, so that later queries for eval are cache hits. Contexts
+      that already have a result for eval are left untouched.
+    */
+    static void compute_results(
+        Evaluator* eval,
+        std::vector<EvaluationContext>& eval_contexts);
 };
 
 #endif
@@ -0,0 +1,31 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "downward/open_list_factory.h"
+
+namespace bucket_open_list {
+/*
+  Open list for one or two evaluators with small non-negative integer
+  values, e.g. [f, h] in A*. It orders entries like the tie-breaking open
+  list (lexicographically by the evaluator values, FIFO among equal
+  values), but stores them in a dense two-level array of buckets instead
+  of a map.
+
+  Like the AdaptiveQueue in priority_queues.h, the open list switches to a
+  heap when the values become too sparse for an array.
+*/
+class BucketOpenListFactory : public OpenListFactory {
+    std::vector<std::shared_ptr<Evaluator>> evals;
+    bool unsafe_pruning;
+
+public:
+    BucketOpenListFactory(
+        const std::vector<std::shared_ptr<Evaluator>>& evals,
+        bool unsafe_pruning);
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+} // namespace bucket_open_list
+
+#endif
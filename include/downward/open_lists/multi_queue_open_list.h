@@ -0,0 +1,49 @@
+#ifndef OPEN_LISTS_MULTI_QUEUE_OPEN_LIST_H
+#define OPEN_LISTS_MULTI_QUEUE_OPEN_LIST_H
+
+#include "downward/open_list_factory.h"
+
+/*
+  Open list with one queue per evaluator that alternates between the
+  queues like alt([epsilon_greedy(e_1), ..., epsilon_greedy(e_n)]), but
+  returns every entry from only one queue.
+
+  The queues are heaps of (key, insertion ID, entry) nodes, ordered by
+  evaluator value and FIFO among equal values. In addition, the open list
+  stores one bit per state that tells whether the state is in it. When a
+  queue removes a state, the bit is cleared, so all other nodes of the state
+  become stale. Stale nodes are dropped lazily: when they are chosen by a
+  queue, or all at once when a heap holds more than two nodes per entry
+  and has doubled since it was last compacted. If a state is inserted
+  again after its removal, its old nodes are live again until one of them
+  is removed.
+
+  With n queues, an entry takes n heap nodes of 12 bytes, like in the
+  alternation open list, plus one bit per registered state. Edge entries
+  are never merged and take 16 bytes per node plus one bit per insertion.
+
+  Compared to the alternation open list, an entry removed from one queue
+  is never returned by another queue. With epsilon = 0 the queues behave
+  like single(e_i); with a single evaluator the open list behaves like
+  epsilon_greedy(e_1) except that states inserted again while they are
+  open are returned only once.
+*/
+
+namespace multi_queue_open_list {
+class MultiQueueOpenListFactory : public OpenListFactory {
+    std::vector<std::shared_ptr<Evaluator>> evals;
+    double epsilon;
+    int random_seed;
+
+public:
+    MultiQueueOpenListFactory(
+        const std::vector<std::shared_ptr<Evaluator>>& evals,
+        double epsilon,
+        int random_seed);
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+} // namespace multi_queue_open_list
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef OPEN_LISTS_OPEN_LIST_BUCKETS_H
+#define OPEN_LISTS_OPEN_LIST_BUCKETS_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/*
+  Building blocks for open lists that group their entries into buckets by
+  a key of evaluator values.
+
+  Keys of open lists with up to MAX_FIXED_ARITY evaluators are stored
+  inline as std::array<int, N>. Longer keys fall back to std::vector<int>.
+  Open lists are templated on the key type and the factories select the
+  instantiation with select_key_arity.
+*/
+namespace open_list_buckets {
+const int MAX_FIXED_ARITY = 3;
+
+template <std::size_t N>
+inline void resize_key(std::array<int, N>&, int arity)
+{
+    assert(arity == static_cast<int>(N));
+    (void)arity;
+}
+
+inline void resize_key(std::vector<int>& key, int arity)
+{
+    key.resize(arity);
+}
+
+/*
+  FIFO queue of entries. Removed entries are only released once the bucket
+  runs empty (or once they make up half of a large bucket), so a bucket
+  that is filled and emptied repeatedly does not allocate.
+*/
+template <typename Entry>
+class FifoBucket {
+    static const std::size_t MIN_ENTRIES_BEFORE_COMPACTION = 1024;
+
+    std::vector<Entry> entries;
+    std::size_t head = 0;
+
+public:
+    bool empty() const { return head == entries.size(); }
+
+    std::size_t size() const { return entries.size() - head; }
+
+    void push(const Entry& entry) { entries.push_back(entry); }
+
+    const Entry& front() const
+    {
+        assert(!empty());
+        return entries[head];
+    }
+
+    Entry pop()
+    {
+        assert(!empty());
+        Entry result = entries[head++];
+        if (empty()) {
+            clear();
+        } else if (
+            head >= MIN_ENTRIES_BEFORE_COMPACTION &&
+            2 * head >= entries.size()) {
+            entries.erase(entries.begin(), entries.begin() + head);
+            head = 0;
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        entries.clear();
+        head = 0;
+    }
+
+    // Unlike clear(), also release the memory of the entries.
+    void release_memory()
+    {
+        std::vector<Entry>().swap(entries);
+        head = 0;
+    }
+
+    // Iterate over the entries that have not been removed yet.
+    typename std::vector<Entry>::const_iterator begin() const
+    {
+        return entries.begin() + head;
+    }
+
+    typename std::vector<Entry>::const_iterator end() const
+    {
+        return entries.end();
+    }
+};
+
+/*
+  Pool of buckets addressed by integer IDs. Buckets that run empty are
+  released and reused for the next key, together with their memory.
+*/
+template <typename Entry>
+class BucketPool {
+    std::vector<FifoBucket<Entry>> buckets;
+    std::vector<int> free_ids;
+
+public:
+    int allocate()
+    {
+        if (free_ids.empty()) {
+            buckets.emplace_back();
+            return buckets.size() - 1;
+        }
+        int id = free_ids.back();
+        free_ids.pop_back();
+        assert(buckets[id].empty());
+        return id;
+    }
+
+    void release(int id)
+    {
+        assert(buckets[id].empty());
+        free_ids.push_back(id);
+    }
+
+    FifoBucket<Entry>& operator[](int id) { return buckets[id]; }
+
+    const FifoBucket<Entry>& operator[](int id) const { return buckets[id]; }
+
+    void clear()
+    {
+        buckets.clear();
+        free_ids.clear();
+    }
+};
+
+/*
+  Call create<Key>() with the key type for the given number of evaluators
+  and return its result.
+*/
+template <typename Result, typename Create>
+Result select_key_arity(int arity, const Create& create)
+{
+    static_assert(MAX_FIXED_ARITY == 3, "Update the cases below.");
+    switch (arity) {
+    case 1:
+        return create.template operator()<std::array<int, 1>>();
+    case 2:
+        return create.template operator()<std::array<int, 2>>();
+    case 3:
+        return create.template operator()<std::array<int, 3>>();
+    default:
+        return create.template operator()<std::vector<int>>();
+    }
+}
+} // namespace open_list_buckets
+
+#endif
@@ -9,7 +9,9 @@
 
   The original implementation uses a std::map for storing and looking
   up buckets. Our implementation stores the buckets in a std::vector
-  and uses a std::unordered_map for looking up indexes in the vector.
+  and uses an open-addressing hash index for looking up indexes in the
+  vector. Keys of up to three evaluator values are stored inline, and
+  the entries of all buckets share a single arena.
 
   In the table below we list the amortized worst-case time complexities
   for the original implementation and the version below.
@@ -74,18 +74,18 @@ public:
 */
 
 template <class Element>
-class PerStateArray : public subscriber::Subscriber<StateRegistry> {
+class PerStateArray : public subscriber::Subscriber<StateRegistryBase> {
     const std::vector<Element> default_array;
     using EntryArrayVectorMap = std::unordered_map<
-        const StateRegistry*,
+        const StateRegistryBase*,
         segmented_vector::SegmentedArrayVector<Element>*>;
     EntryArrayVectorMap entry_arrays_by_registry;
 
-    mutable const StateRegistry* cached_registry;
+    mutable const StateRegistryBase* cached_registry;
     mutable segmented_vector::SegmentedArrayVector<Element>* cached_entries;
 
     segmented_vector::SegmentedArrayVector<Element>*
-    get_entries(const StateRegistry* registry)
+    get_entries(const StateRegistryBase* registry)
     {
         if (cached_registry != registry) {
             cached_registry = registry;
@@ -107,7 +107,7 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     }
 
     const segmented_vector::SegmentedArrayVector<Element>*
-    get_entries(const StateRegistry* registry) const
+    get_entries(const StateRegistryBase* registry) const
     {
         if (cached_registry != registry) {
             const auto it = entry_arrays_by_registry.find(registry);
@@ -144,7 +144,7 @@ public:
 
     ArrayView<Element> operator[](const State& state)
     {
-        const StateRegistry* registry = state.get_registry();
+        const StateRegistryBase* registry = state.get_registry();
         if (!registry) {
             std::cerr << "Tried to access per-state array with an unregistered "
                       << "state." << std::endl;
@@ -154,8 +154,8 @@ public:
             get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
-        size_t virtual_size = registry->size();
-        assert(utils::in_bounds(state_id, *registry));
+        size_t virtual_size = registry->get_state_id_bound();
+        assert(static_cast<size_t>(state_id) < registry->get_state_id_bound());
         if (entries->size() < virtual_size) {
             entries->resize(virtual_size, default_array.data());
         }
@@ -164,7 +164,7 @@ public:
 
     ConstArrayView<Element> operator[](const State& state) const
     {
-        const StateRegistry* registry = state.get_registry();
+        const StateRegistryBase* registry = state.get_registry();
         if (!registry) {
             std::cerr << "Tried to access per-state array with an unregistered "
                       << "state." << std::endl;
@@ -178,7 +178,7 @@ public:
         }
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
-        assert(utils::in_bounds(state_id, *registry));
+        assert(static_cast<size_t>(state_id) < registry->get_state_id_bound());
         int num_entries = entries->size();
         if (state_id >= num_entries) {
             ABORT("PerStateArray::operator[] const tried to access "
@@ -190,7 +190,7 @@ public:
     }
 
     virtual void
-    notify_service_destroyed(const StateRegistry* registry) override
+    notify_service_destroyed(const StateRegistryBase* registry) override
     {
         delete entry_arrays_by_registry[registry];
         entry_arrays_by_registry.erase(registry);
@@ -35,16 +35,20 @@
   stores information. Once a StateRegistry is destroyed, it notifies all
   subscribed objects, which in turn destroy all information stored for states
   in that registry.
+
+  PerStateInformation is not thread-safe, also not for states of a
+  ConcurrentStateRegistry. Threads sharing such a registry have to synchronize
+  their accesses or use one PerStateInformation object each.
 */
 template <class Entry>
-class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
+class PerStateInformation : public subscriber::Subscriber<StateRegistryBase> {
     const Entry default_value;
     using EntryVectorMap = std::unordered_map<
-        const StateRegistry*,
+        const StateRegistryBase*,
         segmented_vector::SegmentedVector<Entry>*>;
     EntryVectorMap entries_by_registry;
 
-    mutable const StateRegistry* cached_registry;
+    mutable const StateRegistryBase* cached_registry;
     mutable segmented_vector::SegmentedVector<Entry>* cached_entries;
 
     /*
@@ -54,7 +58,7 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       consecutive calls with the same registry.
     */
     segmented_vector::SegmentedVector<Entry>*
-    get_entries(const StateRegistry* registry)
+    get_entries(const StateRegistryBase* registry)
     {
         if (cached_registry != registry) {
             cached_registry = registry;
@@ -80,7 +84,7 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       up consecutive calls with the same registry.
     */
     const segmented_vector::SegmentedVector<Entry>*
-    get_entries(const StateRegistry* registry) const
+    get_entries(const StateRegistryBase* registry) const
     {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
@@ -124,7 +128,7 @@ public:
 
     Entry& operator[](const State& state)
     {
-        const StateRegistry* registry = state.get_registry();
+        const StateRegistryBase* registry = state.get_registry();
         if (!registry) {
             std::cerr << "Tried to access per-state information with an "
                       << "unregistered state." << std::endl;
@@ -134,8 +138,8 @@ public:
             get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
-        size_t virtual_size = registry->size();
-        assert(utils::in_bounds(state_id, *registry));
+        size_t virtual_size = registry->get_state_id_bound();
+        assert(static_cast<size_t>(state_id) < registry->get_state_id_bound());
         if (entries->size() < virtual_size) {
             entries->resize(virtual_size, default_value);
         }
@@ -144,7 +148,7 @@ public:
 
     const Entry& operator[](const State& state) const
     {
-        const StateRegistry* registry = state.get_registry();
+        const StateRegistryBase* registry = state.get_registry();
         if (!registry) {
             std::cerr << "Tried to access per-state information with an "
                       << "unregistered state." << std::endl;
@@ -157,7 +161,7 @@ public:
         }
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
-        assert(utils::in_bounds(state_id, *registry));
+        assert(static_cast<size_t>(state_id) < registry->get_state_id_bound());
         int num_entries = entries->size();
         if (state_id >= num_entries) {
             return default_value;
@@ -166,7 +170,7 @@ public:
     }
 
     virtual void
-    notify_service_destroyed(const StateRegistry* registry) override
+    notify_service_destroyed(const StateRegistryBase* registry) override
     {
         delete entries_by_registry[registry];
         entries_by_registry.erase(registry);
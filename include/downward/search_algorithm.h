@@ -10,6 +10,7 @@
 #include "downward/state_registry.h"
 #include "downward/task_proxy.h"
 
+#include "downward/task_utils/successor_generator.h"
 #include "downward/utils/countdown_timer.h"
 #include "downward/utils/logging.h"
 
@@ -26,10 +27,6 @@ template <typename T>
 class OrderedSet;
 }
 
-namespace successor_generator {
-class SuccessorGenerator;
-}
-
 enum SearchStatus { IN_PROGRESS, TIMEOUT, FAILED, SOLVED };
 
 class SearchAlgorithm {
@@ -64,6 +61,9 @@ protected:
 
     void set_plan(const Plan& plan);
     bool check_goal_and_set_plan(const State& state);
+    // Compute the path to a goal state found in the search space.
+    virtual void
+    trace_path(const State& goal_state, std::vector<OperatorID>& path);
     int get_adjusted_cost(const OperatorProxy& op) const;
 
 public:
@@ -72,6 +72,10 @@ public:
         OperatorCost cost_type,
         int bound,
         double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
         const std::string& description,
         utils::Verbosity verbosity);
 
@@ -127,11 +131,15 @@ extern std::tuple<
     OperatorCost,
     int,
     double,
+    StateHashing,
+    std::shared_ptr<StateStorage>,
+    StatePacking,
+    SuccessorGeneratorType,
     std::string,
     utils::Verbosity>
 get_search_algorithm_arguments_from_options(const plugins::Options& opts);
 extern void add_successors_order_options_to_feature(plugins::Feature& feature);
-extern std::tuple<bool, bool, int>
+extern std::tuple<bool, int>
 get_successors_order_arguments_from_options(const plugins::Options& opts);
 
 #endif
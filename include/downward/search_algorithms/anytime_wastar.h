@@ -0,0 +1,76 @@
+#ifndef SEARCH_ALGORITHMS_ANYTIME_WASTAR_H
+#define SEARCH_ALGORITHMS_ANYTIME_WASTAR_H
+
+#include "downward/open_list.h"
+#include "downward/per_state_information.h"
+#include "downward/search_algorithm.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace anytime_wastar {
+/*
+  Restarting weighted A* search that runs in a single process. It runs one
+  weighted A* search per weight in the given sequence. Each plan is saved
+  right away (as FILENAME.1, FILENAME.2, ...) and its cost becomes the bound
+  for the following iterations, so every plan is cheaper than the previous
+  one. The search stops when an iteration fails to find a cheaper plan.
+
+  All iterations share the state registry. If reuse_search_space is true,
+  they also share the search space: states keep the cheapest g value and
+  parent found by any iteration, and states seen in earlier iterations are
+  queued with these values when they are reached again (Richter, Thayer and
+  Ruml, 2010). Otherwise, every iteration starts with an empty search space.
+*/
+class AnytimeWAstarSearch : public SearchAlgorithm {
+    const std::shared_ptr<Evaluator> evaluator;
+    const std::vector<int> weights;
+    const bool repeat_last_weight;
+    const bool reuse_search_space;
+    const utils::Verbosity verbosity;
+
+    std::vector<Evaluator*> path_dependent_evaluators;
+
+    int iteration;
+    std::unique_ptr<StateOpenList> open_list;
+    std::unique_ptr<SearchSpace> current_search_space;
+    // Last iteration in which the state was inserted into the open list.
+    PerStateInformation<int> queued_in_iteration;
+
+    int get_weight() const;
+    void start_iteration();
+    void insert(SearchNode& node);
+    SearchStatus finish_iteration(bool found_plan);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+    virtual void
+    trace_path(const State& goal_state, std::vector<OperatorID>& path) override;
+
+public:
+    AnytimeWAstarSearch(
+        const std::shared_ptr<Evaluator>& evaluator,
+        const std::vector<int>& weights,
+        bool repeat_last_weight,
+        bool reuse_search_space,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+    // Plans are saved as soon as they are found.
+    virtual void save_plan_if_necessary() override;
+};
+} // namespace anytime_wastar
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef SEARCH_ALGORITHMS_BEAM_SEARCH_H
+#define SEARCH_ALGORITHMS_BEAM_SEARCH_H
+
+#include "downward/search_algorithm.h"
+
+#include "downward/utils/hash.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace beam_search {
+/*
+  Breadth-first search that only keeps the width best states of every
+  layer, ranked by the evaluator (ties are broken in favor of lower g
+  values). It is neither complete nor optimal, but its memory is bounded by
+  O(width * depth) and its time per layer by O(width * branching factor).
+
+  The states are not registered in the state registry. We only keep the
+  states of the current layer and, for every layer, a compact array with
+  the parent index and creating operator of each state, from which the
+  plan is extracted. The successors of a layer are evaluated in a single
+  batch.
+
+  If filter_duplicates is true, successors that equal a state of the
+  current or the previous layer or another successor in the same layer
+  are discarded. This removes the most common transpositions, like
+  applying an operator and its inverse, without storing earlier layers.
+*/
+class BeamSearch : public SearchAlgorithm {
+    struct ParentEntry {
+        // Index of the parent in the previous layer.
+        int parent;
+        OperatorID creating_op;
+    };
+
+    struct LayerState {
+        State state;
+        int g;
+        int real_g;
+    };
+
+    const std::shared_ptr<Evaluator> evaluator;
+    const int width;
+    const bool filter_duplicates;
+
+    std::vector<LayerState> previous_layer;
+    std::vector<LayerState> current_layer;
+    // parents[d][i] belongs to state i of layer d + 1.
+    std::vector<std::vector<ParentEntry>> parents;
+    // Values of the states that successors are compared to for duplicates.
+    utils::HashSet<std::vector<int>> recent_states;
+
+    // Extract the plan to state index of the current layer plus last_op.
+    void set_plan_to(int index, OperatorID last_op);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    BeamSearch(
+        const std::shared_ptr<Evaluator>& evaluator,
+        int width,
+        bool filter_duplicates,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+} // namespace beam_search
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef SEARCH_ALGORITHMS_BIDIRECTIONAL_ASTAR_H
+#define SEARCH_ALGORITHMS_BIDIRECTIONAL_ASTAR_H
+
+#include "downward/per_state_information.h"
+#include "downward/search_algorithm.h"
+
+#include "downward/algorithms/int_hash_set.h"
+#include "downward/task_utils/regression_successor_generator.h"
+#include "downward/utils/hash.h"
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <set>
+#include <tuple>
+#include <vector>
+
+class Evaluator;
+
+namespace bidirectional_astar {
+/*
+  Open nodes of one search direction. Nodes are ordered by the MM priority
+  max(f, 2g). The multisets of the f and g values of the open nodes are
+  needed for the termination criterion.
+
+  Nodes whose g value decreases are added again. The caller has to call
+  remove for the old values and skip the outdated entries with pop_stale.
+*/
+class Frontier {
+    // (priority, g, f, node)
+    using Entry = std::tuple<int, int, int, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    std::multiset<int> f_values;
+    std::multiset<int> g_values;
+
+public:
+    void add(int node, int g, int f);
+    void remove(int g, int f);
+    // Remove the top entries for which is_stale(node, g) holds.
+    void pop_stale(const std::function<bool(int, int)>& is_stale);
+    // Remove the top entry and its values and return its node.
+    int pop();
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return g_values.size(); }
+    int get_min_priority() const { return std::get<0>(heap.top()); }
+    int get_min_f() const { return *f_values.begin(); }
+    int get_min_g() const { return *g_values.begin(); }
+};
+
+/*
+  Bidirectional heuristic search with the MM algorithm (Holte et al.,
+  2016). The forward search expands states with the given evaluator. The
+  backward search regresses partial states from the goal. It has no
+  heuristic for the distance from the initial state, so its priority is
+  2g. We expand the direction with the smaller priority and break ties in
+  favor of the direction with fewer open nodes.
+
+  A solution is found whenever a forward state satisfies a backward partial
+  state. The search stops when the cost of the best solution is at most
+  the lower bound max(C, fmin_F, fmin_B, gmin_F + gmin_B + epsilon) on the
+  cost of solutions that have not been found yet.
+*/
+class BidirectionalAStarSearch : public SearchAlgorithm {
+    struct BackwardNode {
+        int g;
+        int real_g;
+        // Node that this partial state was regressed from.
+        int parent;
+        OperatorID creating_op;
+        int pattern;
+        bool closed;
+    };
+
+    /*
+      The meeting points of the two directions are found by grouping the
+      backward partial states by the variables they assign (their pattern).
+      A state satisfies a partial state iff its projection to the pattern
+      equals the values of the partial state. Both are hashed by these
+      values, so a meeting check costs one lookup per pattern.
+    */
+    struct BackwardNodeHash {
+        const BidirectionalAStarSearch& search;
+        int_hash_set::HashType operator()(int node) const;
+    };
+
+    struct BackwardNodeEqual {
+        const BidirectionalAStarSearch& search;
+        bool operator()(int lhs, int rhs) const;
+    };
+
+    // Forward states are given by their index in forward_states.
+    struct ProjectionHash {
+        const BidirectionalAStarSearch& search;
+        int pattern;
+        int_hash_set::HashType operator()(int forward_state) const;
+    };
+
+    struct ProjectionHashEqual {
+        ProjectionHash hash;
+        bool operator()(int lhs, int rhs) const;
+    };
+
+    struct Pattern {
+        std::vector<int> variables;
+        /*
+          One forward state for each hash of the projection to the
+          variables. The other forward states with the same hash follow it
+          in a linked list. Comparing the projections is only worth it for
+          the states in the lists that are read, so it is done there. The
+          forward states are only added when the next partial state with
+          this pattern is inserted, so patterns that the backward search no
+          longer reaches cost nothing.
+        */
+        int_hash_set::IntHashSet<ProjectionHash, ProjectionHashEqual>
+            forward_states;
+        std::vector<int> next_forward_state;
+    };
+
+    const std::shared_ptr<Evaluator> evaluator;
+    const regression_successor_generator::RegressionSuccessorGenerator
+        regression_generator;
+    const int num_variables;
+    // Smallest adjusted operator cost.
+    int epsilon;
+
+    std::vector<Evaluator*> path_dependent_evaluators;
+
+    Frontier forward_frontier;
+    PerStateInformation<int> forward_h;
+    // Forward states in the order in which they were generated.
+    std::vector<StateID> forward_states;
+
+    Frontier backward_frontier;
+    std::vector<BackwardNode> backward_nodes;
+    // The partial states of the backward nodes, one after the other.
+    std::vector<int> backward_partial_states;
+    int_hash_set::IntHashSet<BackwardNodeHash, BackwardNodeEqual>
+        backward_node_ids;
+
+    std::vector<Pattern> patterns;
+    utils::HashMap<std::vector<int>, int> pattern_ids;
+
+    // Cost of the best solution and the states in which its halves meet.
+    int best_solution_cost;
+    StateID best_forward_state;
+    int best_backward_node;
+
+    int num_forward_expansions;
+    int num_backward_expansions;
+
+    const int* get_values(int node) const;
+    std::vector<int> get_partial_state(int node) const;
+    // Return the pattern of the partial state and add it if it is new.
+    int get_pattern_id(const std::vector<int>& partial_state);
+    void add_new_forward_states(Pattern& pattern);
+    void update_best_solution(
+        StateID forward_state,
+        int forward_g,
+        int forward_real_g,
+        int backward_node);
+
+    void insert_forward(const State& state, const SearchNode& node);
+    void insert_backward(
+        std::vector<int>&& partial_state,
+        int g,
+        int real_g,
+        int parent,
+        OperatorID creating_op);
+    void expand_forward();
+    void expand_backward();
+    int compute_lower_bound() const;
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    BidirectionalAStarSearch(
+        const std::shared_ptr<Evaluator>& evaluator,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+} // namespace bidirectional_astar
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef SEARCH_ALGORITHMS_EAGER_SEARCH_H
 #define SEARCH_ALGORITHMS_EAGER_SEARCH_H
 
+#include "downward/evaluation_context.h"
 #include "downward/open_list.h"
 #include "downward/search_algorithm.h"
 
@@ -17,6 +18,10 @@ class Feature;
 class Options;
 } // namespace plugins
 
+namespace successor_generator {
+class IncrementalSuccessorGenerator;
+}
+
 namespace eager_search {
 class EagerSearch : public SearchAlgorithm {
     const bool reopen_closed_nodes;
@@ -28,6 +33,51 @@ class EagerSearch : public SearchAlgorithm {
     std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
     std::shared_ptr<CachedHeuristic> lazy_evaluator;
 
+    /*
+      Search spaces that omit real g values (if they always equal the g
+      values) and/or parent pointers (if plans are reconstructed by
+      regression). At most one of them is set. Otherwise, we use
+      SearchAlgorithm::search_space, which stores all fields.
+    */
+    std::unique_ptr<BasicSearchSpace<BasicSearchNodeInfo<false, true>>>
+        search_space_without_real_g;
+    std::unique_ptr<BasicSearchSpace<BasicSearchNodeInfo<true, false>>>
+        search_space_without_parents;
+    std::unique_ptr<BasicSearchSpace<BasicSearchNodeInfo<false, false>>>
+        search_space_without_real_g_and_parents;
+
+    // Only set if applicable operators are generated incrementally.
+    std::unique_ptr<successor_generator::IncrementalSuccessorGenerator>
+        incremental_successor_generator;
+
+    /*
+      If batch_evaluator is set, new and reopened successors are not
+      evaluated when they are generated. They are collected over
+      batch_expansions expansions and then evaluated with one call to
+      compute_results of batch_evaluator before they are inserted into the
+      open list in generation order.
+    */
+    std::shared_ptr<Evaluator> batch_evaluator;
+    const int batch_expansions;
+    std::vector<EvaluationContext> pending_eval_contexts;
+    int num_expansions_in_batch;
+
+    // Call function with the search space that is used.
+    template <typename Function>
+    decltype(auto) visit_search_space(const Function& function);
+
+    template <typename SearchSpaceType>
+    SearchStatus step(SearchSpaceType& space);
+
+    template <typename SearchSpaceType>
+    void generate_applicable_ops(
+        SearchSpaceType& space,
+        const State& state,
+        std::vector<OperatorID>& applicable_ops);
+
+    template <typename SearchSpaceType>
+    void evaluate_pending_successors(SearchSpaceType& space);
+
     void start_f_value_statistics(EvaluationContext& eval_context);
     void update_f_value_statistics(EvaluationContext& eval_context);
     void reward_progress();
@@ -35,6 +85,8 @@ class EagerSearch : public SearchAlgorithm {
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual void
+    trace_path(const State& goal_state, std::vector<OperatorID>& path) override;
 
 public:
     explicit EagerSearch(
@@ -43,16 +95,26 @@ public:
         const std::shared_ptr<Evaluator>& f_eval,
         const std::vector<std::shared_ptr<Evaluator>>& preferred,
         const std::shared_ptr<CachedHeuristic>& lazy_evaluator,
+        bool store_parent_pointers,
+        int incremental_successors,
+        const std::shared_ptr<Evaluator>& batch_evaluator,
+        int batch_expansions,
         std::shared_ptr<ClassicalPlanningTask> task,
         OperatorCost cost_type,
         int bound,
         double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
         const std::string& description,
         utils::Verbosity verbosity);
 
+    virtual ~EagerSearch() override;
+
     virtual void print_statistics() const override;
 
-    void dump_search_space() const;
+    void dump_search_space();
 };
 
 extern void add_eager_search_options_to_feature(
@@ -60,10 +122,18 @@ extern void add_eager_search_options_to_feature(
     const std::string& description);
 extern std::tuple<
     std::shared_ptr<CachedHeuristic>,
+    bool,
+    int,
+    std::shared_ptr<Evaluator>,
+    int,
     std::shared_ptr<ClassicalPlanningTask>,
     OperatorCost,
     int,
     double,
+    StateHashing,
+    std::shared_ptr<StateStorage>,
+    StatePacking,
+    SuccessorGeneratorType,
     std::string,
     utils::Verbosity>
 get_eager_search_arguments_from_options(const plugins::Options& opts);
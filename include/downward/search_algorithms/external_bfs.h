@@ -0,0 +1,87 @@
+#ifndef SEARCH_ALGORITHMS_EXTERNAL_BFS_H
+#define SEARCH_ALGORITHMS_EXTERNAL_BFS_H
+
+#include "downward/search_algorithm.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace external_bfs {
+/*
+  Breadth-first search with delayed duplicate detection (Korf, 2004) for
+  state spaces that do not fit into memory. Each layer is stored in a file
+  of packed states sorted by their bins. Every record consists of the bins
+  of a state followed by its g value (real costs).
+
+  A layer is expanded by streaming its file. The successors are collected
+  in a buffer of buffer_size states, which is sorted and written to a run
+  file whenever it is full. The runs are merged with k-way merges that
+  keep the cheapest record of each state. At most merge_fan_in files are
+  merged at once, so with more runs than that, the runs are merged in
+  several passes. Then the states of the previous layers are subtracted
+  with one streaming merge per layer. Only the sort buffer and one read
+  buffer of io_buffer_size records per open file are kept in memory.
+
+  All layer files are kept until the search ends, when the scratch
+  directory is removed. The plan is
+  reconstructed backwards from the goal state by searching each layer for
+  a predecessor with a matching g value.
+*/
+class ExternalBFSSearch : public SearchAlgorithm {
+    const std::filesystem::path scratch_dir;
+    const int buffer_size;
+    const int io_buffer_size;
+    const int merge_fan_in;
+    const int locality;
+    const int num_bins;
+    // Number of PackedStateBins per record: the bins plus the g value.
+    const int record_size;
+
+    // Number of states in each layer.
+    std::vector<long long> layer_sizes;
+
+    void remove_scratch_dir();
+    std::filesystem::path get_layer_path(int layer) const;
+    std::filesystem::path get_run_path(int run) const;
+    void write_run(
+        std::vector<PackedStateBin>& buffer,
+        const std::filesystem::path& path);
+    long long merge_files(
+        const std::vector<std::filesystem::path>& inputs,
+        const std::filesystem::path& path);
+    long long merge_runs(int num_runs, const std::filesystem::path& path);
+    long long subtract_layer(
+        const std::filesystem::path& candidates_path,
+        int layer,
+        const std::filesystem::path& path);
+    void extract_plan(int layer, std::vector<PackedStateBin> goal_record);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    ExternalBFSSearch(
+        const std::string& scratch_dir,
+        int buffer_size,
+        int io_buffer_size,
+        int merge_fan_in,
+        int locality,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+    virtual ~ExternalBFSSearch() override;
+
+    virtual void print_statistics() const override;
+};
+} // namespace external_bfs
+
+#endif
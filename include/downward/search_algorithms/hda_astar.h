@@ -0,0 +1,70 @@
+#ifndef SEARCH_ALGORITHMS_HDA_ASTAR_H
+#define SEARCH_ALGORITHMS_HDA_ASTAR_H
+
+#include "downward/search_algorithm.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace plugins {
+class Feature;
+class Options;
+} // namespace plugins
+
+namespace hda_astar {
+class HDAStarWorker;
+struct SharedSearchData;
+
+/*
+  Hash-distributed A* (Kishimoto, Fukunaga and Botea, 2009).
+
+  Every state is owned by exactly one worker thread, determined by a hash of
+  its packed data. Each worker has its own state registry, search space and
+  open list and only expands the states it owns. Successors owned by another
+  worker are packed into messages and sent to the owner through a lock-free
+  mailbox.
+
+  Since the workers expand nodes in parallel, the first goal found is not
+  necessarily optimal. We keep the cheapest goal found so far as an incumbent,
+  prune all nodes whose f-value is not smaller than its cost and terminate
+  once no worker has open nodes and no messages are in flight.
+
+  Each worker needs its own evaluator because evaluators are not thread-safe.
+  The constructor therefore takes one evaluator per worker; the number of
+  evaluators determines the number of threads. Path-dependent evaluators are
+  not supported.
+*/
+class HDAStarSearch : public SearchAlgorithm {
+    std::vector<std::shared_ptr<Evaluator>> worker_evaluators;
+    std::vector<std::unique_ptr<HDAStarWorker>> workers;
+    std::unique_ptr<SharedSearchData> shared_data;
+
+    void collect_statistics();
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit HDAStarSearch(
+        const std::vector<std::shared_ptr<Evaluator>>& worker_evaluators,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+} // namespace hda_astar
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SEARCH_ALGORITHMS_IDASTAR_H
+#define SEARCH_ALGORITHMS_IDASTAR_H
+
+#include "downward/search_algorithm.h"
+#include "downward/search_algorithms/transposition_table.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace idastar {
+/*
+  Iterative deepening A* (Korf, 1985). Each iteration is a depth-first
+  search that prunes states whose f value exceeds the threshold of the
+  iteration. The next threshold is the smallest pruned f value.
+
+  The search does not register states in the state registry. It only keeps
+  the current path, so it needs memory linear in the plan length, plus the
+  memory for the optional transposition table. The transposition table
+  stores the smallest g value with which a state was reached in the current
+  iteration, so that the subtrees below states that were reached more
+  cheaply before are not searched again.
+*/
+class IDAStarSearch : public SearchAlgorithm {
+    struct Frame {
+        State state;
+        // Operator that leads from the previous frame to this one.
+        OperatorID creating_op;
+        int g;
+        int real_g;
+        std::vector<OperatorID> applicable_ops;
+        std::size_t next_op = 0;
+    };
+
+    struct TranspositionEntry {
+        int g;
+        int iteration;
+    };
+
+    const std::shared_ptr<Evaluator> evaluator;
+    std::unique_ptr<transposition_table::TranspositionTable<TranspositionEntry>>
+        transposition_table;
+
+    int iteration;
+    int threshold;
+    int next_threshold;
+    std::vector<Frame> path;
+
+    bool is_on_path(const State& state) const;
+    bool is_transposition(const State& state, int g);
+    void start_iteration();
+    // Add the state to the path and return true if it is a goal state.
+    bool push(State&& state, OperatorID creating_op, int g, int real_g);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    IDAStarSearch(
+        const std::shared_ptr<Evaluator>& evaluator,
+        int transposition_table_size,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+} // namespace idastar
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SEARCH_ALGORITHMS_LAZY_SEARCH_H
+#define SEARCH_ALGORITHMS_LAZY_SEARCH_H
+
+#include "downward/evaluation_context.h"
+#include "downward/open_list.h"
+#include "downward/operator_id.h"
+#include "downward/search_algorithm.h"
+#include "downward/search_space.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+class OpenListFactory;
+
+namespace utils {
+class RandomNumberGenerator;
+}
+
+namespace lazy_search {
+/*
+  Best-first search with deferred evaluation: successors are inserted into
+  the open list with the evaluator values of their parent and only
+  generated and evaluated when they are removed from the open list.
+*/
+class LazySearch : public SearchAlgorithm {
+protected:
+    std::unique_ptr<EdgeOpenList> open_list;
+
+    // Search behavior parameters
+    bool reopen_closed_nodes; // whether to reopen closed nodes upon finding
+                              // lower g paths
+    bool randomize_successors;
+    std::shared_ptr<utils::RandomNumberGenerator> rng;
+
+    std::vector<Evaluator*> path_dependent_evaluators;
+
+    State current_state;
+    StateID current_predecessor_id;
+    OperatorID current_operator_id;
+    int current_g;
+    int current_real_g;
+    EvaluationContext current_eval_context;
+
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+    void generate_successors();
+    SearchStatus fetch_next_state();
+
+    std::vector<OperatorID> get_successor_operators() const;
+
+public:
+    LazySearch(
+        const std::shared_ptr<OpenListFactory>& open,
+        bool reopen_closed,
+        bool randomize_successors,
+        int random_seed,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+} // namespace lazy_search
+
+#endif
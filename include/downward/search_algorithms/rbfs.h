@@ -0,0 +1,114 @@
+#ifndef SEARCH_ALGORITHMS_RBFS_H
+#define SEARCH_ALGORITHMS_RBFS_H
+
+#include "downward/search_algorithm.h"
+#include "downward/search_algorithms/transposition_table.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace rbfs {
+/*
+  Recursive best-first search (Korf, 1993). It explores the state space in
+  best-first order while only keeping the current path and the siblings of
+  the states on it. When the search backtracks from a subtree, it remembers
+  the smallest f value on the frontier of the subtree (the backed-up value
+  F) at the root of the subtree and uses it to decide when to come back.
+
+  The search does not register states in the state registry. The optional
+  transposition table stores the backed-up values of abandoned subtrees as
+  lower bounds on the cost to reach a goal from their roots, so that they
+  are not lost when the subtree is reached again on another path.
+
+  Pruning successors that are already on the path would make backed-up
+  values depend on the path to the root of the subtree (the graph history
+  interaction problem): if the cheapest continuation from the root goes
+  through such a state, the backed-up value overestimates the cost to reach
+  a goal from the root. Therefore, the search only prunes them when the
+  table is disabled. With the table, it only prunes states that close a
+  cycle of cost 0, which it could otherwise follow forever, and successors
+  that exceed the bound. It remembers the f values of these pruned
+  successors, i.e., their g value plus the h value of the state on the path
+  (or 0 for the bound), and the table stores the minimum of the backed-up
+  value and the f values of the pruned successors above the root.
+*/
+class RBFSSearch : public SearchAlgorithm {
+    struct Child {
+        OperatorID op;
+        // Static f value and backed-up value F.
+        int f;
+        int backed_up_f;
+    };
+
+    struct PrunedSuccessor {
+        // Depth of the state on the path, or -1 if it exceeded the bound.
+        int depth;
+        int f;
+    };
+
+    struct Frame {
+        State state;
+        // Operator that leads from the previous frame to this one.
+        OperatorID creating_op;
+        int g;
+        int real_g;
+        int h;
+        // The subtree is abandoned once its backed-up value exceeds f_limit.
+        int f_limit;
+        std::vector<Child> children;
+        int active_child = -1;
+        /*
+          Successors pruned in the subtree that can still matter for the
+          frames on the path, ordered by increasing depth and decreasing f.
+        */
+        std::vector<PrunedSuccessor> pruned_successors;
+    };
+
+    const std::shared_ptr<Evaluator> evaluator;
+    std::unique_ptr<transposition_table::TranspositionTable<int>>
+        transposition_table;
+
+    std::vector<Frame> path;
+
+    // Return the depth of the state on the path, or -1 if it is not on it.
+    int get_depth_on_path(const State& state) const;
+    /*
+      Add the state to the path and evaluate its children. Return true if
+      it is a goal state.
+    */
+    bool push(
+        State&& state,
+        OperatorID creating_op,
+        int g,
+        int real_g,
+        int f,
+        int backed_up_f,
+        int f_limit);
+    void pop(int backed_up_f);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    RBFSSearch(
+        const std::shared_ptr<Evaluator>& evaluator,
+        int transposition_table_size,
+        std::shared_ptr<ClassicalPlanningTask> task,
+        OperatorCost cost_type,
+        int bound,
+        double max_time,
+        StateHashing state_hashing,
+        const std::shared_ptr<StateStorage>& state_storage,
+        StatePacking state_packing,
+        SuccessorGeneratorType successor_generator_type,
+        const std::string& description,
+        utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+} // namespace rbfs
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef SEARCH_ALGORITHMS_TRANSPOSITION_TABLE_H
+#define SEARCH_ALGORITHMS_TRANSPOSITION_TABLE_H
+
+#include "downward/state.h"
+
+#include "downward/algorithms/int_hash_set.h"
+#include "downward/algorithms/int_packer.h"
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace transposition_table {
+/*
+  Maps states to values of type Value for searches that do not register
+  their states, like IDA* and RBFS. The states are stored in packed form
+  and looked up with an IntHashSet of entry indices.
+
+  The table holds at most max_entries states. Once it is full, no further
+  states are added, but the values of the stored states can still be
+  updated. This bounds the memory of the table at roughly
+  max_entries * (bytes per packed state + sizeof(Value) + 16) bytes.
+*/
+template <typename Value>
+class TranspositionTable {
+    struct EntryHash {
+        const TranspositionTable* table;
+        int_hash_set::HashType operator()(int index) const
+        {
+            return table->hash_buffer(table->get_buffer(index));
+        }
+    };
+
+    struct EntryEqual {
+        const TranspositionTable* table;
+        bool operator()(int lhs, int rhs) const
+        {
+            return std::equal(
+                table->get_buffer(lhs),
+                table->get_buffer(lhs) + table->bins_per_state,
+                table->get_buffer(rhs));
+        }
+    };
+
+    const int_packer::IntPacker& state_packer;
+    const int bins_per_state;
+    const int max_entries;
+
+    std::vector<PackedStateBin> packed_states;
+    std::vector<Value> values;
+    int_hash_set::IntHashSet<EntryHash, EntryEqual> entries;
+    // Packed form of the state that was looked up last.
+    std::vector<PackedStateBin> lookup_buffer;
+
+    const PackedStateBin* get_buffer(int index) const
+    {
+        return packed_states.data() + index * bins_per_state;
+    }
+
+    int_hash_set::HashType hash_buffer(const PackedStateBin* buffer) const
+    {
+        utils::HashState hash_state;
+        for (int i = 0; i < bins_per_state; ++i) {
+            hash_state.feed(buffer[i]);
+        }
+        return hash_state.get_hash32();
+    }
+
+    int_hash_set::HashType pack(const State& state)
+    {
+        state_packer.pack_all(
+            state.get_unpacked_values().data(),
+            lookup_buffer.data());
+        return hash_buffer(lookup_buffer.data());
+    }
+
+    int find_index(int_hash_set::HashType hash) const
+    {
+        return entries.find(hash, [&](int key) {
+            return std::equal(
+                lookup_buffer.begin(),
+                lookup_buffer.end(),
+                get_buffer(key));
+        });
+    }
+
+public:
+    TranspositionTable(
+        const int_packer::IntPacker& state_packer,
+        int max_entries)
+        : state_packer(state_packer)
+        , bins_per_state(state_packer.get_num_bins())
+        , max_entries(max_entries)
+        , entries(EntryHash{this}, EntryEqual{this})
+        , lookup_buffer(bins_per_state)
+    {
+    }
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /*
+      Return a pointer to the value stored for the state or nullptr if the
+      state is not in the table. The pointer is invalidated by the next call
+      to find_or_insert.
+    */
+    Value* find(const State& state)
+    {
+        int index = find_index(pack(state));
+        return index == -1 ? nullptr : &values[index];
+    }
+
+    /*
+      Like find, but add the state with the given value if it is not in the
+      table yet. Return nullptr if the table is full.
+    */
+    Value* find_or_insert(const State& state, const Value& default_value)
+    {
+        int_hash_set::HashType hash = pack(state);
+        int index = find_index(hash);
+        if (index == -1) {
+            if (size() >= max_entries) {
+                return nullptr;
+            }
+            index = size();
+            packed_states.insert(
+                packed_states.end(),
+                lookup_buffer.begin(),
+                lookup_buffer.end());
+            values.push_back(default_value);
+            entries.insert_with_hash(index, hash);
+        }
+        return &values[index];
+    }
+
+    int size() const { return values.size(); }
+
+    void print_statistics(utils::LogProxy& log) const
+    {
+        log << "Transposition table entries: " << size() << "/" << max_entries
+            << std::endl;
+    }
+};
+} // namespace transposition_table
+
+#endif
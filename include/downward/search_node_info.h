@@ -4,26 +4,58 @@
 #include "downward/operator_id.h"
 #include "downward/state_id.h"
 
+#include <type_traits>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
-struct SearchNodeInfo {
+/*
+  The information stored for each search node. Searches that do not need all
+  fields can drop them at compile time: real_g can be omitted if it always
+  equals g, and the parent pointers can be omitted if plans are reconstructed
+  by regression from the goal (see BasicSearchSpace::trace_path). Omitted
+  fields take no memory.
+*/
+namespace search_node_info {
+struct RealG {
+    int real_g = -1;
+};
+
+struct NoRealG {};
+
+struct ParentPointers {
+    StateID parent_state_id = StateID::no_state;
+    OperatorID creating_operator = OperatorID(-1);
+};
+
+struct NoParentPointers {};
+} // namespace search_node_info
+
+template <bool STORE_REAL_G, bool STORE_PARENT>
+struct BasicSearchNodeInfo
+    : public std::conditional_t<
+          STORE_PARENT,
+          search_node_info::ParentPointers,
+          search_node_info::NoParentPointers>,
+      public std::conditional_t<
+          STORE_REAL_G,
+          search_node_info::RealG,
+          search_node_info::NoRealG> {
+    static constexpr bool stores_real_g = STORE_REAL_G;
+    static constexpr bool stores_parent = STORE_PARENT;
+
     enum NodeStatus { NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3 };
 
     unsigned int status : 2;
     int g : 30;
-    StateID parent_state_id;
-    OperatorID creating_operator;
-    int real_g;
 
-    SearchNodeInfo()
+    BasicSearchNodeInfo()
         : status(NEW)
         , g(-1)
-        , parent_state_id(StateID::no_state)
-        , creating_operator(-1)
-        , real_g(-1)
     {
     }
 };
 
+using SearchNodeInfo = BasicSearchNodeInfo<true, true>;
+
 #endif
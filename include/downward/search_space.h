@@ -15,12 +15,13 @@ namespace utils {
 class LogProxy;
 }
 
-class SearchNode {
+template <typename NodeInfo>
+class BasicSearchNode {
     State state;
-    SearchNodeInfo& info;
+    NodeInfo& info;
 
 public:
-    SearchNode(const State& state, SearchNodeInfo& info);
+    BasicSearchNode(const State& state, NodeInfo& info);
 
     const State& get_state() const;
 
@@ -34,17 +35,25 @@ public:
 
     void open_initial();
     void open(
-        const SearchNode& parent_node,
+        const BasicSearchNode& parent_node,
         const OperatorProxy& parent_op,
         int adjusted_cost);
     void reopen(
-        const SearchNode& parent_node,
+        const BasicSearchNode& parent_node,
         const OperatorProxy& parent_op,
         int adjusted_cost);
     void update_parent(
-        const SearchNode& parent_node,
+        const BasicSearchNode& parent_node,
         const OperatorProxy& parent_op,
         int adjusted_cost);
+    /*
+      Like open_initial and reopen, but for nodes whose parent is not
+      registered in the same state registry. The node gets the given g values
+      and no parent, so trace_path stops at it; the caller is responsible for
+      remembering the real parent.
+    */
+    void open_without_parent(int g, int real_g);
+    void reopen_without_parent(int g, int real_g);
     void close();
     void mark_as_dead_end();
 
@@ -54,16 +63,44 @@ public:
     void reopen();
 };
 
-class SearchSpace {
-    PerStateInformation<SearchNodeInfo> search_node_infos;
+/*
+  Maps registered states to their search nodes. NodeInfo determines which
+  information is stored for each node (see BasicSearchNodeInfo).
+
+  If no parent pointers are stored, trace_path reconstructs the path by
+  regression from the goal: it searches backwards for registered
+  predecessors whose g value plus the (adjusted) cost of the operator leading
+  to the state does not exceed the g value of the state. Such a predecessor
+  always exists because g values only decrease. The cost of the traced path
+  is at most the g value of the goal.
+*/
+template <typename NodeInfo>
+class BasicSearchSpace {
+    PerStateInformation<NodeInfo> search_node_infos;
 
     StateRegistry& state_registry;
     utils::LogProxy& log;
+    // Only needed for regression.
+    const OperatorCost cost_type;
+
+    void trace_path_by_regression(
+        const State& goal_state,
+        std::vector<OperatorID>& path,
+        std::vector<StateID>& trajectory) const;
 
 public:
-    SearchSpace(StateRegistry& state_registry, utils::LogProxy& log);
+    using Node = BasicSearchNode<NodeInfo>;
+
+    /*
+      cost_type is the cost type used for the g values. It is only needed if
+      no parent pointers are stored.
+    */
+    BasicSearchSpace(
+        StateRegistry& state_registry,
+        utils::LogProxy& log,
+        OperatorCost cost_type = NORMAL);
 
-    SearchNode get_node(const State& state);
+    BasicSearchNode<NodeInfo> get_node(const State& state);
 
     void
     trace_path(const State& goal_state, std::vector<OperatorID>& path) const;
@@ -74,11 +111,13 @@ public:
     // NeuralFD hacks
 
     StateID get_parent_id(const State& state) const
+        requires NodeInfo::stores_parent
     {
         return search_node_infos[state].parent_state_id;
     }
 
     OperatorID get_creating_operator(const State& state) const
+        requires NodeInfo::stores_parent
     {
         return search_node_infos[state].creating_operator;
     }
@@ -92,4 +131,7 @@ public:
         std::vector<StateID>& trajectory) const;
 };
 
+using SearchNode = BasicSearchNode<SearchNodeInfo>;
+using SearchSpace = BasicSearchSpace<SearchNodeInfo>;
+
 #endif
@@ -26,6 +26,11 @@ class SearchStatistics {
 
     int generated_ops;    // no of operators that were returned as applicable
 
+    // Statistics of searches that store states in files
+    long long bytes_read;
+    long long bytes_written;
+    double merge_time;    // seconds spent merging sorted files
+
     // Statistics related to f values
     int lastjump_f_value; //f value obtained in the last jump
     int lastjump_expanded_states; // same guy but at point where the last jump in the open list
@@ -46,6 +51,9 @@ public:
     void inc_generated_ops(int inc = 1) {generated_ops += inc;}
     void inc_evaluations(int inc = 1) {evaluations += inc;}
     void inc_dead_ends(int inc = 1) {dead_end_states += inc;}
+    void inc_bytes_read(long long inc) {bytes_read += inc;}
+    void inc_bytes_written(long long inc) {bytes_written += inc;}
+    void inc_merge_time(double seconds) {merge_time += seconds;}
 
     // Methods that access statistics.
     int get_expanded() const {return expanded_states;}
@@ -54,6 +62,10 @@ public:
     int get_generated() const {return generated_states;}
     int get_reopened() const {return reopened_states;}
     int get_generated_ops() const {return generated_ops;}
+    int get_dead_ends() const {return dead_end_states;}
+    long long get_bytes_read() const {return bytes_read;}
+    long long get_bytes_written() const {return bytes_written;}
+    double get_merge_time() const {return merge_time;}
 
     /*
       Call the following method with the f value of every expanded
@@ -19,7 +19,11 @@ class FactProxy;
 class VariableProxy;
 class OperatorProxy;
 
-class StateRegistry;
+class StateRegistryBase;
+
+namespace successor_generator {
+class SuccessorGenerator;
+}
 
 /**
  * @brief Represents a state of a planning task \f$\task\f$, i.e. a complete
@@ -48,7 +52,7 @@ class StateRegistry;
  * @ingroup states
  */
 class State {
-    const StateRegistry* registry;
+    const StateRegistryBase* registry;
     StateID id;
     const PackedStateBin* buffer;
 
@@ -62,17 +66,25 @@ class State {
 
     /* Return a pointer to the registry in which this state is registered.
    If the state is not registered, return nullptr. */
-    const StateRegistry* get_registry() const;
+    const StateRegistryBase* get_registry() const;
+
+    /* Call f with a range of the values of this state and return its
+   result. The values of a packed state are read from the packed data on
+   the fly, without copying or caching them. */
+    template <typename F>
+    auto visit_values(F&& f) const;
 
     // Construct a registered state.
     State(
-        const StateRegistry& registry,
+        const StateRegistryBase& registry,
         StateID id,
         const PackedStateBin* buffer);
 
     // Friend Declarations
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
     friend class AbstractPlanningTask;
+    friend class successor_generator::SuccessorGenerator;
     template <typename>
     friend class PerStateArray;
     template <typename>
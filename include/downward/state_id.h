@@ -9,6 +9,7 @@
 
 class StateID {
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
     friend std::ostream& operator<<(std::ostream& os, StateID id);
     template <typename>
     friend class PerStateInformation;
@@ -4,14 +4,19 @@
 #include "downward/abstract_task.h"
 #include "downward/state_id.h"
 #include "downward/state.h"
+#include "downward/state_storage.h"
 
 #include "downward/algorithms/int_hash_set.h"
 #include "downward/algorithms/int_packer.h"
 #include "downward/algorithms/segmented_vector.h"
 #include "downward/algorithms/subscriber.h"
+#include "downward/task_utils/flat_operator_table.h"
 #include "downward/task_utils/task_properties.h"
 #include "downward/utils/hash.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -50,6 +55,11 @@
 
   -------------
 
+  StateRegistryBase
+    Common base of all registries. Registered states point to the registry
+    that created them and per-state information is keyed by it, so these only
+    depend on this class.
+
   StateRegistry
     The StateRegistry allows to create states giving them an ID. IDs from
     different state registries must not be mixed.
@@ -60,6 +70,8 @@
     This class is used to store the actual (packed) state data for all states
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
+    Its memory is provided by a StateStorage, e.g., the heap or a
+    memory-mapped file.
 
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
@@ -111,23 +123,111 @@ namespace int_packer {
 class IntPacker;
 }
 
-class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+/*
+  How StateRegistry hashes states for duplicate detection.
+
+  PACKED_DATA hashes all packed bins of a state whenever it is inserted.
+  ZOBRIST stores a 64-bit Zobrist hash (the XOR of random keys for all facts
+  of the state) for every registered state. The hash of a successor is then
+  derived from the hash of its predecessor in time linear in the number of
+  effects, which pays off for tasks with many bins. This costs 8 bytes of
+  memory per state.
+*/
+enum class StateHashing {
+    PACKED_DATA,
+    ZOBRIST
+};
+
+/*
+  Holds what registered states and per-state information (PerStateInformation,
+  PerStateArray) need to know about the registry that created a state. All IDs
+  handed out by a registry are smaller than get_state_id_bound(), so per-state
+  information can be stored in vectors indexed by ID.
+
+  Derived classes store the state data and have to keep state_id_bound up to
+  date. See ConcurrentStateRegistry for a registry that can be used from
+  several threads.
+*/
+class StateRegistryBase
+    : public subscriber::SubscriberService<StateRegistryBase> {
+protected:
+    const AbstractPlanningTask& task;
+    const StatePacking state_packing;
+    const int_packer::IntPacker& state_packer;
+    const int num_variables;
+    // Only set for classical planning tasks.
+    const flat_operator_table::FlatOperatorTable* flat_operators;
+
+    std::atomic<size_t> state_id_bound;
+
+    StateRegistryBase(
+        const AbstractPlanningTask& task,
+        StatePacking state_packing);
+
+    int get_bins_per_state() const;
+
+public:
+    const AbstractPlanningTask& get_task_proxy() const { return task; }
+
+    int get_num_variables() const { return num_variables; }
+
+    StatePacking get_state_packing() const { return state_packing; }
+
+    const int_packer::IntPacker& get_state_packer() const
+    {
+        return state_packer;
+    }
+
+    /*
+      Returns the flat operator table of the task or nullptr if the task is
+      not a classical planning task.
+    */
+    const flat_operator_table::FlatOperatorTable* get_flat_operators() const
+    {
+        return flat_operators;
+    }
+
+    size_t get_state_id_bound() const
+    {
+        return state_id_bound.load(std::memory_order_relaxed);
+    }
+
+    int get_state_size_in_bytes() const;
+};
+
+class StateRegistry : public StateRegistryBase {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin,
+        StateStorageAllocator<PackedStateBin>>;
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
+        // Only set for Zobrist hashing.
+        const segmented_vector::SegmentedVector<std::uint64_t>* state_hashes;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
-            int state_size)
+            const StateDataPool& state_data_pool,
+            int state_size,
+            const segmented_vector::SegmentedVector<std::uint64_t>*
+                state_hashes)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
+            , state_hashes(state_hashes)
         {
         }
 
         int_hash_set::HashType operator()(int id) const
         {
-            const PackedStateBin* data = state_data_pool[id];
+            if (state_hashes) {
+                return static_cast<int_hash_set::HashType>(
+                    (*state_hashes)[id]);
+            }
+            return hash_state_data(state_data_pool[id], state_size);
+        }
+
+        static int_hash_set::HashType
+        hash_state_data(const PackedStateBin* data, int state_size)
+        {
             utils::HashState hash_state;
             for (int i = 0; i < state_size; ++i) {
                 hash_state.feed(data[i]);
@@ -137,12 +237,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
+            const StateDataPool& state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
@@ -165,30 +263,68 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     using StateIDSet =
         int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
 
-    const AbstractPlanningTask& task;
-    const int_packer::IntPacker& state_packer;
-    const int num_variables;
+    const StateHashing hashing;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    /*
+      For Zobrist hashing, zobrist_keys[zobrist_offsets[var] + value] is the
+      key of fact var=value and state_hashes[id] is the hash of the state with
+      the given ID.
+    */
+    std::vector<std::uint64_t> zobrist_keys;
+    std::vector<int> zobrist_offsets;
+    segmented_vector::SegmentedVector<std::uint64_t> state_hashes;
+
+    std::shared_ptr<StateStorage> state_storage;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
 
-    StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
-
-public:
-    explicit StateRegistry(const AbstractPlanningTask& task);
+    /*
+      States are computed in this buffer before they are registered, so
+      that only new states have to be copied to state_data_pool.
+    */
+    std::vector<PackedStateBin> scratch_buffer;
 
-    const AbstractPlanningTask& get_task_proxy() const { return task; }
+    std::uint64_t get_zobrist_key(int var, int value) const
+    {
+        return zobrist_keys[zobrist_offsets[var] + value];
+    }
 
-    int get_num_variables() const { return num_variables; }
+    /*
+      Computes the hash of the given state data from scratch. For Zobrist
+      hashing, this has to unpack all variables.
+    */
+    std::uint64_t compute_state_hash(const PackedStateBin* buffer) const;
 
-    const int_packer::IntPacker& get_state_packer() const
+    /*
+      Returns the ID of the state with the given data and hash and copies the
+      data to state_data_pool if the state is new. The data must not be stored
+      in state_data_pool.
+    */
+    StateID insert_if_new(const PackedStateBin* buffer, std::uint64_t hash);
+    // Returns the ID of the registered state with the given data or -1.
+    int find_registered_state(
+        const PackedStateBin* buffer,
+        std::uint64_t hash) const;
+    PackedStateBin* pack_into_scratch_buffer(const std::vector<int>& values);
+
+    static FactPair get_fact_pair(const FactPair& fact) { return fact; }
+    static FactPair get_fact_pair(const FactProxy& fact)
     {
-        return state_packer;
+        return fact.get_pair();
     }
 
+public:
+    /*
+      If no state storage is given, the state data is stored on the heap.
+    */
+    explicit StateRegistry(
+        const AbstractPlanningTask& task,
+        StateHashing hashing = StateHashing::PACKED_DATA,
+        std::shared_ptr<StateStorage> state_storage = nullptr,
+        StatePacking state_packing = StatePacking::BINS);
+
     /*
       Returns the state that was registered at the given ID. The ID must refer
       to a state in this registry. Do not mix IDs from from different
@@ -205,6 +341,27 @@ public:
 
     State insert_state(std::vector<int>&& state);
 
+    /*
+      Returns the ID of the registered state with the given values or
+      StateID::no_state if no such state has been registered. Does not
+      register the state.
+    */
+    StateID find_state(const std::vector<int>& values);
+
+    /*
+      Registers the state given by its packed data if this was not done
+      before and returns it. The data must have been packed with the state
+      packer of this registry's task, e.g. by another registry for the same
+      task.
+    */
+    State insert_packed_state(const PackedStateBin* buffer);
+
+    /*
+      Returns the packed data of a state registered in this registry. The
+      data lives as long as the registry.
+    */
+    const PackedStateBin* get_packed_state(const State& state) const;
+
     /*
       Returns the state that results from applying op to predecessor and
       registers it if this was not done before. This is an expensive operation
@@ -213,32 +370,51 @@ public:
     State
     get_successor_state(const State& predecessor, const OperatorProxy& op);
 
+    // Effects can be a range of FactProxy or FactPair objects.
     template <typename Effects>
     State get_successor_state(const State& predecessor, const Effects& effects)
     {
-        state_data_pool.push_back(predecessor.get_buffer());
-        PackedStateBin* buffer = state_data_pool[state_data_pool.size() - 1];
-
-        /* Experiments for issue348 showed that for domains with axioms it's
-           faster to compute successor states using unpacked data. */
-        for (auto effect : effects) {
-            FactPair effect_pair = effect.get_pair();
-            state_packer.set(
-                buffer,
-                effect_pair.var,
-                effect_pair.value);
+        assert(predecessor.get_registry() == this);
+        PackedStateBin* buffer = scratch_buffer.data();
+        std::copy_n(predecessor.get_buffer(), get_bins_per_state(), buffer);
+
+        if (hashing == StateHashing::ZOBRIST) {
+            std::uint64_t hash = state_hashes[predecessor.get_id().value];
+            state_packer.visit_layout([&](const auto& vars) {
+                for (const auto& effect : effects) {
+                    FactPair effect_pair = get_fact_pair(effect);
+                    int old_value = vars.get(buffer, effect_pair.var);
+                    hash ^= get_zobrist_key(effect_pair.var, old_value) ^
+                            get_zobrist_key(effect_pair.var, effect_pair.value);
+                    vars.set(buffer, effect_pair.var, effect_pair.value);
+                }
+            });
+            return lookup_state(insert_if_new(buffer, hash));
         }
-        ::StateID id = insert_id_or_pop_state();
-        return task.create_state(*this, id, buffer);
+
+        state_packer.visit_layout([&](const auto& vars) {
+            for (const auto& effect : effects) {
+                FactPair effect_pair = get_fact_pair(effect);
+                vars.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        });
+        return lookup_state(insert_if_new(buffer, compute_state_hash(buffer)));
     }
 
+    /*
+      Returns a 64-bit hash of a state registered in this registry. For
+      Zobrist hashing, this is the stored hash and hence free. Since it only
+      depends on the state data, it is the same in all registries for the
+      same task with the same hashing mode, so parallel search algorithms can
+      use it to partition the state space.
+    */
+    std::uint64_t get_state_hash(const State& state) const;
+
     /*
       Returns the number of states registered so far.
     */
     size_t size() const { return registered_states.size(); }
 
-    int get_state_size_in_bytes() const;
-
     void print_statistics(utils::LogProxy& log) const;
 
     class const_iterator {
@@ -284,7 +460,7 @@ public:
         friend bool
         operator==(const const_iterator& lhs, const const_iterator& rhs)
         {
-            assert(&lhs.registry == &rhs.registry);
+            assert(lhs.registry == rhs.registry);
             return lhs.pos == rhs.pos;
         }
 
@@ -0,0 +1,80 @@
+#ifndef STATE_STORAGE_H
+#define STATE_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+
+namespace utils {
+class LogProxy;
+}
+
+/*
+  Provides the memory in which a StateRegistry stores the packed data of its
+  states. The registry requests memory in segments of a few KB (see
+  SegmentedArrayVector) and only frees them when it is destroyed.
+
+  A StateStorage object may be shared by several registries, but it is not
+  thread-safe.
+*/
+class StateStorage {
+public:
+    virtual ~StateStorage() = default;
+
+    virtual void* allocate(std::size_t num_bytes) = 0;
+    virtual void deallocate(void* memory, std::size_t num_bytes) = 0;
+
+    virtual void print_statistics(utils::LogProxy& log) const;
+};
+
+// Allocates the state data on the heap.
+class HeapStateStorage : public StateStorage {
+public:
+    virtual void* allocate(std::size_t num_bytes) override;
+    virtual void deallocate(void* memory, std::size_t num_bytes) override;
+};
+
+/*
+  Allocator that takes its memory from a StateStorage, so that containers
+  like SegmentedArrayVector can be used on top of any state storage.
+*/
+template <typename T>
+class StateStorageAllocator {
+    template <typename>
+    friend class StateStorageAllocator;
+
+    std::shared_ptr<StateStorage> storage;
+
+public:
+    using value_type = T;
+
+    explicit StateStorageAllocator(std::shared_ptr<StateStorage> storage)
+        : storage(std::move(storage))
+    {
+    }
+
+    template <typename U>
+    StateStorageAllocator(const StateStorageAllocator<U>& other)
+        : storage(other.storage)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(storage->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* memory, std::size_t n)
+    {
+        storage->deallocate(memory, n * sizeof(T));
+    }
+
+    template <typename U>
+    friend bool operator==(
+        const StateStorageAllocator<T>& lhs,
+        const StateStorageAllocator<U>& rhs)
+    {
+        return lhs.storage == rhs.storage;
+    }
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef STATE_STORAGES_MMAP_STATE_STORAGE_H
+#define STATE_STORAGES_MMAP_STATE_STORAGE_H
+
+#include "downward/state_storage.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mmap_state_storage {
+/*
+  Stores the state data in a sparse file that is mapped into memory in
+  chunks of chunk_size bytes. Since the mapping is shared with the file, the
+  operating system can write pages of state data that are not used for a
+  while back to the file and drop them from memory instead of running out of
+  memory. We do not mark full chunks as cold: the hash set of the registry
+  probes old states as often as new ones.
+
+  The file is deleted right after it is created, so it disappears when the
+  process terminates. Note that the mapped memory counts towards the address
+  space limit of the process.
+
+  Only supported on Linux and macOS.
+*/
+class MmapStateStorage : public StateStorage {
+    const std::string path;
+    const std::size_t chunk_size;
+    int file_descriptor;
+
+    std::vector<char*> chunks;
+    std::size_t used_bytes_in_chunk;
+    std::size_t file_size;
+
+    void add_chunk();
+
+public:
+    MmapStateStorage(const std::string& path, int chunk_size_in_mb);
+    virtual ~MmapStateStorage() override;
+
+    virtual void* allocate(std::size_t num_bytes) override;
+    virtual void deallocate(void* memory, std::size_t num_bytes) override;
+
+    virtual void print_statistics(utils::LogProxy& log) const override;
+};
+} // namespace mmap_state_storage
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef TASK_UTILS_FLAT_OPERATOR_TABLE_H
+#define TASK_UTILS_FLAT_OPERATOR_TABLE_H
+
+#include "downward/per_task_information.h"
+#include "downward/task_proxy.h"
+
+#include <span>
+#include <vector>
+
+class AbstractPlanningTask;
+class ClassicalPlanningTask;
+
+namespace flat_operator_table {
+/*
+  Stores the preconditions, effects and costs of all operators of a
+  classical planning task in a few contiguous arrays. The facts of operator
+  op are preconditions[precondition_begin[op]] to
+  preconditions[precondition_begin[op + 1] - 1] (and analogously for
+  effects), like in the compressed sparse row format for matrices.
+
+  Accessing operators through OperatorProxy objects costs one virtual call
+  per fact, which is noticeable in code that is called for every generated
+  state. The table avoids this by copying the operators once per task.
+*/
+class FlatOperatorTable {
+    std::vector<int> precondition_begin;
+    std::vector<FactPair> preconditions;
+    std::vector<int> effect_begin;
+    std::vector<FactPair> effects;
+    std::vector<int> costs;
+
+public:
+    explicit FlatOperatorTable(const ClassicalPlanningTask& task);
+
+    int get_num_operators() const { return costs.size(); }
+
+    std::span<const FactPair> get_preconditions(int op) const
+    {
+        return std::span<const FactPair>(
+            preconditions.data() + precondition_begin[op],
+            preconditions.data() + precondition_begin[op + 1]);
+    }
+
+    std::span<const FactPair> get_effects(int op) const
+    {
+        return std::span<const FactPair>(
+            effects.data() + effect_begin[op],
+            effects.data() + effect_begin[op + 1]);
+    }
+
+    int get_cost(int op) const { return costs[op]; }
+};
+
+/*
+  Returns the table of the given task and creates it on first use. The
+  table is destroyed together with the task.
+*/
+extern const FlatOperatorTable&
+get_flat_operator_table(const ClassicalPlanningTask& task);
+} // namespace flat_operator_table
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef TASK_UTILS_INCREMENTAL_SUCCESSOR_GENERATOR_H
+#define TASK_UTILS_INCREMENTAL_SUCCESSOR_GENERATOR_H
+
+#include "downward/operator_id.h"
+#include "downward/state_id.h"
+
+#include "downward/utils/hash.h"
+
+#include <deque>
+#include <vector>
+
+class ClassicalPlanningTask;
+class State;
+
+namespace flat_operator_table {
+class FlatOperatorTable;
+}
+
+namespace utils {
+class LogProxy;
+}
+
+namespace successor_generator {
+class SuccessorGenerator;
+
+/*
+  Computes the applicable operators of a state from those of its parent. A
+  state s reached from its parent p with operator o only differs from p on
+  the variables in the effect of o. Hence, the operators applicable in s are
+  the operators applicable in p that have no precondition on these
+  variables plus the operators with a precondition on these variables that
+  are applicable in s.
+
+  The applicable operators of the last max_cached_states states for which
+  they were generated are cached. If the parent of a state is not in the
+  cache, e.g., because the state was reopened a long time after its parent
+  was expanded, we fall back to generating the operators with the
+  underlying successor generator.
+
+  The operators are not generated in the same order as by the underlying
+  successor generator.
+*/
+class IncrementalSuccessorGenerator {
+    const SuccessorGenerator& successor_generator;
+    const flat_operator_table::FlatOperatorTable& flat_operators;
+    const int max_cached_states;
+
+    // Operators with a precondition on the given variable.
+    std::vector<std::vector<OperatorID>> operators_by_precondition_var;
+
+    utils::HashMap<int, std::vector<OperatorID>> cached_applicable_ops;
+    // Cached state IDs in the order in which they were added.
+    std::deque<int> cache_order;
+
+    /*
+      Marks for changed variables and rechecked operators. An entry is
+      marked if it equals the current mark, so we do not have to reset the
+      vectors.
+    */
+    std::vector<int> var_marks;
+    std::vector<int> op_marks;
+    int current_mark;
+
+    int num_incremental_generations;
+    int num_full_generations;
+
+    void cache(StateID id, const std::vector<OperatorID>& applicable_ops);
+
+public:
+    IncrementalSuccessorGenerator(
+        const ClassicalPlanningTask& task,
+        const SuccessorGenerator& successor_generator,
+        int max_cached_states);
+
+    /*
+      Pass StateID::no_state as parent_id for the initial state. The state
+      must result from applying creating_operator in the parent.
+    */
+    void generate_applicable_ops(
+        const State& state,
+        StateID parent_id,
+        OperatorID creating_operator,
+        std::vector<OperatorID>& applicable_ops);
+
+    void print_statistics(utils::LogProxy& log) const;
+};
+} // namespace successor_generator
+
+#endif
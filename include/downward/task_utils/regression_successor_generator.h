@@ -0,0 +1,64 @@
+#ifndef TASK_UTILS_REGRESSION_SUCCESSOR_GENERATOR_H
+#define TASK_UTILS_REGRESSION_SUCCESSOR_GENERATOR_H
+
+#include "downward/operator_id.h"
+
+#include <vector>
+
+class ClassicalPlanningTask;
+
+namespace flat_operator_table {
+class FlatOperatorTable;
+}
+
+namespace regression_successor_generator {
+/*
+  Value of the variables that a partial state does not assign. Partial
+  states are given as one value per variable, like states.
+*/
+const int UNASSIGNED = -1;
+
+/*
+  Generates the regressions of partial states for backward search. An
+  operator o is relevant for a partial state p if it achieves a fact of p
+  and assigns no variable of p a different value. The regression of p
+  through o is p without the facts on the effect variables of o plus the
+  preconditions of o. It does not exist if a precondition contradicts a
+  fact of p that o does not change. We also discard regressions in which
+  a precondition is mutex with another fact, since no reachable state
+  satisfies them.
+
+  A state s satisfies the regression of p through o iff o is applicable in
+  s and its successor satisfies p.
+*/
+class RegressionSuccessorGenerator {
+    const ClassicalPlanningTask& task;
+    const flat_operator_table::FlatOperatorTable& flat_operators;
+    std::vector<int> fact_offsets;
+    // Operators that achieve the given fact.
+    std::vector<std::vector<OperatorID>> achievers;
+    // Marks for operators that were already generated for the current state.
+    mutable std::vector<int> op_marks;
+    mutable int current_mark;
+
+public:
+    explicit RegressionSuccessorGenerator(const ClassicalPlanningTask& task);
+
+    // Append the operators relevant for the partial state to ops.
+    void generate_relevant_ops(
+        const std::vector<int>& partial_state,
+        std::vector<OperatorID>& ops) const;
+
+    /*
+      Store the regression of the partial state through the relevant
+      operator op in result and return true, or return false if the
+      regression does not exist.
+    */
+    bool regress(
+        const std::vector<int>& partial_state,
+        OperatorID op,
+        std::vector<int>& result) const;
+};
+} // namespace regression_successor_generator
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "downward/per_task_information.h"
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -10,14 +11,40 @@ class OperatorID;
 class State;
 class AbstractPlanningTask;
 
+/*
+  TREE uses a tree of polymorphic nodes and unpacks the states for which
+  applicable operators are generated. COMPILED flattens this tree into a
+  GeneratorProgram that reads the values of registered states directly from
+  their packed data. BITSET intersects per-fact operator bitsets instead of
+  walking a tree (see BitsetGenerator).
+*/
+enum class SuccessorGeneratorType {
+    TREE,
+    COMPILED,
+    BITSET
+};
+
 namespace successor_generator {
 class GeneratorBase;
+class GeneratorProgram;
+class BitsetGenerator;
 
 class SuccessorGenerator {
+    // Exactly one of these is set, depending on the type.
     std::unique_ptr<GeneratorBase> root;
+    std::unique_ptr<GeneratorProgram> program;
+    std::unique_ptr<BitsetGenerator> bitset_generator;
+
+    template <typename Generator>
+    static void generate_applicable_ops(
+        const Generator& generator,
+        const State& state,
+        std::vector<OperatorID>& applicable_ops);
 
 public:
-    explicit SuccessorGenerator(const AbstractPlanningTask& task);
+    explicit SuccessorGenerator(
+        const AbstractPlanningTask& task,
+        SuccessorGeneratorType type = SuccessorGeneratorType::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -30,7 +57,18 @@ public:
         std::vector<OperatorID>& applicable_ops) const;
 };
 
-extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+// The successor generators of a task, one for each type, created on demand.
+class SuccessorGenerators {
+    const AbstractPlanningTask& task;
+    std::array<std::unique_ptr<SuccessorGenerator>, 3> generators;
+
+public:
+    explicit SuccessorGenerators(const AbstractPlanningTask& task);
+
+    SuccessorGenerator& operator[](SuccessorGeneratorType type);
+};
+
+extern PerTaskInformation<SuccessorGenerators> g_successor_generators;
 } // namespace successor_generator
 
 #endif
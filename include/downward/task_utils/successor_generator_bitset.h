@@ -0,0 +1,72 @@
+#ifndef TASK_UTILS_SUCCESSOR_GENERATOR_BITSET_H
+#define TASK_UTILS_SUCCESSOR_GENERATOR_BITSET_H
+
+#include "downward/operator_id.h"
+
+#include "downward/algorithms/int_packer.h"
+
+#include <cstdint>
+#include <vector>
+
+class AbstractPlanningTask;
+
+namespace successor_generator {
+/*
+  Computes the applicable operators without a precondition tree. For every
+  fact var=value where var occurs in some precondition, we store the bitset
+  of operators that are compatible with it, i.e., operators that have no
+  precondition on var or the precondition var=value. An operator is
+  applicable in a state iff it is compatible with all facts that are true
+  in the state, so the applicable operators are the AND of one bitset per
+  precondition variable.
+
+  This takes num_operators / 8 bytes per fact of a precondition variable
+  and time linear in this size per state, independent of the structure of
+  the preconditions. It is meant for tasks with very many operators, where
+  the precondition tree gets very deep and its nodes are spread over
+  memory.
+
+  The operators are generated in the order of their IDs.
+*/
+class BitsetGenerator {
+    using Word = std::uint64_t;
+    static const int BITS_PER_WORD = 64;
+
+    int num_operators;
+    // Number of words per bitset, rounded up to a multiple of 4 for SIMD.
+    int num_words;
+    // Variables that occur in at least one precondition.
+    std::vector<int> precondition_vars;
+    // Index of the bitset of precondition_vars[i]=0 in bitsets.
+    std::vector<int> first_bitset;
+    // num_words words per bitset. Unused bits are always 0.
+    std::vector<Word> bitsets;
+    // Bitset containing all operators.
+    std::vector<Word> all_operators;
+
+    const Word* get_bitset(int bitset_index) const
+    {
+        return bitsets.data() +
+               static_cast<std::size_t>(bitset_index) * num_words;
+    }
+
+    template <typename Values>
+    void compute_applicable_ops(
+        const Values& values,
+        std::vector<OperatorID>& applicable_ops) const;
+
+public:
+    explicit BitsetGenerator(const AbstractPlanningTask& task);
+
+    void generate_applicable_ops(
+        const std::vector<int>& state,
+        std::vector<OperatorID>& applicable_ops) const;
+
+    void generate_applicable_ops(
+        const PackedStateBin* buffer,
+        const int_packer::IntPacker& state_packer,
+        std::vector<OperatorID>& applicable_ops) const;
+};
+} // namespace successor_generator
+
+#endif
@@ -17,6 +17,12 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const = 0;
+
+    /*
+      Appends the nodes of this subtree to the given GeneratorProgram code
+      and returns the position of this node.
+    */
+    virtual int append_to(std::vector<int>& code) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -31,6 +37,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -42,6 +50,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
@@ -56,6 +66,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
@@ -71,6 +83,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
@@ -87,6 +101,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -98,6 +114,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -109,6 +127,8 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+
+    virtual int append_to(std::vector<int>& code) const override;
 };
 } // namespace successor_generator
 
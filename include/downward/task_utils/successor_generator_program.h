@@ -0,0 +1,90 @@
+#ifndef TASK_UTILS_SUCCESSOR_GENERATOR_PROGRAM_H
+#define TASK_UTILS_SUCCESSOR_GENERATOR_PROGRAM_H
+
+#include "downward/operator_id.h"
+
+#include "downward/algorithms/int_packer.h"
+
+#include <vector>
+
+namespace successor_generator {
+class GeneratorBase;
+
+/*
+  Reads the values of a registered state from its packed data. Successor
+  generators that are templated on the state representation can use this
+  instead of a vector of unpacked values. Layout is one of the variable
+  layouts of IntPacker (see IntPacker::visit_layout).
+*/
+template <typename Layout>
+class PackedValues {
+    const PackedStateBin* buffer;
+    Layout vars;
+
+public:
+    PackedValues(const PackedStateBin* buffer, const Layout& vars)
+        : buffer(buffer)
+        , vars(vars)
+    {
+    }
+
+    int operator[](int var) const { return vars.get(buffer, var); }
+};
+
+/*
+  Node types of a GeneratorProgram. Each node is a sequence of ints that
+  starts with its type, and children are referred to by their position in
+  the program:
+
+  - fork:          [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, var, k, child_0, ..., child_{k-1}]
+                   where child_i is the child for value i or -1 if there is
+                   none
+  - sorted switch: [SWITCH_SORTED, var, k, value_1, ..., value_k,
+                    child_1, ..., child_k] with increasing values
+  - single switch: [SWITCH_SINGLE, var, value, child]
+  - leaf:          [LEAF, n, op_id_1, ..., op_id_n]
+*/
+enum class GeneratorOpcode {
+    FORK,
+    SWITCH_VECTOR,
+    SWITCH_SORTED,
+    SWITCH_SINGLE,
+    LEAF
+};
+
+/*
+  Successor generator that stores the nodes of a successor generator tree
+  in a single vector in the "byte-code" style representation described in
+  successor_generator_internals.cc. Walking the program needs no virtual
+  calls, and the state values can be read directly from the packed state
+  data, so states do not have to be unpacked for generating their
+  applicable operators.
+*/
+class GeneratorProgram {
+    std::vector<int> code;
+    int root;
+
+    template <typename Values>
+    void generate_applicable_ops(
+        int node,
+        const Values& values,
+        std::vector<OperatorID>& applicable_ops) const;
+
+public:
+    explicit GeneratorProgram(const GeneratorBase& root);
+
+    void generate_applicable_ops(
+        const std::vector<int>& state,
+        std::vector<OperatorID>& applicable_ops) const;
+
+    void generate_applicable_ops(
+        const PackedStateBin* buffer,
+        const int_packer::IntPacker& state_packer,
+        std::vector<OperatorID>& applicable_ops) const;
+
+    int get_size_in_bytes() const { return code.size() * sizeof(int); }
+};
+} // namespace successor_generator
+
+#endif
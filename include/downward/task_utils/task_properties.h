@@ -6,6 +6,9 @@
 
 #include "downward/algorithms/int_packer.h"
 
+#include <array>
+#include <memory>
+
 namespace utils {
 class LogProxy;
 }
@@ -16,6 +19,24 @@ class ClassicalPlanningTask;
 class GoalProxy;
 class State;
 
+/*
+  How the state registry packs the variables of a state into bins.
+
+  BINS packs variables greedily into bins without splitting any variable
+  across two bins. MINIMAL lets variables straddle bin boundaries, which
+  needs the minimal number of bits. DICTIONARY additionally encodes the
+  value of each variable by its index among the values the variable can
+  take in states reachable from the initial state, i.e., its initial value
+  and the values set by operator effects. Variables that are never changed
+  by any operator therefore take no memory. With DICTIONARY, only states
+  reachable from the initial state can be registered.
+*/
+enum class StatePacking {
+    BINS,
+    MINIMAL,
+    DICTIONARY
+};
+
 namespace task_properties {
 
 /**
@@ -72,6 +93,7 @@ std::vector<FactPair> get_fact_pairs(const InputRange<FactProxy> auto& facts)
 
 extern void print_variable_statistics(
     const AbstractPlanningTask& task,
+    StatePacking packing,
     utils::LogProxy& log);
 
 extern void
@@ -82,7 +104,18 @@ dump_fdr(const AbstractPlanningTask& task, const State& state);
 extern void dump_goals(const GoalProxy& goals);
 extern void dump_task(const ClassicalPlanningTask& task);
 
-extern PerTaskInformation<int_packer::IntPacker> g_state_packers;
+// The state packers of a task, one for each StatePacking, created on demand.
+class StatePackers {
+    const AbstractPlanningTask& task;
+    std::array<std::unique_ptr<int_packer::IntPacker>, 3> packers;
+
+public:
+    explicit StatePackers(const AbstractPlanningTask& task);
+
+    const int_packer::IntPacker& operator[](StatePacking packing);
+};
+
+extern PerTaskInformation<StatePackers> g_state_packers;
 
 } // namespace task_properties
 
@@ -1,6 +1,7 @@
 #ifndef UTILS_HASH_H
 #define UTILS_HASH_H
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -298,6 +299,15 @@ void feed(HashState& hash_state, const std::vector<T>& vec)
     }
 }
 
+template <typename T, std::size_t N>
+void feed(HashState& hash_state, const std::array<T, N>& arr)
+{
+    // All arrays of this type have the same size, so we don't feed it.
+    for (const T& item : arr) {
+        feed(hash_state, item);
+    }
+}
+
 template <typename T>
 void feed_iterable(HashState& hash_state, T begin, T end)
 {
@@ -2,21 +2,44 @@
 #define SEARCH_UTILS_H
 
 #include <memory>
+#include <vector>
 
 class ClassicalPlanningTask;
+class OperatorID;
 class Evaluator;
 class SearchAlgorithm;
+class StateStorage;
 
 namespace tests {
 
 /**
- * @brief Creates an A* search engine without log output.
+ * @brief Creates an A* search engine without log output. The states are
+ * stored in \p state_storage, or on the heap if none is given.
  *
  * @ingroup classical_planning_utils
  */
 std::unique_ptr<SearchAlgorithm> create_astar_search_engine(
     std::shared_ptr<ClassicalPlanningTask> task,
-    std::shared_ptr<Evaluator> evaluator);
+    std::shared_ptr<Evaluator> evaluator,
+    std::shared_ptr<StateStorage> state_storage = nullptr);
+
+/**
+ * @brief Returns the cost of an optimal plan, computed with A* and the blind
+ * heuristic. Adds a test failure if A* does not find a plan.
+ *
+ * @ingroup classical_planning_utils
+ */
+int compute_optimal_cost(const std::shared_ptr<ClassicalPlanningTask>& task);
+
+/**
+ * @brief Returns the cost of the plan. Adds a test failure if an operator of
+ * the plan is not applicable or the plan does not end in a goal state.
+ *
+ * @ingroup classical_planning_utils
+ */
+int get_plan_cost(
+    const ClassicalPlanningTask& task,
+    const std::vector<OperatorID>& plan);
 
 }
 
@@ -13,6 +13,7 @@ class ProbabilisticPlanningTask;
 
 namespace tests {
 class ClassicalPlanningDomain;
+class Gripper;
 }
 
 namespace tests {
@@ -28,6 +29,16 @@ std::shared_ptr<ClassicalPlanningTask> create_task_from_domain(
     const std::vector<FactPair>& initial_state,
     std::vector<FactPair> goal);
 
+/**
+ * @brief Creates a gripper task in which the first \p num_balls balls have to
+ * be moved from room 0 to room 1. The robot starts in room 0 with both
+ * grippers free.
+ *
+ * @ingroup classical_planning_utils
+ */
+std::shared_ptr<ClassicalPlanningTask>
+create_gripper_task(const Gripper& domain, int num_balls);
+
 /**
  * @brief Turns a classical planning task into a probabilistic planning task.
  *
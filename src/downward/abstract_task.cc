@@ -41,7 +41,7 @@ State AbstractPlanningTask::create_state(
 }
 
 State AbstractPlanningTask::create_state(
-    const StateRegistry& registry,
+    const StateRegistryBase& registry,
     StateID id,
     const PackedStateBin* buffer) const
 {
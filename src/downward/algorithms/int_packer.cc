@@ -1,6 +1,11 @@
 #include "downward/algorithms/int_packer.h"
 
+#include "downward/utils/system.h"
+
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iostream>
 
 using namespace std;
 
@@ -30,66 +35,212 @@ static int get_bit_size_for_range(int range)
     return num_bits;
 }
 
-class IntPacker::VariableInfo {
-    int range;
-    int bin_index;
-    int shift;
-    PackedStateBin read_mask;
-    PackedStateBin clear_mask;
+static VariableInfo create_variable_info(int range, int bin_index, int shift)
+{
+    int bit_size = get_bit_size_for_range(range);
+    bool straddles = shift + bit_size > BITS_PER_BIN;
+    VariableInfo info;
+    info.range = range;
+    info.bin_index = bin_index;
+    info.high_bin_index = straddles ? bin_index + 1 : bin_index;
+    info.shift = shift;
+    info.read_mask = straddles ? 0 : get_bit_mask(shift, shift + bit_size);
+    info.value_mask = get_bit_mask(0, bit_size);
+    return info;
+}
+
+void exit_with_value_not_in_dictionary(int var, int value)
+{
+    cerr << "Cannot store value " << value << " of variable " << var
+         << " with dictionary state packing." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
 
-public:
-    VariableInfo(int range_, int bin_index_, int shift_)
-        : range(range_)
-        , bin_index(bin_index_)
-        , shift(shift_)
-    {
-        int bit_size = get_bit_size_for_range(range);
-        read_mask = get_bit_mask(shift, shift + bit_size);
-        clear_mask = ~read_mask;
+IntPacker::IntPacker(const vector<int>& ranges, bool allow_straddling)
+    : layout(allow_straddling ? Layout::STRADDLING : Layout::BINS)
+    , num_bins(0)
+{
+    if (allow_straddling) {
+        pack_straddling(ranges);
+    } else {
+        pack_bins(ranges);
+        compute_bin_layout();
     }
+}
 
-    VariableInfo()
-        : bin_index(-1)
-        , shift(0)
-        , read_mask(0)
-        , clear_mask(0)
-    {
-        // Default constructor needed for resize() in pack_bins.
+IntPacker::IntPacker(
+    const vector<int>& ranges,
+    const vector<vector<int>>& possible_values)
+    : layout(Layout::DICTIONARY)
+    , num_bins(0)
+    , code_to_value(possible_values)
+{
+    assert(ranges.size() == possible_values.size());
+    int num_vars = ranges.size();
+    vector<int> code_ranges;
+    code_ranges.reserve(num_vars);
+    value_to_code.resize(num_vars);
+    for (int var = 0; var < num_vars; ++var) {
+        const vector<int>& values = possible_values[var];
+        code_ranges.push_back(values.size());
+        value_to_code[var].assign(ranges[var], -1);
+        for (size_t code = 0; code < values.size(); ++code) {
+            assert(value_to_code[var][values[code]] == -1);
+            value_to_code[var][values[code]] = code;
+        }
     }
+    pack_straddling(code_ranges);
+}
 
-    ~VariableInfo() {}
+IntPacker::~IntPacker()
+{
+}
 
-    int get(const PackedStateBin* buffer) const
-    {
-        return (buffer[bin_index] & read_mask) >> shift;
+bool IntPacker::can_store(int var, int value) const
+{
+    return value_to_code.empty() || value_to_code[var][value] != -1;
+}
+
+void IntPacker::unpack_all(const PackedStateBin* buffer, int* values) const
+{
+    if (layout != Layout::BINS) {
+        // The variables are stored in order, so we can read them in order.
+        visit_layout([&](const auto& vars) {
+            int num_vars = var_infos.size();
+            for (int var = 0; var < num_vars; ++var) {
+                values[var] = vars.get(buffer, var);
+            }
+        });
+        return;
+    }
+    for (int bin = 0; bin < num_bins; ++bin) {
+        PackedStateBin word = buffer[bin];
+        for (int i = bin_field_begin[bin]; i < bin_field_begin[bin + 1]; ++i) {
+            const BinField& field = bin_fields[i];
+            values[field.var] = (word >> field.shift) & field.mask;
+        }
+    }
+    for (int var : zero_bit_vars) {
+        values[var] = 0;
     }
+}
 
-    void set(PackedStateBin* buffer, int value) const
-    {
-        assert(value >= 0 && value < range);
-        PackedStateBin& bin = buffer[bin_index];
-        bin = (bin & clear_mask) | (value << shift);
+template<typename GetCode>
+void IntPacker::pack_in_order(
+    const GetCode& get_code,
+    PackedStateBin* buffer) const
+{
+    /*
+      The STRADDLING and DICTIONARY layouts store the variables (or their
+      codes) in order without gaps. We collect the bits of the current bin
+      and the next one in a 64-bit word and write each bin once. Variables
+      that need no bits are stored at bin 0 with a code of 0, so they do not
+      change the word.
+    */
+    uint64_t word = 0;
+    int bin = 0;
+    int num_vars = var_infos.size();
+    for (int var = 0; var < num_vars; ++var) {
+        const VariableInfo& info = var_infos[var];
+        PackedStateBin code = get_code(var);
+        assert(code <= info.value_mask);
+        if (info.bin_index > bin) {
+            assert(info.bin_index == bin + 1);
+            buffer[bin] = static_cast<PackedStateBin>(word);
+            word >>= BITS_PER_BIN;
+            bin = info.bin_index;
+        }
+        word |= static_cast<uint64_t>(code) << info.shift;
+    }
+    buffer[bin] = static_cast<PackedStateBin>(word);
+    if (bin + 1 < num_bins) {
+        buffer[bin + 1] = static_cast<PackedStateBin>(word >> BITS_PER_BIN);
     }
-};
+}
 
-IntPacker::IntPacker(const vector<int>& ranges)
-    : num_bins(0)
+void IntPacker::pack_all(const int* values, PackedStateBin* buffer) const
 {
-    pack_bins(ranges);
+    if (layout == Layout::STRADDLING) {
+        pack_in_order([&](int var) { return values[var]; }, buffer);
+        return;
+    } else if (layout == Layout::DICTIONARY) {
+        pack_in_order(
+            [&](int var) {
+                int code = value_to_code[var][values[var]];
+                if (code == -1) {
+                    exit_with_value_not_in_dictionary(var, values[var]);
+                }
+                return code;
+            },
+            buffer);
+        return;
+    }
+    for (int bin = 0; bin < num_bins; ++bin) {
+        PackedStateBin word = 0;
+        for (int i = bin_field_begin[bin]; i < bin_field_begin[bin + 1]; ++i) {
+            const BinField& field = bin_fields[i];
+            PackedStateBin value = values[field.var];
+            assert(value <= field.mask);
+            word |= value << field.shift;
+        }
+        buffer[bin] = word;
+    }
 }
 
-IntPacker::~IntPacker()
+bool IntPacker::equal(
+    const PackedStateBin* lhs,
+    const PackedStateBin* rhs) const
 {
+    return std::equal(lhs, lhs + num_bins, rhs);
 }
 
-int IntPacker::get(const PackedStateBin* buffer, int var) const
+void IntPacker::compute_bin_layout()
 {
-    return var_infos[var].get(buffer);
+    int num_vars = var_infos.size();
+    vector<vector<BinField>> fields_by_bin(num_bins);
+    for (int var = 0; var < num_vars; ++var) {
+        const VariableInfo& info = var_infos[var];
+        if (info.value_mask == 0) {
+            zero_bit_vars.push_back(var);
+        } else {
+            assert(info.high_bin_index == info.bin_index);
+            fields_by_bin[info.bin_index].push_back(
+                {var, info.shift, info.value_mask});
+        }
+    }
+    bin_field_begin.push_back(0);
+    for (const vector<BinField>& fields : fields_by_bin) {
+        bin_fields.insert(bin_fields.end(), fields.begin(), fields.end());
+        bin_field_begin.push_back(bin_fields.size());
+    }
 }
 
-void IntPacker::set(PackedStateBin* buffer, int var, int value) const
+void IntPacker::pack_straddling(const vector<int>& ranges)
 {
-    var_infos[var].set(buffer, value);
+    assert(var_infos.empty());
+
+    /*
+      Lay out the variables in order without gaps. Variables that need no
+      bits all share bit 0 of bin 0 (with an empty mask). We always use at
+      least one bin, so that these variables can be read.
+    */
+    int num_vars = ranges.size();
+    var_infos.reserve(num_vars);
+    int64_t used_bits = 0;
+    for (int var = 0; var < num_vars; ++var) {
+        int bits = get_bit_size_for_range(ranges[var]);
+        assert(bits <= BITS_PER_BIN);
+        if (bits == 0) {
+            var_infos.push_back(create_variable_info(ranges[var], 0, 0));
+        } else {
+            var_infos.push_back(create_variable_info(
+                ranges[var],
+                used_bits / BITS_PER_BIN,
+                used_bits % BITS_PER_BIN));
+            used_bits += bits;
+        }
+    }
+    num_bins = max<int64_t>(1, (used_bits + BITS_PER_BIN - 1) / BITS_PER_BIN);
 }
 
 void IntPacker::pack_bins(const vector<int>& ranges)
@@ -114,7 +265,7 @@ void IntPacker::pack_bins(const vector<int>& ranges)
     int packed_vars = bits_to_vars[0].size();
 
     for (int var : bits_to_vars[0]) {
-        var_infos[var] = VariableInfo(ranges[var], 0, 0);
+        var_infos[var] = create_variable_info(ranges[var], 0, 0);
     }
 
     bits_to_vars[0].clear();
@@ -153,7 +304,8 @@ int IntPacker::pack_one_bin(
         int var = best_fit_vars.back();
         best_fit_vars.pop_back();
 
-        var_infos[var] = VariableInfo(ranges[var], bin_index, used_bits);
+        var_infos[var] =
+            create_variable_info(ranges[var], bin_index, used_bits);
         used_bits += bits;
         ++num_vars_in_bin;
     }
@@ -80,7 +80,44 @@ CachedHeuristic::compute_result(EvaluationContext& eval_context)
 std::vector<EvaluationResult>
 CachedHeuristic::compute_results(std::vector<EvaluationContext>& eval_contexts)
 {
-    return child->compute_results(eval_contexts);
+    /*
+      Only pass the states without a clean cache entry to the child, so that
+      it can evaluate them in one batch.
+    */
+    vector<EvaluationContext> uncached_contexts;
+    vector<size_t> uncached_indices;
+    for (size_t i = 0; i < eval_contexts.size(); ++i) {
+        const HEntry& entry = heuristic_cache[eval_contexts[i].get_state()];
+        if (entry.h == NO_VALUE || entry.dirty) {
+            uncached_contexts.push_back(eval_contexts[i]);
+            uncached_indices.push_back(i);
+        }
+    }
+    vector<EvaluationResult> child_results;
+    if (!uncached_contexts.empty()) {
+        child_results = child->compute_results(uncached_contexts);
+    }
+
+    vector<EvaluationResult> results(eval_contexts.size());
+    for (size_t j = 0; j < uncached_indices.size(); ++j) {
+        EvaluationResult& result = child_results[j];
+        int heuristic = result.is_infinite() ? DEAD_END
+                                             : result.get_evaluator_value();
+        heuristic_cache[eval_contexts[uncached_indices[j]].get_state()] =
+            HEntry(heuristic, false);
+        results[uncached_indices[j]] = result;
+    }
+    for (size_t i = 0; i < eval_contexts.size(); ++i) {
+        EvaluationResult& result = results[i];
+        if (result.is_uninitialized()) {
+            int heuristic =
+                heuristic_cache[eval_contexts[i].get_state()].h;
+            result.set_evaluator_value(
+                heuristic == DEAD_END ? EvaluationResult::INFTY : heuristic);
+            result.set_count_evaluation(false);
+        }
+    }
+    return results;
 }
 
 const std::string& CachedHeuristic::get_description() const
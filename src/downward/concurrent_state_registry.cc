@@ -0,0 +1,247 @@
+#include "downward/concurrent_state_registry.h"
+
+#include "downward/task_proxy.h"
+
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+/*
+  Each shard claims blocks of this many states. Together with the limit on
+  the number of IDs, this determines the size of the block directory.
+*/
+static const int STATES_PER_BLOCK = 1 << 14;
+
+struct ConcurrentStateRegistry::Shard {
+    struct StateIDSemanticHash {
+        const ConcurrentStateRegistry& registry;
+        int state_size;
+        StateIDSemanticHash(
+            const ConcurrentStateRegistry& registry,
+            int state_size)
+            : registry(registry)
+            , state_size(state_size)
+        {
+        }
+
+        int_hash_set::HashType operator()(int id) const
+        {
+            const PackedStateBin* data = registry.get_state_data(id);
+            utils::HashState hash_state;
+            for (int i = 0; i < state_size; ++i) {
+                hash_state.feed(data[i]);
+            }
+            return hash_state.get_hash32();
+        }
+    };
+
+    struct StateIDSemanticEqual {
+        const ConcurrentStateRegistry& registry;
+        int state_size;
+        StateIDSemanticEqual(
+            const ConcurrentStateRegistry& registry,
+            int state_size)
+            : registry(registry)
+            , state_size(state_size)
+        {
+        }
+
+        bool operator()(int lhs, int rhs) const
+        {
+            const PackedStateBin* lhs_data = registry.get_state_data(lhs);
+            const PackedStateBin* rhs_data = registry.get_state_data(rhs);
+            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+        }
+    };
+
+    using StateIDSet =
+        int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+
+    mutex shard_mutex;
+    StateIDSet registered_states;
+
+    // Block the shard currently appends to and the number of slots used.
+    PackedStateBin* block;
+    int block_id;
+    int num_used_slots;
+
+    // Copy of registered_states.size() that can be read without the lock.
+    atomic<int> num_states;
+
+    Shard(const ConcurrentStateRegistry& registry, int state_size)
+        : registered_states(
+              StateIDSemanticHash(registry, state_size),
+              StateIDSemanticEqual(registry, state_size))
+        , block(nullptr)
+        , block_id(-1)
+        , num_used_slots(STATES_PER_BLOCK)
+        , num_states(0)
+    {
+    }
+};
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const AbstractPlanningTask& task,
+    int num_shards,
+    StatePacking state_packing)
+    : StateRegistryBase(task, state_packing)
+    , blocks(numeric_limits<int>::max() / STATES_PER_BLOCK)
+    , num_blocks(0)
+{
+    assert(num_shards >= 1);
+    for (int i = 0; i < num_shards; ++i) {
+        shards.push_back(make_unique<Shard>(*this, get_bins_per_state()));
+    }
+}
+
+ConcurrentStateRegistry::~ConcurrentStateRegistry()
+{
+    for (int i = 0; i < num_blocks; ++i) {
+        delete[] blocks[i].load(memory_order_relaxed);
+    }
+}
+
+const PackedStateBin* ConcurrentStateRegistry::get_state_data(int id) const
+{
+    const PackedStateBin* block =
+        blocks[id / STATES_PER_BLOCK].load(memory_order_acquire);
+    assert(block);
+    return block + (id % STATES_PER_BLOCK) * get_bins_per_state();
+}
+
+PackedStateBin* ConcurrentStateRegistry::allocate_block(int& block_id)
+{
+    lock_guard<mutex> lock(block_allocation_mutex);
+    if (num_blocks == static_cast<int>(blocks.size())) {
+        cerr << "Ran out of state IDs in the concurrent state registry."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    PackedStateBin* block =
+        new PackedStateBin[STATES_PER_BLOCK * get_bins_per_state()];
+    block_id = num_blocks++;
+    blocks[block_id].store(block, memory_order_release);
+    state_id_bound.store(
+        static_cast<size_t>(num_blocks) * STATES_PER_BLOCK,
+        memory_order_relaxed);
+    return block;
+}
+
+StateID ConcurrentStateRegistry::insert(const PackedStateBin* buffer)
+{
+    int num_bins = get_bins_per_state();
+    utils::HashState hash_state;
+    for (int i = 0; i < num_bins; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    /*
+      The lower 32 bits are the hash the shard hash sets compute for the
+      state, so we use the upper ones to select the shard.
+    */
+    uint64_t hash = hash_state.get_hash64();
+    int_hash_set::HashType set_hash = static_cast<uint32_t>(hash);
+    Shard& shard = *shards[(hash >> 32) % shards.size()];
+
+    lock_guard<mutex> lock(shard.shard_mutex);
+    int existing_id = shard.registered_states.find(set_hash, [&](int id) {
+        const PackedStateBin* data = get_state_data(id);
+        return equal(data, data + num_bins, buffer);
+    });
+    if (existing_id != -1) {
+        return StateID(existing_id);
+    }
+
+    if (shard.num_used_slots == STATES_PER_BLOCK) {
+        shard.block = allocate_block(shard.block_id);
+        shard.num_used_slots = 0;
+    }
+    copy_n(buffer, num_bins, shard.block + shard.num_used_slots * num_bins);
+    int id = shard.block_id * STATES_PER_BLOCK + shard.num_used_slots;
+    ++shard.num_used_slots;
+    shard.registered_states.insert_with_hash(id, set_hash);
+    shard.num_states.store(
+        shard.registered_states.size(),
+        memory_order_relaxed);
+    return StateID(id);
+}
+
+State ConcurrentStateRegistry::lookup_state(StateID id) const
+{
+    return task.create_state(*this, id, get_state_data(id.value));
+}
+
+const State& ConcurrentStateRegistry::get_initial_state()
+{
+    call_once(initial_state_flag, [this]() {
+        vector<PackedStateBin> buffer(get_bins_per_state());
+        State initial_state = task.get_initial_state();
+        initial_state.unpack();
+        state_packer.pack_all(
+            initial_state.get_unpacked_values().data(),
+            buffer.data());
+        StateID id = insert(buffer.data());
+        cached_initial_state = make_unique<State>(lookup_state(id));
+    });
+    return *cached_initial_state;
+}
+
+State ConcurrentStateRegistry::insert_state(vector<int>&& state)
+{
+    assert(static_cast<int>(state.size()) == num_variables);
+    vector<PackedStateBin> buffer(get_bins_per_state());
+    state_packer.pack_all(state.data(), buffer.data());
+    return lookup_state(insert(buffer.data()));
+}
+
+State ConcurrentStateRegistry::insert_packed_state(const PackedStateBin* buffer)
+{
+    return lookup_state(insert(buffer));
+}
+
+State ConcurrentStateRegistry::get_successor_state(
+    const State& predecessor,
+    const OperatorProxy& op)
+{
+    /*
+      We need the successor's data to select its shard before we can write it
+      to the shard's block, so we compute it in a scratch buffer first. The
+      buffer is reused to avoid allocating memory for every successor.
+    */
+    thread_local vector<PackedStateBin> buffer;
+    const PackedStateBin* predecessor_data = predecessor.get_buffer();
+    buffer.assign(predecessor_data, predecessor_data + get_bins_per_state());
+    state_packer.visit_layout([&](const auto& vars) {
+        if (flat_operators) {
+            for (FactPair effect : flat_operators->get_effects(op.get_id())) {
+                vars.set(buffer.data(), effect.var, effect.value);
+            }
+        } else {
+            for (FactProxy effect : op.get_effects()) {
+                FactPair effect_pair = effect.get_pair();
+                vars.set(buffer.data(), effect_pair.var, effect_pair.value);
+            }
+        }
+    });
+    return lookup_state(insert(buffer.data()));
+}
+
+size_t ConcurrentStateRegistry::size() const
+{
+    size_t num_states = 0;
+    for (const unique_ptr<Shard>& shard : shards) {
+        num_states += shard->num_states.load(memory_order_relaxed);
+    }
+    return num_states;
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy& log) const
+{
+    log << "Number of registered states: " << size() << endl;
+    log << "Number of state registry shards: " << shards.size() << endl;
+}
@@ -88,3 +88,43 @@ int EvaluationContext::get_evaluator_value_or_infinity(Evaluator* eval)
 {
     return get_result(eval).get_evaluator_value();
 }
+
+void EvaluationContext::compute_results(
+    Evaluator* eval,
+    vector<EvaluationContext>& eval_contexts)
+{
+    vector<EvaluationContext> uncached_contexts;
+    vector<size_t> uncached_indices;
+    for (size_t i = 0; i < eval_contexts.size(); ++i) {
+        if (eval_contexts[i].cache[eval].is_uninitialized()) {
+            uncached_indices.push_back(i);
+        }
+    }
+    if (uncached_indices.empty()) return;
+
+    // Usually, no context has a result yet and we can avoid copying them.
+    bool evaluate_all = uncached_indices.size() == eval_contexts.size();
+    if (!evaluate_all) {
+        for (size_t i : uncached_indices) {
+            uncached_contexts.push_back(eval_contexts[i]);
+        }
+    }
+    vector<EvaluationResult> results = eval->compute_results(
+        evaluate_all ? eval_contexts : uncached_contexts);
+    assert(results.size() == uncached_indices.size());
+
+    for (size_t j = 0; j < uncached_indices.size(); ++j) {
+        EvaluationContext& eval_context = eval_contexts[uncached_indices[j]];
+        if (!evaluate_all) {
+            // Keep the results of subevaluators computed on the copy.
+            eval_context.cache = uncached_contexts[j].cache;
+        }
+        const EvaluationResult& result = results[j];
+        eval_context.cache[eval] = result;
+        if (eval_context.statistics &&
+            eval->is_used_for_counting_evaluations() &&
+            result.get_count_evaluation()) {
+            eval_context.statistics->inc_evaluations();
+        }
+    }
+}
@@ -0,0 +1,344 @@
+#include "downward/open_lists/bucket_open_list.h"
+
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+#include "downward/open_list.h"
+
+#include "downward/open_lists/open_list_buckets.h"
+
+#include "downward/plugins/plugin.h"
+#include "downward/utils/collections.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+template <class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    /*
+      Same criterion as in BucketQueue: switch to the heap once a key
+      exceeds both this value and the number of pushes so far.
+    */
+    static const int MIN_BUCKETS_BEFORE_SWITCH = 100;
+
+    using Bucket = open_list_buckets::FifoBucket<Entry>;
+
+    // All entries with the same primary key, indexed by the secondary key.
+    struct Layer {
+        vector<Bucket> buckets;
+        int min_key = 0;
+        int size = 0;
+    };
+
+    struct HeapEntry {
+        int primary;
+        int secondary;
+        long long id;
+        Entry entry;
+
+        bool operator>(const HeapEntry& other) const
+        {
+            if (primary != other.primary) return primary > other.primary;
+            if (secondary != other.secondary)
+                return secondary > other.secondary;
+            return id > other.id;
+        }
+    };
+
+    vector<Layer> layers;
+    int min_key;
+    /*
+      Once the keys become too sparse, all entries live in this heap.
+      Entries with equal keys are ordered by insertion number to preserve
+      the FIFO order of the buckets.
+    */
+    bool use_heap;
+    vector<HeapEntry> heap;
+    long long num_pushes;
+    int size;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+    bool is_too_sparse(int key) const;
+    void switch_to_heap();
+    void push_heap_entry(int primary, int secondary, const Entry& entry);
+
+protected:
+    virtual void
+    do_insertion(EvaluationContext& eval_context, const Entry& entry) override;
+
+public:
+    BucketOpenList(
+        const vector<shared_ptr<Evaluator>>& evals,
+        bool unsafe_pruning);
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator*>& evals) override;
+    virtual bool is_dead_end(EvaluationContext& eval_context) const override;
+    virtual bool
+    is_reliable_dead_end(EvaluationContext& eval_context) const override;
+};
+
+template <class Entry>
+BucketOpenList<Entry>::BucketOpenList(
+    const vector<shared_ptr<Evaluator>>& evals,
+    bool unsafe_pruning)
+    : min_key(0)
+    , use_heap(false)
+    , num_pushes(0)
+    , size(0)
+    , evaluators(evals)
+    , allow_unsafe_pruning(unsafe_pruning)
+{
+    assert(evaluators.size() == 1 || evaluators.size() == 2);
+}
+
+template <class Entry>
+bool BucketOpenList<Entry>::is_too_sparse(int key) const
+{
+    return key < 0 || key == EvaluationResult::INFTY ||
+           (key >= MIN_BUCKETS_BEFORE_SWITCH && key > num_pushes);
+}
+
+template <class Entry>
+void BucketOpenList<Entry>::push_heap_entry(
+    int primary,
+    int secondary,
+    const Entry& entry)
+{
+    heap.push_back(HeapEntry{primary, secondary, num_pushes, entry});
+    push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+}
+
+template <class Entry>
+void BucketOpenList<Entry>::switch_to_heap()
+{
+    /*
+      Moving the entries in bucket order yields a sorted vector, which is
+      a valid heap.
+    */
+    assert(heap.empty());
+    heap.reserve(size);
+    long long id = 0;
+    for (int primary = min_key; primary < static_cast<int>(layers.size());
+         ++primary) {
+        Layer& layer = layers[primary];
+        for (int secondary = layer.min_key;
+             secondary < static_cast<int>(layer.buckets.size());
+             ++secondary) {
+            for (const Entry& entry : layer.buckets[secondary]) {
+                heap.push_back(HeapEntry{primary, secondary, id++, entry});
+            }
+        }
+    }
+    assert(static_cast<int>(heap.size()) == size);
+    utils::release_vector_memory(layers);
+    min_key = 0;
+    use_heap = true;
+}
+
+template <class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext& eval_context,
+    const Entry& entry)
+{
+    int primary =
+        eval_context.get_evaluator_value_or_infinity(evaluators[0].get());
+    int secondary = 0;
+    if (evaluators.size() == 2) {
+        secondary =
+            eval_context.get_evaluator_value_or_infinity(evaluators[1].get());
+    }
+    if (!use_heap && (is_too_sparse(primary) || is_too_sparse(secondary))) {
+        switch_to_heap();
+    }
+    ++num_pushes;
+    ++size;
+    if (use_heap) {
+        push_heap_entry(primary, secondary, entry);
+        return;
+    }
+
+    if (primary >= static_cast<int>(layers.size())) {
+        layers.resize(primary + 1);
+    }
+    if (primary < min_key || size == 1) {
+        min_key = primary;
+    }
+    Layer& layer = layers[primary];
+    if (secondary >= static_cast<int>(layer.buckets.size())) {
+        layer.buckets.resize(secondary + 1);
+    }
+    if (secondary < layer.min_key || layer.size == 0) {
+        layer.min_key = secondary;
+    }
+    layer.buckets[secondary].push(entry);
+    ++layer.size;
+}
+
+template <class Entry>
+Entry BucketOpenList<Entry>::remove_min()
+{
+    assert(size > 0);
+    --size;
+    if (use_heap) {
+        pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        Entry result = heap.back().entry;
+        heap.pop_back();
+        return result;
+    }
+
+    // The cursors only move forward until a smaller key is inserted.
+    while (layers[min_key].size == 0) {
+        ++min_key;
+        assert(min_key < static_cast<int>(layers.size()));
+    }
+    Layer& layer = layers[min_key];
+    while (layer.buckets[layer.min_key].empty()) {
+        ++layer.min_key;
+        assert(layer.min_key < static_cast<int>(layer.buckets.size()));
+    }
+    --layer.size;
+    Bucket& bucket = layer.buckets[layer.min_key];
+    Entry result = bucket.pop();
+    /*
+      Keys below the cursors are only used again if a smaller key is
+      inserted, so we release the memory of buckets and layers that run
+      empty. Otherwise, the memory of all layers that were ever used
+      would stay allocated until the end of the search.
+    */
+    if (layer.size == 0) {
+        utils::release_vector_memory(layer.buckets);
+    } else if (bucket.empty()) {
+        bucket.release_memory();
+    }
+    return result;
+}
+
+template <class Entry>
+bool BucketOpenList<Entry>::empty() const
+{
+    return size == 0;
+}
+
+template <class Entry>
+void BucketOpenList<Entry>::clear()
+{
+    layers.clear();
+    min_key = 0;
+    use_heap = false;
+    heap.clear();
+    num_pushes = 0;
+    size = 0;
+}
+
+template <class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator*>& evals)
+{
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template <class Entry>
+bool BucketOpenList<Entry>::is_dead_end(EvaluationContext& eval_context) const
+{
+    // Same semantics as in the tie-breaking open list.
+    if (is_reliable_dead_end(eval_context)) return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template <class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext& eval_context) const
+{
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(
+    const vector<shared_ptr<Evaluator>>& evals,
+    bool unsafe_pruning)
+    : evals(evals)
+    , unsafe_pruning(unsafe_pruning)
+{
+}
+
+unique_ptr<StateOpenList> BucketOpenListFactory::create_state_open_list()
+{
+    return std::make_unique<BucketOpenList<StateOpenListEntry>>(
+        evals,
+        unsafe_pruning);
+}
+
+unique_ptr<EdgeOpenList> BucketOpenListFactory::create_edge_open_list()
+{
+    return std::make_unique<BucketOpenList<EdgeOpenListEntry>>(
+        evals,
+        unsafe_pruning);
+}
+
+class BucketOpenListFeature
+    : public plugins::TypedFeature<OpenListFactory, BucketOpenListFactory> {
+public:
+    BucketOpenListFeature()
+        : TypedFeature("bucket")
+    {
+        document_title("Bucket open list");
+        document_synopsis(
+            "Orders entries like the tie-breaking open list, but stores them "
+            "in a dense array of buckets indexed by the evaluator values. "
+            "Supports one or two evaluators, e.g. [f, h] for A*. If the "
+            "values are negative, infinite or too sparse, the open list "
+            "switches to a heap.");
+
+        add_list_option<shared_ptr<Evaluator>>("evals", "evaluators");
+        add_option<bool>(
+            "unsafe_pruning",
+            "allow unsafe pruning when the main evaluator regards a state a "
+            "dead end",
+            "true");
+        add_open_list_options_to_feature(*this);
+    }
+
+    virtual shared_ptr<BucketOpenListFactory> create_component(
+        const plugins::Options& opts,
+        const utils::Context& context) const override
+    {
+        plugins::verify_list_non_empty<shared_ptr<Evaluator>>(
+            context,
+            opts,
+            "evals");
+        if (opts.get_list<shared_ptr<Evaluator>>("evals").size() > 2) {
+            context.error("The bucket open list supports at most two "
+                          "evaluators.");
+        }
+        return plugins::make_shared_from_arg_tuples<BucketOpenListFactory>(
+            opts.get_list<shared_ptr<Evaluator>>("evals"),
+            opts.get<bool>("unsafe_pruning"),
+            get_open_list_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<BucketOpenListFeature> _plugin;
+} // namespace bucket_open_list
@@ -0,0 +1,342 @@
+#include "downward/open_lists/multi_queue_open_list.h"
+
+#include "downward/evaluator.h"
+#include "downward/open_list.h"
+
+#include "downward/plugins/plugin.h"
+#include "downward/utils/collections.h"
+#include "downward/utils/rng.h"
+#include "downward/utils/rng_options.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace multi_queue_open_list {
+/*
+  Each entry has a token that tells whether it is in the open list: the
+  state ID for state entries, and the insertion ID for edge entries, which
+  are never merged.
+*/
+static int get_token(StateOpenListEntry entry, int)
+{
+    return entry.get_value();
+}
+
+static int get_token(const EdgeOpenListEntry&, int id)
+{
+    return id;
+}
+
+template <class Entry>
+class MultiQueueOpenList : public OpenList<Entry> {
+    struct HeapNode {
+        int key;
+        // Insertion ID, for FIFO order among equal keys.
+        int id;
+        Entry entry;
+
+        bool operator>(const HeapNode& other) const
+        {
+            return make_pair(key, id) > make_pair(other.key, other.id);
+        }
+    };
+
+    shared_ptr<utils::RandomNumberGenerator> rng;
+    vector<shared_ptr<Evaluator>> evaluators;
+    double epsilon;
+
+    struct Queue {
+        vector<HeapNode> heap;
+        // Stale nodes are dropped when the heap grows beyond this size.
+        size_t compaction_size = 0;
+    };
+
+    vector<Queue> queues;
+    // Number of removals from each queue, used for alternating.
+    vector<int> priorities;
+    // Nodes whose token is not in the open list are stale.
+    vector<bool> in_open_list;
+    int size;
+    int next_id;
+
+    bool is_stale(const HeapNode& node) const;
+    void drop_stale_nodes(Queue& queue);
+    optional<Entry> try_remove_from_queue(int queue_id);
+
+protected:
+    virtual void
+    do_insertion(EvaluationContext& eval_context, const Entry& entry) override;
+
+public:
+    MultiQueueOpenList(
+        const vector<shared_ptr<Evaluator>>& evals,
+        double epsilon,
+        int random_seed);
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator*>& evals) override;
+    virtual bool is_dead_end(EvaluationContext& eval_context) const override;
+    virtual bool
+    is_reliable_dead_end(EvaluationContext& eval_context) const override;
+};
+
+template <class HeapNode>
+static void adjust_heap_up(vector<HeapNode>& heap, size_t pos)
+{
+    assert(utils::in_bounds(pos, heap));
+    while (pos != 0) {
+        size_t parent_pos = (pos - 1) / 2;
+        if (heap[pos] > heap[parent_pos]) {
+            break;
+        }
+        swap(heap[pos], heap[parent_pos]);
+        pos = parent_pos;
+    }
+}
+
+template <class Entry>
+MultiQueueOpenList<Entry>::MultiQueueOpenList(
+    const vector<shared_ptr<Evaluator>>& evals,
+    double epsilon,
+    int random_seed)
+    : rng(utils::get_rng(random_seed))
+    , evaluators(evals)
+    , epsilon(epsilon)
+    , queues(evals.size())
+    , priorities(evals.size(), 0)
+    , size(0)
+    , next_id(0)
+{
+    assert(!evaluators.empty());
+}
+
+template <class Entry>
+bool MultiQueueOpenList<Entry>::is_stale(const HeapNode& node) const
+{
+    return !in_open_list[get_token(node.entry, node.id)];
+}
+
+template <class Entry>
+void MultiQueueOpenList<Entry>::drop_stale_nodes(Queue& queue)
+{
+    vector<HeapNode>& heap = queue.heap;
+    erase_if(heap, [this](const HeapNode& node) { return is_stale(node); });
+    make_heap(heap.begin(), heap.end(), greater<HeapNode>());
+    /*
+      Live nodes of the same state may remain, so we only compact again
+      when the heap has doubled. This takes amortized constant time per
+      insertion.
+    */
+    queue.compaction_size = 2 * heap.size();
+}
+
+template <class Entry>
+void MultiQueueOpenList<Entry>::do_insertion(
+    EvaluationContext& eval_context,
+    const Entry& entry)
+{
+    int id = next_id++;
+    int token = get_token(entry, id);
+    if (token >= static_cast<int>(in_open_list.size())) {
+        in_open_list.resize(token + 1, false);
+    }
+    if (!in_open_list[token]) {
+        in_open_list[token] = true;
+        ++size;
+    }
+    for (size_t i = 0; i < evaluators.size(); ++i) {
+        int key = eval_context.get_evaluator_value_or_infinity(
+            evaluators[i].get());
+        if (key == EvaluationResult::INFTY) continue;
+        vector<HeapNode>& heap = queues[i].heap;
+        heap.push_back(HeapNode{key, id, entry});
+        push_heap(heap.begin(), heap.end(), greater<HeapNode>());
+    }
+}
+
+/*
+  Remove and return the next live entry of the queue, or return nothing if
+  the queue only contains stale nodes. Stale nodes that are chosen are
+  dropped.
+*/
+template <class Entry>
+optional<Entry> MultiQueueOpenList<Entry>::try_remove_from_queue(int queue_id)
+{
+    Queue& queue = queues[queue_id];
+    vector<HeapNode>& heap = queue.heap;
+    // Drop stale nodes when the heap holds more than two nodes per entry.
+    if (heap.size() > 2 * static_cast<size_t>(size) &&
+        heap.size() > queue.compaction_size) {
+        drop_stale_nodes(queue);
+    }
+    while (!heap.empty()) {
+        if (epsilon > 0 && rng->random() < epsilon) {
+            int pos = rng->random(heap.size());
+            heap[pos].key = numeric_limits<int>::min();
+            adjust_heap_up(heap, pos);
+        }
+        pop_heap(heap.begin(), heap.end(), greater<HeapNode>());
+        HeapNode node = heap.back();
+        heap.pop_back();
+        if (!is_stale(node)) {
+            // Invalidate all other nodes of the entry.
+            in_open_list[get_token(node.entry, node.id)] = false;
+            --size;
+            return node.entry;
+        }
+    }
+    return nullopt;
+}
+
+template <class Entry>
+Entry MultiQueueOpenList<Entry>::remove_min()
+{
+    assert(size > 0);
+    while (true) {
+        int best = -1;
+        for (size_t i = 0; i < queues.size(); ++i) {
+            if (!queues[i].heap.empty() &&
+                (best == -1 || priorities[i] < priorities[best])) {
+                best = i;
+            }
+        }
+        assert(best != -1);
+        optional<Entry> entry = try_remove_from_queue(best);
+        if (entry) {
+            ++priorities[best];
+            return *entry;
+        }
+    }
+}
+
+template <class Entry>
+bool MultiQueueOpenList<Entry>::empty() const
+{
+    return size == 0;
+}
+
+template <class Entry>
+void MultiQueueOpenList<Entry>::clear()
+{
+    for (Queue& queue : queues) {
+        queue.heap.clear();
+        queue.compaction_size = 0;
+    }
+    in_open_list.clear();
+    size = 0;
+    next_id = 0;
+}
+
+template <class Entry>
+void MultiQueueOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator*>& evals)
+{
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template <class Entry>
+bool MultiQueueOpenList<Entry>::is_dead_end(
+    EvaluationContext& eval_context) const
+{
+    // If one evaluator is sure we have a dead end, return true.
+    if (is_reliable_dead_end(eval_context)) return true;
+    // Otherwise, return true if all evaluators agree this is a dead-end.
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template <class Entry>
+bool MultiQueueOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext& eval_context) const
+{
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+MultiQueueOpenListFactory::MultiQueueOpenListFactory(
+    const vector<shared_ptr<Evaluator>>& evals,
+    double epsilon,
+    int random_seed)
+    : evals(evals)
+    , epsilon(epsilon)
+    , random_seed(random_seed)
+{
+}
+
+unique_ptr<StateOpenList> MultiQueueOpenListFactory::create_state_open_list()
+{
+    return std::make_unique<MultiQueueOpenList<StateOpenListEntry>>(
+        evals,
+        epsilon,
+        random_seed);
+}
+
+unique_ptr<EdgeOpenList> MultiQueueOpenListFactory::create_edge_open_list()
+{
+    return std::make_unique<MultiQueueOpenList<EdgeOpenListEntry>>(
+        evals,
+        epsilon,
+        random_seed);
+}
+
+class MultiQueueOpenListFeature
+    : public plugins::
+          TypedFeature<OpenListFactory, MultiQueueOpenListFactory> {
+public:
+    MultiQueueOpenListFeature()
+        : TypedFeature("multi_queue")
+    {
+        document_title("Multi-queue open list");
+        document_synopsis(
+            "Alternates between one queue per evaluator. Each queue returns "
+            "its minimum entry, or with probability 'epsilon' a uniformly "
+            "random entry. Unlike the alternation open list, every entry is "
+            "returned by only one queue, and a state that is inserted again "
+            "while it is open is returned only once.");
+
+        add_list_option<shared_ptr<Evaluator>>(
+            "evals",
+            "evaluators, one queue per evaluator");
+        add_option<double>(
+            "epsilon",
+            "probability for choosing the next entry of a queue randomly",
+            "0.0",
+            plugins::Bounds("0.0", "1.0"));
+        utils::add_rng_options_to_feature(*this);
+        add_open_list_options_to_feature(*this);
+    }
+
+    virtual shared_ptr<MultiQueueOpenListFactory> create_component(
+        const plugins::Options& opts,
+        const utils::Context& context) const override
+    {
+        plugins::verify_list_non_empty<shared_ptr<Evaluator>>(
+            context,
+            opts,
+            "evals");
+        return plugins::make_shared_from_arg_tuples<MultiQueueOpenListFactory>(
+            opts.get_list<shared_ptr<Evaluator>>("evals"),
+            opts.get<double>("epsilon"),
+            utils::get_rng_arguments_from_options(opts),
+            get_open_list_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<MultiQueueOpenListFeature> _plugin;
+} // namespace multi_queue_open_list
@@ -3,6 +3,8 @@
 #include "downward/evaluator.h"
 #include "downward/open_list.h"
 
+#include "downward/open_lists/open_list_buckets.h"
+
 #include "downward/plugins/plugin.h"
 #include "downward/utils/hash.h"
 #include "downward/utils/memory.h"
@@ -10,7 +12,6 @@
 #include "downward/utils/rng_options.h"
 
 #include <cassert>
-#include <deque>
 #include <set>
 #include <unordered_map>
 #include <utility>
@@ -19,19 +20,22 @@
 using namespace std;
 
 namespace pareto_open_list {
-template <class Entry>
+template <class Entry, class Key>
 class ParetoOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
 
-    using Bucket = deque<Entry>;
-    using KeyType = vector<int>;
-    using BucketMap = utils::HashMap<KeyType, Bucket>;
+    using KeyType = Key;
+    // Maps keys to buckets in the pool.
+    using BucketMap = utils::HashMap<KeyType, int>;
     using KeySet = set<KeyType>;
 
     BucketMap buckets;
+    open_list_buckets::BucketPool<Entry> bucket_pool;
     KeySet nondominated;
     bool state_uniform_selection;
     vector<shared_ptr<Evaluator>> evaluators;
+    // Reused for all insertions to avoid allocating keys.
+    KeyType key_buffer;
 
     bool dominates(const KeyType& v1, const KeyType& v2) const;
     bool
@@ -57,8 +61,8 @@ public:
     is_reliable_dead_end(EvaluationContext& eval_context) const override;
 };
 
-template <class Entry>
-ParetoOpenList<Entry>::ParetoOpenList(
+template <class Entry, class Key>
+ParetoOpenList<Entry, Key>::ParetoOpenList(
     const vector<shared_ptr<Evaluator>>& evals,
     bool state_uniform_selection,
     int random_seed)
@@ -66,10 +70,11 @@ ParetoOpenList<Entry>::ParetoOpenList(
     , state_uniform_selection(state_uniform_selection)
     , evaluators(evals)
 {
+    open_list_buckets::resize_key(key_buffer, evaluators.size());
 }
 
-template <class Entry>
-bool ParetoOpenList<Entry>::dominates(const KeyType& v1, const KeyType& v2)
+template <class Entry, class Key>
+bool ParetoOpenList<Entry, Key>::dominates(const KeyType& v1, const KeyType& v2)
     const
 {
     assert(v1.size() == v2.size());
@@ -83,8 +88,8 @@ bool ParetoOpenList<Entry>::dominates(const KeyType& v1, const KeyType& v2)
     return are_different;
 }
 
-template <class Entry>
-bool ParetoOpenList<Entry>::is_nondominated(
+template <class Entry, class Key>
+bool ParetoOpenList<Entry, Key>::is_nondominated(
     const KeyType& vec,
     KeySet& domination_candidates) const
 {
@@ -93,17 +98,19 @@ bool ParetoOpenList<Entry>::is_nondominated(
     return true;
 }
 
-template <class Entry>
-void ParetoOpenList<Entry>::remove_key(const KeyType& key)
+template <class Entry, class Key>
+void ParetoOpenList<Entry, Key>::remove_key(const KeyType& key)
 {
     /*
       We must copy the key because it is likely to live inside the
       data structures from which we remove it here and hence becomes
       invalid at that point.
     */
-    vector<int> copied_key(key);
+    KeyType copied_key(key);
     nondominated.erase(copied_key);
-    buckets.erase(copied_key);
+    auto it = buckets.find(copied_key);
+    bucket_pool.release(it->second);
+    buckets.erase(it);
     KeySet candidates;
     for (const auto& bucket_pair : buckets) {
         const KeyType& bucket_key = bucket_pair.first;
@@ -124,22 +131,20 @@ void ParetoOpenList<Entry>::remove_key(const KeyType& key)
             nondominated.insert(candidate);
 }
 
-template <class Entry>
-void ParetoOpenList<Entry>::do_insertion(
+template <class Entry, class Key>
+void ParetoOpenList<Entry, Key>::do_insertion(
     EvaluationContext& eval_context,
     const Entry& entry)
 {
-    vector<int> key;
-    key.reserve(evaluators.size());
-    for (const shared_ptr<Evaluator>& evaluator : evaluators)
-        key.push_back(
-            eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+    for (size_t i = 0; i < evaluators.size(); ++i)
+        key_buffer[i] = eval_context.get_evaluator_value_or_infinity(
+            evaluators[i].get());
 
-    Bucket& bucket = buckets[key];
-    bool newkey = bucket.empty();
-    bucket.push_back(entry);
+    auto [bucket_it, newkey] = buckets.try_emplace(key_buffer, -1);
+    if (newkey) bucket_it->second = bucket_pool.allocate();
+    bucket_pool[bucket_it->second].push(entry);
 
-    if (newkey && is_nondominated(key, nondominated)) {
+    if (newkey && is_nondominated(key_buffer, nondominated)) {
         /*
           Delete previously nondominated keys that are now dominated
           by key.
@@ -150,7 +155,7 @@ void ParetoOpenList<Entry>::do_insertion(
         */
         auto it = nondominated.begin();
         while (it != nondominated.end()) {
-            if (dominates(key, *it)) {
+            if (dominates(key_buffer, *it)) {
                 auto tmp_it = it;
                 ++it;
                 nondominated.erase(tmp_it);
@@ -159,12 +164,12 @@ void ParetoOpenList<Entry>::do_insertion(
             }
         }
         // Insert new key.
-        nondominated.insert(key);
+        nondominated.insert(key_buffer);
     }
 }
 
-template <class Entry>
-Entry ParetoOpenList<Entry>::remove_min()
+template <class Entry, class Key>
+Entry ParetoOpenList<Entry, Key>::remove_min()
 {
     typename KeySet::iterator selected = nondominated.begin();
     int seen = 0;
@@ -179,36 +184,38 @@ Entry ParetoOpenList<Entry>::remove_min()
         seen += numerator;
         if (rng->random(seen) < numerator) selected = it;
     }
-    Bucket& bucket = buckets[*selected];
-    Entry result = bucket.front();
-    bucket.pop_front();
+    open_list_buckets::FifoBucket<Entry>& bucket =
+        bucket_pool[buckets.at(*selected)];
+    Entry result = bucket.pop();
     if (bucket.empty()) remove_key(*selected);
     return result;
 }
 
-template <class Entry>
-bool ParetoOpenList<Entry>::empty() const
+template <class Entry, class Key>
+bool ParetoOpenList<Entry, Key>::empty() const
 {
     return nondominated.empty();
 }
 
-template <class Entry>
-void ParetoOpenList<Entry>::clear()
+template <class Entry, class Key>
+void ParetoOpenList<Entry, Key>::clear()
 {
     buckets.clear();
+    bucket_pool.clear();
     nondominated.clear();
 }
 
-template <class Entry>
-void ParetoOpenList<Entry>::get_path_dependent_evaluators(
+template <class Entry, class Key>
+void ParetoOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator*>& evals)
 {
     for (const shared_ptr<Evaluator>& evaluator : evaluators)
         evaluator->get_path_dependent_evaluators(evals);
 }
 
-template <class Entry>
-bool ParetoOpenList<Entry>::is_dead_end(EvaluationContext& eval_context) const
+template <class Entry, class Key>
+bool ParetoOpenList<Entry, Key>::is_dead_end(
+    EvaluationContext& eval_context) const
 {
     // TODO: Document this behaviour.
     // If one safe heuristic detects a dead end, return true.
@@ -220,8 +227,8 @@ bool ParetoOpenList<Entry>::is_dead_end(EvaluationContext& eval_context) const
     return true;
 }
 
-template <class Entry>
-bool ParetoOpenList<Entry>::is_reliable_dead_end(
+template <class Entry, class Key>
+bool ParetoOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext& eval_context) const
 {
     for (const shared_ptr<Evaluator>& evaluator : evaluators)
@@ -241,9 +248,25 @@ ParetoOpenListFactory::ParetoOpenListFactory(
 {
 }
 
+template <class Entry>
+static unique_ptr<OpenList<Entry>> create_pareto_open_list(
+    const vector<shared_ptr<Evaluator>>& evals,
+    bool state_uniform_selection,
+    int random_seed)
+{
+    return open_list_buckets::select_key_arity<unique_ptr<OpenList<Entry>>>(
+        evals.size(),
+        [&]<class Key>() {
+            return std::make_unique<ParetoOpenList<Entry, Key>>(
+                evals,
+                state_uniform_selection,
+                random_seed);
+        });
+}
+
 unique_ptr<StateOpenList> ParetoOpenListFactory::create_state_open_list()
 {
-    return std::make_unique<ParetoOpenList<StateOpenListEntry>>(
+    return create_pareto_open_list<StateOpenListEntry>(
         evals,
         state_uniform_selection,
         random_seed);
@@ -251,7 +274,7 @@ unique_ptr<StateOpenList> ParetoOpenListFactory::create_state_open_list()
 
 unique_ptr<EdgeOpenList> ParetoOpenListFactory::create_edge_open_list()
 {
-    return std::make_unique<ParetoOpenList<EdgeOpenListEntry>>(
+    return create_pareto_open_list<EdgeOpenListEntry>(
         evals,
         state_uniform_selection,
         random_seed);
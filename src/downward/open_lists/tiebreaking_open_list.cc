@@ -3,11 +3,12 @@
 #include "downward/evaluator.h"
 #include "downward/open_list.h"
 
+#include "downward/open_lists/open_list_buckets.h"
+
 #include "downward/plugins/plugin.h"
 #include "downward/utils/memory.h"
 
 #include <cassert>
-#include <deque>
 #include <map>
 #include <utility>
 #include <vector>
@@ -15,11 +16,11 @@
 using namespace std;
 
 namespace tiebreaking_open_list {
-template <class Entry>
+template <class Entry, class Key>
 class TieBreakingOpenList : public OpenList<Entry> {
-    using Bucket = deque<Entry>;
-
-    map<const vector<int>, Bucket> buckets;
+    // Maps keys to buckets in the pool.
+    map<Key, int> buckets;
+    open_list_buckets::BucketPool<Entry> bucket_pool;
     int size;
 
     vector<shared_ptr<Evaluator>> evaluators;
@@ -29,6 +30,8 @@ class TieBreakingOpenList : public OpenList<Entry> {
       not a safe heuristic.
     */
     bool allow_unsafe_pruning;
+    // Reused for all insertions to avoid allocating keys.
+    Key key_buffer;
 
     int dimension() const;
 
@@ -50,75 +53,79 @@ public:
     is_reliable_dead_end(EvaluationContext& eval_context) const override;
 };
 
-template <class Entry>
-TieBreakingOpenList<Entry>::TieBreakingOpenList(
+template <class Entry, class Key>
+TieBreakingOpenList<Entry, Key>::TieBreakingOpenList(
     const vector<shared_ptr<Evaluator>>& evals,
     bool unsafe_pruning)
     : size(0)
     , evaluators(evals)
     , allow_unsafe_pruning(unsafe_pruning)
 {
+    open_list_buckets::resize_key(key_buffer, dimension());
 }
 
-template <class Entry>
-void TieBreakingOpenList<Entry>::do_insertion(
+template <class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::do_insertion(
     EvaluationContext& eval_context,
     const Entry& entry)
 {
-    vector<int> key;
-    key.reserve(evaluators.size());
-    for (const shared_ptr<Evaluator>& evaluator : evaluators)
-        key.push_back(
-            eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+    for (int i = 0; i < dimension(); ++i)
+        key_buffer[i] = eval_context.get_evaluator_value_or_infinity(
+            evaluators[i].get());
 
-    buckets[key].push_back(entry);
+    auto [it, inserted] = buckets.try_emplace(key_buffer, -1);
+    if (inserted) it->second = bucket_pool.allocate();
+    bucket_pool[it->second].push(entry);
     ++size;
 }
 
-template <class Entry>
-Entry TieBreakingOpenList<Entry>::remove_min()
+template <class Entry, class Key>
+Entry TieBreakingOpenList<Entry, Key>::remove_min()
 {
     assert(size > 0);
-    typename map<const vector<int>, Bucket>::iterator it;
-    it = buckets.begin();
+    auto it = buckets.begin();
     assert(it != buckets.end());
-    assert(!it->second.empty());
+    open_list_buckets::FifoBucket<Entry>& bucket = bucket_pool[it->second];
+    assert(!bucket.empty());
     --size;
-    Entry result = it->second.front();
-    it->second.pop_front();
-    if (it->second.empty()) buckets.erase(it);
+    Entry result = bucket.pop();
+    if (bucket.empty()) {
+        bucket_pool.release(it->second);
+        buckets.erase(it);
+    }
     return result;
 }
 
-template <class Entry>
-bool TieBreakingOpenList<Entry>::empty() const
+template <class Entry, class Key>
+bool TieBreakingOpenList<Entry, Key>::empty() const
 {
     return size == 0;
 }
 
-template <class Entry>
-void TieBreakingOpenList<Entry>::clear()
+template <class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::clear()
 {
     buckets.clear();
+    bucket_pool.clear();
     size = 0;
 }
 
-template <class Entry>
-int TieBreakingOpenList<Entry>::dimension() const
+template <class Entry, class Key>
+int TieBreakingOpenList<Entry, Key>::dimension() const
 {
     return evaluators.size();
 }
 
-template <class Entry>
-void TieBreakingOpenList<Entry>::get_path_dependent_evaluators(
+template <class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator*>& evals)
 {
     for (const shared_ptr<Evaluator>& evaluator : evaluators)
         evaluator->get_path_dependent_evaluators(evals);
 }
 
-template <class Entry>
-bool TieBreakingOpenList<Entry>::is_dead_end(
+template <class Entry, class Key>
+bool TieBreakingOpenList<Entry, Key>::is_dead_end(
     EvaluationContext& eval_context) const
 {
     // TODO: Properly document this behaviour.
@@ -136,8 +143,8 @@ bool TieBreakingOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template <class Entry>
-bool TieBreakingOpenList<Entry>::is_reliable_dead_end(
+template <class Entry, class Key>
+bool TieBreakingOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext& eval_context) const
 {
     for (const shared_ptr<Evaluator>& evaluator : evaluators)
@@ -155,16 +162,30 @@ TieBreakingOpenListFactory::TieBreakingOpenListFactory(
 {
 }
 
+template <class Entry>
+static unique_ptr<OpenList<Entry>> create_tiebreaking_open_list(
+    const vector<shared_ptr<Evaluator>>& evals,
+    bool unsafe_pruning)
+{
+    return open_list_buckets::select_key_arity<unique_ptr<OpenList<Entry>>>(
+        evals.size(),
+        [&]<class Key>() {
+            return std::make_unique<TieBreakingOpenList<Entry, Key>>(
+                evals,
+                unsafe_pruning);
+        });
+}
+
 unique_ptr<StateOpenList> TieBreakingOpenListFactory::create_state_open_list()
 {
-    return std::make_unique<TieBreakingOpenList<StateOpenListEntry>>(
+    return create_tiebreaking_open_list<StateOpenListEntry>(
         evals,
         unsafe_pruning);
 }
 
 unique_ptr<EdgeOpenList> TieBreakingOpenListFactory::create_edge_open_list()
 {
-    return std::make_unique<TieBreakingOpenList<EdgeOpenListEntry>>(
+    return create_tiebreaking_open_list<EdgeOpenListEntry>(
         evals,
         unsafe_pruning);
 }
@@ -3,6 +3,8 @@
 #include "downward/evaluator.h"
 #include "downward/open_list.h"
 
+#include "downward/open_lists/open_list_buckets.h"
+
 #include "downward/plugins/plugin.h"
 #include "downward/utils/collections.h"
 #include "downward/utils/hash.h"
@@ -11,22 +13,150 @@
 #include "downward/utils/rng.h"
 #include "downward/utils/rng_options.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 using namespace std;
 
 namespace type_based_open_list {
-template <class Entry>
+/*
+  Open-addressing hash index that maps the hashes of type keys to bucket
+  indices. It uses linear probing with backward-shift deletion, so erasing
+  leaves no tombstones and never triggers a rehash.
+*/
+class BucketIndex {
+    static const int EMPTY = -1;
+
+    struct Slot {
+        int bucket_index = EMPTY;
+        uint32_t hash = 0;
+    };
+
+    vector<Slot> slots;
+    int num_entries = 0;
+
+    size_t get_mask() const { return slots.size() - 1; }
+
+    size_t find_slot_of_bucket(int bucket_index, uint32_t hash) const
+    {
+        size_t pos = hash & get_mask();
+        while (slots[pos].bucket_index != bucket_index) {
+            assert(slots[pos].bucket_index != EMPTY);
+            pos = (pos + 1) & get_mask();
+        }
+        return pos;
+    }
+
+    void enlarge()
+    {
+        vector<Slot> old_slots = std::move(slots);
+        slots.assign(max<size_t>(16, 2 * old_slots.size()), Slot());
+        for (const Slot& slot : old_slots) {
+            if (slot.bucket_index != EMPTY) {
+                size_t pos = slot.hash & get_mask();
+                while (slots[pos].bucket_index != EMPTY)
+                    pos = (pos + 1) & get_mask();
+                slots[pos] = slot;
+            }
+        }
+    }
+
+public:
+    /*
+      Return the index of the bucket with the given hash for which
+      is_equal_key returns true, or -1 if there is no such bucket.
+    */
+    template <typename Predicate>
+    int find(uint32_t hash, const Predicate& is_equal_key) const
+    {
+        if (slots.empty()) return EMPTY;
+        for (size_t pos = hash & get_mask(); slots[pos].bucket_index != EMPTY;
+             pos = (pos + 1) & get_mask()) {
+            const Slot& slot = slots[pos];
+            if (slot.hash == hash && is_equal_key(slot.bucket_index))
+                return slot.bucket_index;
+        }
+        return EMPTY;
+    }
+
+    void insert(int bucket_index, uint32_t hash)
+    {
+        // Keep the load factor at most 1/2.
+        if (2 * (num_entries + 1) > static_cast<int>(slots.size())) enlarge();
+        size_t pos = hash & get_mask();
+        while (slots[pos].bucket_index != EMPTY)
+            pos = (pos + 1) & get_mask();
+        slots[pos] = Slot{bucket_index, hash};
+        ++num_entries;
+    }
+
+    void erase(int bucket_index, uint32_t hash)
+    {
+        size_t hole = find_slot_of_bucket(bucket_index, hash);
+        // Move later entries of the probe sequence into the hole.
+        for (size_t pos = (hole + 1) & get_mask();
+             slots[pos].bucket_index != EMPTY;
+             pos = (pos + 1) & get_mask()) {
+            size_t ideal = slots[pos].hash & get_mask();
+            if (((pos - ideal) & get_mask()) >= ((pos - hole) & get_mask())) {
+                slots[hole] = slots[pos];
+                hole = pos;
+            }
+        }
+        slots[hole] = Slot();
+        --num_entries;
+    }
+
+    void rename(int old_bucket_index, int new_bucket_index, uint32_t hash)
+    {
+        slots[find_slot_of_bucket(old_bucket_index, hash)].bucket_index =
+            new_bucket_index;
+    }
+
+    void clear()
+    {
+        slots.clear();
+        num_entries = 0;
+    }
+};
+
+template <class Entry, class Key>
 class TypeBasedOpenList : public OpenList<Entry> {
+    /*
+      The entries of all buckets are stored in one arena. Each bucket owns
+      a segment of the arena, whose first size entries are in use. Full
+      buckets move to a segment of twice the capacity at the end of the
+      arena. Segments of moved and emptied buckets are reclaimed by
+      compacting the arena once they make up half of it.
+    */
+    struct Bucket {
+        Key key;
+        uint32_t hash;
+        int begin;
+        int size;
+        int capacity;
+    };
+
+    static const int MIN_BUCKET_CAPACITY = 4;
+    static const int MIN_ARENA_SIZE_BEFORE_COMPACTION = 1024;
+
     vector<shared_ptr<Evaluator>> evaluators;
     shared_ptr<utils::RandomNumberGenerator> rng;
 
-    using Key = vector<int>;
-    using Bucket = vector<Entry>;
-    vector<pair<Key, Bucket>> keys_and_buckets;
-    utils::HashMap<Key, int> key_to_bucket_index;
+    vector<Bucket> buckets;
+    BucketIndex bucket_index;
+    vector<Entry> arena;
+    // Number of arena entries not owned by any bucket.
+    int num_unused;
+    // Reused for all insertions to avoid allocating keys.
+    Key key_buffer;
+
+    void grow_bucket(Bucket& bucket, const Entry& filler);
+    void release_segment(const Bucket& bucket);
+    void compact_arena_if_necessary();
 
 protected:
     virtual void
@@ -46,72 +176,144 @@ public:
     virtual void get_path_dependent_evaluators(set<Evaluator*>& evals) override;
 };
 
-template <class Entry>
-void TypeBasedOpenList<Entry>::do_insertion(
+template <class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::grow_bucket(
+    Bucket& bucket,
+    const Entry& filler)
+{
+    int new_capacity = max(MIN_BUCKET_CAPACITY, 2 * bucket.capacity);
+    int arena_size = arena.size();
+    if (bucket.begin + bucket.capacity == arena_size) {
+        // The segment is at the end of the arena and can grow in place.
+        arena.resize(bucket.begin + new_capacity, filler);
+    } else {
+        arena.resize(arena_size + new_capacity, filler);
+        copy(
+            arena.begin() + bucket.begin,
+            arena.begin() + bucket.begin + bucket.size,
+            arena.begin() + arena_size);
+        num_unused += bucket.capacity;
+        bucket.begin = arena_size;
+    }
+    bucket.capacity = new_capacity;
+}
+
+template <class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::release_segment(const Bucket& bucket)
+{
+    if (bucket.begin + bucket.capacity == static_cast<int>(arena.size())) {
+        arena.erase(arena.begin() + bucket.begin, arena.end());
+    } else {
+        num_unused += bucket.capacity;
+    }
+}
+
+template <class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::compact_arena_if_necessary()
+{
+    int arena_size = arena.size();
+    if (arena_size < MIN_ARENA_SIZE_BEFORE_COMPACTION ||
+        2 * num_unused < arena_size)
+        return;
+    vector<Entry> new_arena;
+    new_arena.reserve(arena_size - num_unused);
+    for (Bucket& bucket : buckets) {
+        int new_begin = new_arena.size();
+        new_arena.insert(
+            new_arena.end(),
+            arena.begin() + bucket.begin,
+            arena.begin() + bucket.begin + bucket.capacity);
+        bucket.begin = new_begin;
+    }
+    arena.swap(new_arena);
+    num_unused = 0;
+}
+
+template <class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::do_insertion(
     EvaluationContext& eval_context,
     const Entry& entry)
 {
-    vector<int> key;
-    key.reserve(evaluators.size());
-    for (const shared_ptr<Evaluator>& evaluator : evaluators) {
-        key.push_back(
-            eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+    for (size_t i = 0; i < evaluators.size(); ++i) {
+        key_buffer[i] = eval_context.get_evaluator_value_or_infinity(
+            evaluators[i].get());
     }
 
-    auto it = key_to_bucket_index.find(key);
-    if (it == key_to_bucket_index.end()) {
-        key_to_bucket_index[key] = keys_and_buckets.size();
-        keys_and_buckets.push_back(make_pair(std::move(key), Bucket({entry})));
-    } else {
-        size_t bucket_index = it->second;
-        assert(utils::in_bounds(bucket_index, keys_and_buckets));
-        keys_and_buckets[bucket_index].second.push_back(entry);
+    uint32_t hash = utils::get_hash32(key_buffer);
+    int index = bucket_index.find(hash, [&](int candidate) {
+        return buckets[candidate].key == key_buffer;
+    });
+    if (index == -1) {
+        index = buckets.size();
+        // The empty segment at the end of the arena can grow in place.
+        buckets.push_back(
+            Bucket{key_buffer, hash, static_cast<int>(arena.size()), 0, 0});
+        bucket_index.insert(index, hash);
+    }
+    assert(utils::in_bounds(index, buckets));
+    Bucket& bucket = buckets[index];
+    if (bucket.size == bucket.capacity) {
+        grow_bucket(bucket, entry);
+        compact_arena_if_necessary();
     }
+    arena[bucket.begin + bucket.size++] = entry;
 }
 
-template <class Entry>
-TypeBasedOpenList<Entry>::TypeBasedOpenList(
+template <class Entry, class Key>
+TypeBasedOpenList<Entry, Key>::TypeBasedOpenList(
     const vector<shared_ptr<Evaluator>>& evaluators,
     int random_seed)
     : evaluators(evaluators)
     , rng(utils::get_rng(random_seed))
+    , num_unused(0)
 {
+    open_list_buckets::resize_key(key_buffer, evaluators.size());
 }
 
-template <class Entry>
-Entry TypeBasedOpenList<Entry>::remove_min()
+template <class Entry, class Key>
+Entry TypeBasedOpenList<Entry, Key>::remove_min()
 {
-    size_t bucket_id = rng->random(keys_and_buckets.size());
-    auto& key_and_bucket = keys_and_buckets[bucket_id];
-    const Key& min_key = key_and_bucket.first;
-    Bucket& bucket = key_and_bucket.second;
-    int pos = rng->random(bucket.size());
-    Entry result = utils::swap_and_pop_from_vector(bucket, pos);
-
-    if (bucket.empty()) {
+    size_t bucket_id = rng->random(buckets.size());
+    Bucket& bucket = buckets[bucket_id];
+    int pos = rng->random(bucket.size);
+    // Swap the selected entry with the last entry, then remove it.
+    Entry result = arena[bucket.begin + pos];
+    arena[bucket.begin + pos] = arena[bucket.begin + bucket.size - 1];
+    --bucket.size;
+
+    if (bucket.size == 0) {
         // Swap the empty bucket with the last bucket, then delete it.
-        key_to_bucket_index[keys_and_buckets.back().first] = bucket_id;
-        key_to_bucket_index.erase(min_key);
-        utils::swap_and_pop_from_vector(keys_and_buckets, bucket_id);
+        bucket_index.erase(bucket_id, bucket.hash);
+        release_segment(bucket);
+        if (bucket_id != buckets.size() - 1) {
+            bucket_index.rename(
+                buckets.size() - 1,
+                bucket_id,
+                buckets.back().hash);
+        }
+        utils::swap_and_pop_from_vector(buckets, bucket_id);
+        compact_arena_if_necessary();
     }
     return result;
 }
 
-template <class Entry>
-bool TypeBasedOpenList<Entry>::empty() const
+template <class Entry, class Key>
+bool TypeBasedOpenList<Entry, Key>::empty() const
 {
-    return keys_and_buckets.empty();
+    return buckets.empty();
 }
 
-template <class Entry>
-void TypeBasedOpenList<Entry>::clear()
+template <class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::clear()
 {
-    keys_and_buckets.clear();
-    key_to_bucket_index.clear();
+    buckets.clear();
+    bucket_index.clear();
+    arena.clear();
+    num_unused = 0;
 }
 
-template <class Entry>
-bool TypeBasedOpenList<Entry>::is_dead_end(
+template <class Entry, class Key>
+bool TypeBasedOpenList<Entry, Key>::is_dead_end(
     EvaluationContext& eval_context) const
 {
     // If one evaluator is sure we have a dead end, return true.
@@ -124,8 +326,8 @@ bool TypeBasedOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template <class Entry>
-bool TypeBasedOpenList<Entry>::is_reliable_dead_end(
+template <class Entry, class Key>
+bool TypeBasedOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext& eval_context) const
 {
     for (const shared_ptr<Evaluator>& evaluator : evaluators) {
@@ -136,8 +338,8 @@ bool TypeBasedOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
-template <class Entry>
-void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
+template <class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator*>& evals)
 {
     for (const shared_ptr<Evaluator>& evaluator : evaluators) {
@@ -153,16 +355,30 @@ TypeBasedOpenListFactory::TypeBasedOpenListFactory(
 {
 }
 
+template <class Entry>
+static unique_ptr<OpenList<Entry>> create_type_based_open_list(
+    const vector<shared_ptr<Evaluator>>& evaluators,
+    int random_seed)
+{
+    return open_list_buckets::select_key_arity<unique_ptr<OpenList<Entry>>>(
+        evaluators.size(),
+        [&]<class Key>() {
+            return std::make_unique<TypeBasedOpenList<Entry, Key>>(
+                evaluators,
+                random_seed);
+        });
+}
+
 unique_ptr<StateOpenList> TypeBasedOpenListFactory::create_state_open_list()
 {
-    return std::make_unique<TypeBasedOpenList<StateOpenListEntry>>(
+    return create_type_based_open_list<StateOpenListEntry>(
         evaluators,
         random_seed);
 }
 
 unique_ptr<EdgeOpenList> TypeBasedOpenListFactory::create_edge_open_list()
 {
-    return std::make_unique<TypeBasedOpenList<EdgeOpenListEntry>>(
+    return create_type_based_open_list<EdgeOpenListEntry>(
         evaluators,
         random_seed);
 }
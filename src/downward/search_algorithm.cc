@@ -21,7 +21,10 @@ using namespace std;
 using utils::ExitCode;
 
 static successor_generator::SuccessorGenerator&
-get_successor_generator(const ClassicalPlanningTask& task, utils::LogProxy& log)
+get_successor_generator(
+    const ClassicalPlanningTask& task,
+    SuccessorGeneratorType type,
+    utils::LogProxy& log)
 {
     if (log.is_at_least_normal()) {
         log << "Building successor generator..." << flush;
@@ -29,7 +32,7 @@ get_successor_generator(const ClassicalPlanningTask& task, utils::LogProxy& log)
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator& successor_generator =
-        successor_generator::g_successor_generators[task];
+        successor_generator::g_successor_generators[task][type];
     successor_generator_timer.stop();
     if (log.is_at_least_normal()) {
         log << "done!" << endl;
@@ -50,6 +53,10 @@ SearchAlgorithm::SearchAlgorithm(
     OperatorCost cost_type,
     int bound,
     double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
     const string& description,
     utils::Verbosity verbosity)
     : description(description)
@@ -57,8 +64,11 @@ SearchAlgorithm::SearchAlgorithm(
     , solution_found(false)
     , task(std::move(task))
     , log(utils::get_log_for_verbosity(verbosity))
-    , state_registry(*this->task)
-    , successor_generator(get_successor_generator(*this->task, log))
+    , state_registry(*this->task, state_hashing, state_storage, state_packing)
+    , successor_generator(get_successor_generator(
+          *this->task,
+          successor_generator_type,
+          log))
     , search_space(state_registry, log)
     , statistics(log)
     , bound(bound)
@@ -71,7 +81,10 @@ SearchAlgorithm::SearchAlgorithm(
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
     if (log.is_at_least_normal()) {
-        task_properties::print_variable_statistics(*this->task, log);
+        task_properties::print_variable_statistics(
+            *this->task,
+            state_packing,
+            log);
     }
 }
 
@@ -81,8 +94,15 @@ SearchAlgorithm::SearchAlgorithm(const plugins::Options& opts)
     , solution_found(false)
     , task(tasks::g_root_task)
     , log(utils::get_log_for_verbosity(opts.get<utils::Verbosity>("verbosity")))
-    , state_registry(*task)
-    , successor_generator(get_successor_generator(*task, log))
+    , state_registry(
+          *task,
+          opts.get<StateHashing>("state_hashing"),
+          opts.get<shared_ptr<StateStorage>>("state_storage"),
+          opts.get<StatePacking>("state_packing"))
+    , successor_generator(get_successor_generator(
+          *task,
+          opts.get<SuccessorGeneratorType>("successor_generator"),
+          log))
     , search_space(state_registry, log)
     , statistics(log)
     , cost_type(opts.get<OperatorCost>("cost_type"))
@@ -95,7 +115,10 @@ SearchAlgorithm::SearchAlgorithm(const plugins::Options& opts)
     }
     bound = opts.get<int>("bound");
     if (log.is_at_least_normal()) {
-        task_properties::print_variable_statistics(*task, log);
+        task_properties::print_variable_statistics(
+            *task,
+            state_registry.get_state_packing(),
+            log);
     }
 }
 
@@ -154,13 +177,20 @@ bool SearchAlgorithm::check_goal_and_set_plan(const State& state)
         }
         goal_id = state.get_id();
         Plan plan;
-        search_space.trace_path(state, plan);
+        trace_path(state, plan);
         set_plan(plan);
         return true;
     }
     return false;
 }
 
+void SearchAlgorithm::trace_path(
+    const State& goal_state,
+    vector<OperatorID>& path)
+{
+    search_space.trace_path(goal_state, path);
+}
+
 void SearchAlgorithm::save_plan_if_necessary()
 {
     if (found_solution()) {
@@ -209,6 +239,22 @@ void add_search_algorithm_options_to_feature(
         "just like incomplete search algorithms that exhaust their search "
         "space.",
         "infinity");
+    feature.add_option<StateHashing>(
+        "state_hashing",
+        "how states are hashed for duplicate detection",
+        "packed_data");
+    feature.add_option<shared_ptr<StateStorage>>(
+        "state_storage",
+        "memory in which the data of registered states is stored",
+        "heap()");
+    feature.add_option<StatePacking>(
+        "state_packing",
+        "how the variables of registered states are packed into memory",
+        "bins");
+    feature.add_option<SuccessorGeneratorType>(
+        "successor_generator",
+        "how the operators applicable in a state are computed",
+        "tree");
     feature.add_option<string>(
         "description",
         "description used to identify search algorithm in logs",
@@ -221,6 +267,10 @@ tuple<
     OperatorCost,
     int,
     double,
+    StateHashing,
+    shared_ptr<StateStorage>,
+    StatePacking,
+    SuccessorGeneratorType,
     string,
     utils::Verbosity>
 get_search_algorithm_arguments_from_options(const plugins::Options& opts)
@@ -231,6 +281,10 @@ get_search_algorithm_arguments_from_options(const plugins::Options& opts)
         make_tuple(
             opts.get<int>("bound"),
             opts.get<double>("max_time"),
+            opts.get<StateHashing>("state_hashing"),
+            opts.get<shared_ptr<StateStorage>>("state_storage"),
+            opts.get<StatePacking>("state_packing"),
+            opts.get<SuccessorGeneratorType>("successor_generator"),
             opts.get<string>("description")),
         utils::get_log_arguments_from_options(opts));
 }
@@ -245,25 +299,14 @@ void add_successors_order_options_to_feature(plugins::Feature& feature)
         "randomize_successors",
         "randomize the order in which successors are generated",
         "false");
-    feature.add_option<bool>(
-        "preferred_successors_first",
-        "consider preferred operators first",
-        "false");
-    feature.document_note(
-        "Successor ordering",
-        "When using randomize_successors=true and "
-        "preferred_successors_first=true, randomization happens before "
-        "preferred operators are moved to the front.");
     utils::add_rng_options_to_feature(feature);
 }
 
-tuple<bool, bool, int>
+tuple<bool, int>
 get_successors_order_arguments_from_options(const plugins::Options& opts)
 {
     return tuple_cat(
-        make_tuple(
-            opts.get<bool>("randomize_successors"),
-            opts.get<bool>("preferred_successors_first")),
+        make_tuple(opts.get<bool>("randomize_successors")),
         utils::get_rng_arguments_from_options(opts));
 }
 
@@ -0,0 +1,251 @@
+#include "downward/search_algorithms/anytime_wastar.h"
+
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/open_list_factory.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <set>
+
+using namespace std;
+
+namespace anytime_wastar {
+AnytimeWAstarSearch::AnytimeWAstarSearch(
+    const shared_ptr<Evaluator>& evaluator,
+    const vector<int>& weights,
+    bool repeat_last_weight,
+    bool reuse_search_space,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , evaluator(evaluator)
+    , weights(weights)
+    , repeat_last_weight(repeat_last_weight)
+    , reuse_search_space(reuse_search_space)
+    , verbosity(verbosity)
+    , iteration(0)
+    , queued_in_iteration(-1)
+{
+    assert(!weights.empty());
+}
+
+int AnytimeWAstarSearch::get_weight() const
+{
+    return weights[min<size_t>(iteration, weights.size() - 1)];
+}
+
+void AnytimeWAstarSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting anytime weighted A* search"
+            << (reuse_search_space ? " with" : " without")
+            << " reusing the search space, (real) bound = " << bound << endl;
+    }
+    start_iteration();
+}
+
+void AnytimeWAstarSearch::start_iteration()
+{
+    int weight = get_weight();
+    if (log.is_at_least_normal()) {
+        log << "Starting iteration " << iteration + 1 << " with weight "
+            << weight << " and (real) bound " << bound << endl;
+    }
+    open_list = search_common::create_wastar_open_list_factory(
+                    {evaluator},
+                    {},
+                    0,
+                    weight,
+                    verbosity)
+                    ->create_state_open_list();
+
+    set<Evaluator*> evals;
+    open_list->get_path_dependent_evaluators(evals);
+    path_dependent_evaluators.assign(evals.begin(), evals.end());
+
+    if (!current_search_space || !reuse_search_space) {
+        current_search_space =
+            make_unique<SearchSpace>(state_registry, log, cost_type);
+    } else {
+        // States expanded by earlier iterations may be expanded again.
+        for (StateID id : state_registry) {
+            SearchNode node =
+                current_search_space->get_node(state_registry.lookup_state(id));
+            if (node.is_closed()) node.reopen();
+        }
+    }
+
+    State initial_state = state_registry.get_initial_state();
+    for (Evaluator* evaluator : path_dependent_evaluators) {
+        evaluator->notify_initial_state(initial_state);
+    }
+    SearchNode node = current_search_space->get_node(initial_state);
+    if (node.is_new()) {
+        node.open_initial();
+    }
+    if (!node.is_dead_end() && bound > 0) {
+        insert(node);
+    }
+}
+
+void AnytimeWAstarSearch::insert(SearchNode& node)
+{
+    const State& state = node.get_state();
+    EvaluationContext eval_context(state, node.get_g(), &statistics);
+    statistics.inc_evaluated_states();
+    if (open_list->is_dead_end(eval_context)) {
+        node.mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+    open_list->insert(eval_context, state.get_id());
+    queued_in_iteration[state] = iteration;
+    if (search_progress.check_progress(eval_context)) {
+        statistics.print_checkpoint_line(node.get_g());
+    }
+}
+
+SearchStatus AnytimeWAstarSearch::finish_iteration(bool found_plan)
+{
+    if (found_plan) {
+        plan_manager.save_plan(get_plan(), *task, true);
+        bound = calculate_plan_cost(get_plan(), *task);
+        if (log.is_at_least_normal()) {
+            log << "Iteration " << iteration + 1 << " found a plan of cost "
+                << bound << endl;
+        }
+        if (iteration + 1 >= static_cast<int>(weights.size()) &&
+            !repeat_last_weight) {
+            return SOLVED;
+        }
+        ++iteration;
+        start_iteration();
+        return IN_PROGRESS;
+    }
+
+    if (found_solution()) {
+        if (log.is_at_least_normal()) {
+            log << "Iteration " << iteration + 1 << " found no plan of cost "
+                << "below " << bound << " -- the last plan is optimal." << endl;
+        }
+        return SOLVED;
+    }
+    if (log.is_at_least_normal()) {
+        log << "Completely explored state space -- no solution!" << endl;
+    }
+    return FAILED;
+}
+
+SearchStatus AnytimeWAstarSearch::step()
+{
+    SearchSpace& space = *current_search_space;
+    optional<SearchNode> node;
+    while (true) {
+        if (open_list->empty()) {
+            return finish_iteration(false);
+        }
+        StateID id = open_list->remove_min();
+        State s = state_registry.lookup_state(id);
+        node.emplace(space.get_node(s));
+        if (node->is_closed() || node->is_dead_end()) continue;
+
+        node->close();
+        statistics.inc_expanded();
+        break;
+    }
+
+    const State& s = node->get_state();
+    if (check_goal_and_set_plan(s)) {
+        return finish_iteration(true);
+    }
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(s, applicable_ops);
+
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task->get_operators()[op_id];
+        if ((node->get_real_g() + op.get_cost()) >= bound) continue;
+
+        State succ_state = state_registry.get_successor_state(s, op);
+        statistics.inc_generated();
+
+        SearchNode succ_node = space.get_node(succ_state);
+
+        for (Evaluator* evaluator : path_dependent_evaluators) {
+            evaluator->notify_state_transition(s, op_id, succ_state);
+        }
+
+        if (succ_node.is_dead_end()) continue;
+
+        int adjusted_cost = get_adjusted_cost(op);
+        if (succ_node.is_new()) {
+            succ_node.open(*node, op, adjusted_cost);
+            insert(succ_node);
+        } else if (succ_node.get_g() > node->get_g() + adjusted_cost) {
+            // We found a new cheapest path to an open or closed state.
+            if (succ_node.is_closed()) {
+                statistics.inc_reopened();
+            }
+            succ_node.reopen(*node, op, adjusted_cost);
+            insert(succ_node);
+        } else if (
+            queued_in_iteration[succ_state] != iteration &&
+            succ_node.get_real_g() < bound) {
+            /*
+              An earlier iteration found a path to this state that is at
+              least as cheap. Continue from it.
+            */
+            insert(succ_node);
+        }
+    }
+
+    return IN_PROGRESS;
+}
+
+void AnytimeWAstarSearch::trace_path(
+    const State& goal_state,
+    vector<OperatorID>& path)
+{
+    current_search_space->trace_path(goal_state, path);
+}
+
+void AnytimeWAstarSearch::print_statistics() const
+{
+    if (log.is_at_least_normal()) {
+        log << "Iterations: " << iteration + 1 << endl;
+    }
+    statistics.print_detailed_statistics();
+    if (current_search_space) {
+        current_search_space->print_statistics();
+    }
+}
+
+void AnytimeWAstarSearch::save_plan_if_necessary()
+{
+}
+} // namespace anytime_wastar
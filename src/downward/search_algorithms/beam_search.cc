@@ -0,0 +1,199 @@
+#include "downward/search_algorithms/beam_search.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+using namespace std;
+
+namespace beam_search {
+BeamSearch::BeamSearch(
+    const shared_ptr<Evaluator>& evaluator,
+    int width,
+    bool filter_duplicates,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , evaluator(evaluator)
+    , width(width)
+    , filter_duplicates(filter_duplicates)
+{
+    previous_layer.reserve(width);
+    current_layer.reserve(width);
+}
+
+void BeamSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting beam search with width " << width
+            << ", (real) bound = " << bound << endl;
+    }
+    State initial_state = task->get_initial_state();
+    EvaluationContext eval_context(initial_state, 0, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+    if (search_progress.check_progress(eval_context)) {
+        statistics.print_checkpoint_line(0);
+    }
+    if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+        if (log.is_at_least_normal()) {
+            log << "Initial state is a dead end." << endl;
+        }
+        statistics.inc_dead_ends();
+        return;
+    }
+    current_layer.push_back(LayerState{std::move(initial_state), 0, 0});
+}
+
+void BeamSearch::set_plan_to(int index, OperatorID last_op)
+{
+    Plan plan;
+    plan.push_back(last_op);
+    for (int layer = parents.size() - 1; layer >= 0; --layer) {
+        const ParentEntry& entry = parents[layer][index];
+        plan.push_back(entry.creating_op);
+        index = entry.parent;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus BeamSearch::step()
+{
+    if (current_layer.empty()) {
+        if (log.is_at_least_normal()) {
+            log << "The beam is empty -- no solution found!" << endl;
+        }
+        return FAILED;
+    }
+    if (parents.empty() &&
+        task_properties::is_goal_state(*task, current_layer[0].state)) {
+        if (log.is_at_least_normal()) {
+            log << "Solution found!" << endl;
+        }
+        set_plan(Plan());
+        return SOLVED;
+    }
+
+    if (filter_duplicates) {
+        recent_states.clear();
+        for (const vector<LayerState>* layer :
+             {&previous_layer, &current_layer}) {
+            for (const LayerState& layer_state : *layer) {
+                recent_states.insert(layer_state.state.get_unpacked_values());
+            }
+        }
+    }
+
+    vector<ParentEntry> successor_parents;
+    vector<LayerState> successors;
+    vector<EvaluationContext> eval_contexts;
+    vector<OperatorID> applicable_ops;
+    for (size_t i = 0; i < current_layer.size(); ++i) {
+        const LayerState& layer_state = current_layer[i];
+        statistics.inc_expanded();
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(
+            layer_state.state,
+            applicable_ops);
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = task->get_operators()[op_id];
+            int succ_real_g = layer_state.real_g + op.get_cost();
+            if (succ_real_g >= bound) continue;
+
+            State succ_state =
+                get_unregistered_successor(layer_state.state, op);
+            statistics.inc_generated();
+            if (task_properties::is_goal_state(*task, succ_state)) {
+                if (log.is_at_least_normal()) {
+                    log << "Solution found!" << endl;
+                }
+                set_plan_to(i, op_id);
+                return SOLVED;
+            }
+            if (filter_duplicates &&
+                !recent_states.insert(succ_state.get_unpacked_values())
+                     .second) {
+                continue;
+            }
+            int succ_g = layer_state.g + get_adjusted_cost(op);
+            successor_parents.push_back(
+                ParentEntry{static_cast<int>(i), op_id});
+            eval_contexts.emplace_back(succ_state, succ_g, &statistics);
+            successors.push_back(
+                LayerState{std::move(succ_state), succ_g, succ_real_g});
+        }
+    }
+
+    EvaluationContext::compute_results(evaluator.get(), eval_contexts);
+    statistics.inc_evaluated_states(eval_contexts.size());
+
+    // Rank the successors by h, g and the order of their generation.
+    vector<tuple<int, int, int>> ranking;
+    ranking.reserve(successors.size());
+    for (size_t i = 0; i < successors.size(); ++i) {
+        EvaluationContext& eval_context = eval_contexts[i];
+        int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+        if (h == EvaluationResult::INFTY) {
+            statistics.inc_dead_ends();
+            continue;
+        }
+        if (search_progress.check_progress(eval_context)) {
+            statistics.print_checkpoint_line(successors[i].g);
+        }
+        ranking.emplace_back(h, successors[i].g, i);
+    }
+    size_t new_width = min<size_t>(width, ranking.size());
+    partial_sort(ranking.begin(), ranking.begin() + new_width, ranking.end());
+
+    vector<ParentEntry> layer_parents;
+    layer_parents.reserve(new_width);
+    swap(previous_layer, current_layer);
+    current_layer.clear();
+    for (size_t i = 0; i < new_width; ++i) {
+        int successor = get<2>(ranking[i]);
+        layer_parents.push_back(successor_parents[successor]);
+        current_layer.push_back(std::move(successors[successor]));
+    }
+    parents.push_back(std::move(layer_parents));
+    if (log.is_at_least_verbose()) {
+        log << "Layer " << parents.size() << ": " << current_layer.size()
+            << " of " << successors.size() << " successors kept" << endl;
+    }
+    return IN_PROGRESS;
+}
+
+void BeamSearch::print_statistics() const
+{
+    if (log.is_at_least_normal()) {
+        log << "Beam search layers: " << parents.size() << endl;
+    }
+    statistics.print_detailed_statistics();
+}
+} // namespace beam_search
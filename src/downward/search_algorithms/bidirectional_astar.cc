@@ -0,0 +1,525 @@
+#include "downward/search_algorithms/bidirectional_astar.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace std;
+using regression_successor_generator::UNASSIGNED;
+
+namespace bidirectional_astar {
+/*
+  Partial states with the given pattern and the states that satisfy them
+  get the same hash. Partial states with different patterns can get the
+  same hash, so lookups also compare the patterns.
+*/
+template <typename Values>
+static int_hash_set::HashType
+hash_projection(const vector<int>& variables, const Values& values)
+{
+    utils::HashState hash_state;
+    for (int var : variables) {
+        hash_state.feed(static_cast<uint32_t>(values[var]));
+    }
+    return hash_state.get_hash32();
+}
+
+void Frontier::add(int node, int g, int f)
+{
+    heap.emplace(max(f, 2 * g), g, f, node);
+    f_values.insert(f);
+    g_values.insert(g);
+}
+
+void Frontier::remove(int g, int f)
+{
+    f_values.erase(f_values.find(f));
+    g_values.erase(g_values.find(g));
+}
+
+void Frontier::pop_stale(const function<bool(int, int)>& is_stale)
+{
+    while (!heap.empty() &&
+           is_stale(get<3>(heap.top()), get<1>(heap.top()))) {
+        heap.pop();
+    }
+}
+
+int Frontier::pop()
+{
+    auto [priority, g, f, node] = heap.top();
+    heap.pop();
+    remove(g, f);
+    return node;
+}
+
+int_hash_set::HashType
+BidirectionalAStarSearch::BackwardNodeHash::operator()(int node) const
+{
+    int pattern = search.backward_nodes[node].pattern;
+    return hash_projection(
+        search.patterns[pattern].variables,
+        search.get_values(node));
+}
+
+bool BidirectionalAStarSearch::BackwardNodeEqual::operator()(
+    int lhs,
+    int rhs) const
+{
+    const int* lhs_values = search.get_values(lhs);
+    return equal(
+        lhs_values,
+        lhs_values + search.num_variables,
+        search.get_values(rhs));
+}
+
+int_hash_set::HashType
+BidirectionalAStarSearch::ProjectionHash::operator()(int forward_state) const
+{
+    return hash_projection(
+        search.patterns[pattern].variables,
+        search.state_registry.lookup_state(
+            search.forward_states[forward_state]));
+}
+
+bool BidirectionalAStarSearch::ProjectionHashEqual::operator()(
+    int lhs,
+    int rhs) const
+{
+    return hash(lhs) == hash(rhs);
+}
+
+BidirectionalAStarSearch::BidirectionalAStarSearch(
+    const shared_ptr<Evaluator>& evaluator,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , evaluator(evaluator)
+    , regression_generator(*this->task)
+    , num_variables(this->task->get_num_variables())
+    , epsilon(numeric_limits<int>::max())
+    , forward_h(EvaluationResult::INFTY)
+    , backward_node_ids(BackwardNodeHash{*this}, BackwardNodeEqual{*this})
+    , best_solution_cost(EvaluationResult::INFTY)
+    , best_forward_state(StateID::no_state)
+    , best_backward_node(-1)
+    , num_forward_expansions(0)
+    , num_backward_expansions(0)
+{
+    for (OperatorProxy op : this->task->get_operators()) {
+        epsilon = min(epsilon, get_adjusted_cost(op));
+    }
+    if (epsilon == numeric_limits<int>::max()) {
+        epsilon = 0;
+    }
+}
+
+const int* BidirectionalAStarSearch::get_values(int node) const
+{
+    return backward_partial_states.data() + node * num_variables;
+}
+
+vector<int> BidirectionalAStarSearch::get_partial_state(int node) const
+{
+    const int* values = get_values(node);
+    return vector<int>(values, values + num_variables);
+}
+
+void BidirectionalAStarSearch::update_best_solution(
+    StateID forward_state,
+    int forward_g,
+    int forward_real_g,
+    int backward_node)
+{
+    const BackwardNode& node = backward_nodes[backward_node];
+    int cost = forward_g + node.g;
+    if (cost < best_solution_cost && forward_real_g + node.real_g < bound) {
+        best_solution_cost = cost;
+        best_forward_state = forward_state;
+        best_backward_node = backward_node;
+        if (log.is_at_least_normal()) {
+            log << "Found a solution of cost " << cost << endl;
+        }
+    }
+}
+
+void BidirectionalAStarSearch::insert_forward(
+    const State& state,
+    const SearchNode& node)
+{
+    int g = node.get_g();
+    forward_frontier.add(state.get_id().get_value(), g, g + forward_h[state]);
+
+    // Check if the state meets a partial state of the backward search.
+    state.unpack();
+    const vector<int>& state_values = state.get_unpacked_values();
+    for (int pattern = 0; pattern < static_cast<int>(patterns.size());
+         ++pattern) {
+        const vector<int>& variables = patterns[pattern].variables;
+        int backward_node = backward_node_ids.find(
+            hash_projection(variables, state_values),
+            [&](int other) {
+                const int* values = get_values(other);
+                return backward_nodes[other].pattern == pattern &&
+                       all_of(
+                           variables.begin(),
+                           variables.end(),
+                           [&](int var) {
+                               return values[var] == state_values[var];
+                           });
+            });
+        if (backward_node != -1) {
+            update_best_solution(
+                state.get_id(),
+                g,
+                node.get_real_g(),
+                backward_node);
+        }
+    }
+}
+
+void BidirectionalAStarSearch::insert_backward(
+    vector<int>&& partial_state,
+    int g,
+    int real_g,
+    int parent,
+    OperatorID creating_op)
+{
+    int pattern_id = get_pattern_id(partial_state);
+    Pattern& pattern = patterns[pattern_id];
+    int_hash_set::HashType hash =
+        hash_projection(pattern.variables, partial_state);
+    int node_id = backward_node_ids.find(hash, [&](int other) {
+        return equal(
+            partial_state.begin(),
+            partial_state.end(),
+            get_values(other));
+    });
+    if (node_id == -1) {
+        node_id = backward_nodes.size();
+        backward_nodes.push_back(
+            BackwardNode{g, real_g, parent, creating_op, pattern_id, false});
+        backward_partial_states.insert(
+            backward_partial_states.end(),
+            partial_state.begin(),
+            partial_state.end());
+        backward_node_ids.insert_new_with_hash(node_id, hash);
+    } else {
+        BackwardNode& node = backward_nodes[node_id];
+        if (node.g <= g) {
+            return;
+        }
+        // We found a cheaper path to the partial state.
+        if (node.closed) {
+            node.closed = false;
+            statistics.inc_reopened();
+        } else {
+            backward_frontier.remove(node.g, node.g);
+        }
+        node = BackwardNode{g, real_g, parent, creating_op, pattern_id, false};
+    }
+    backward_frontier.add(node_id, g, g);
+
+    // Check if states of the forward search meet the partial state.
+    add_new_forward_states(pattern);
+    int forward_state =
+        pattern.forward_states.find(hash, [](int) { return true; });
+    for (; forward_state != -1;
+         forward_state = pattern.next_forward_state[forward_state]) {
+        State state =
+            state_registry.lookup_state(forward_states[forward_state]);
+        bool meets = all_of(
+            pattern.variables.begin(),
+            pattern.variables.end(),
+            [&](int var) { return state[var] == partial_state[var]; });
+        if (meets) {
+            SearchNode forward_node = search_space.get_node(state);
+            update_best_solution(
+                state.get_id(),
+                forward_node.get_g(),
+                forward_node.get_real_g(),
+                node_id);
+        }
+    }
+}
+
+int BidirectionalAStarSearch::get_pattern_id(const vector<int>& partial_state)
+{
+    vector<int> variables;
+    for (int var = 0; var < num_variables; ++var) {
+        if (partial_state[var] != UNASSIGNED) {
+            variables.push_back(var);
+        }
+    }
+    auto [it, inserted] = pattern_ids.try_emplace(variables, patterns.size());
+    if (inserted) {
+        int pattern = it->second;
+        patterns.push_back(Pattern{
+            std::move(variables),
+            {ProjectionHash{*this, pattern},
+             ProjectionHashEqual{ProjectionHash{*this, pattern}}},
+            {}});
+    }
+    return it->second;
+}
+
+void BidirectionalAStarSearch::add_new_forward_states(Pattern& pattern)
+{
+    for (int index = pattern.next_forward_state.size();
+         index < static_cast<int>(forward_states.size());
+         ++index) {
+        State state = state_registry.lookup_state(forward_states[index]);
+        int_hash_set::HashType hash =
+            hash_projection(pattern.variables, state);
+        int first =
+            pattern.forward_states.find(hash, [](int) { return true; });
+        if (first == -1) {
+            pattern.forward_states.insert_new_with_hash(index, hash);
+            pattern.next_forward_state.push_back(-1);
+        } else {
+            pattern.next_forward_state.push_back(
+                pattern.next_forward_state[first]);
+            pattern.next_forward_state[first] = index;
+        }
+    }
+}
+
+void BidirectionalAStarSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting bidirectional MM search, (real) bound = " << bound
+            << endl;
+    }
+
+    vector<int> goal(num_variables, UNASSIGNED);
+    for (FactProxy goal_fact : task->get_goal()) {
+        goal[goal_fact.get_variable().get_id()] = goal_fact.get_value();
+    }
+    insert_backward(std::move(goal), 0, 0, -1, OperatorID::no_operator);
+
+    set<Evaluator*> evals;
+    evaluator->get_path_dependent_evaluators(evals);
+    path_dependent_evaluators.assign(evals.begin(), evals.end());
+
+    State initial_state = state_registry.get_initial_state();
+    for (Evaluator* evaluator : path_dependent_evaluators) {
+        evaluator->notify_initial_state(initial_state);
+    }
+    EvaluationContext eval_context(initial_state, 0, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+    int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+    SearchNode node = search_space.get_node(initial_state);
+    if (h == EvaluationResult::INFTY) {
+        if (log.is_at_least_normal()) {
+            log << "Initial state is a dead end." << endl;
+        }
+        node.mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+    node.open_initial();
+    forward_h[initial_state] = h;
+    forward_states.push_back(initial_state.get_id());
+    insert_forward(initial_state, node);
+}
+
+void BidirectionalAStarSearch::expand_forward()
+{
+    State state = state_registry.lookup_state(StateID(forward_frontier.pop()));
+    SearchNode node = search_space.get_node(state);
+    node.close();
+    statistics.inc_expanded();
+    ++num_forward_expansions;
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(state, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task->get_operators()[op_id];
+        if (node.get_real_g() + op.get_cost() >= bound) continue;
+
+        State succ_state = state_registry.get_successor_state(state, op);
+        statistics.inc_generated();
+        for (Evaluator* evaluator : path_dependent_evaluators) {
+            evaluator->notify_state_transition(state, op_id, succ_state);
+        }
+
+        SearchNode succ_node = search_space.get_node(succ_state);
+        if (succ_node.is_dead_end()) continue;
+
+        int adjusted_cost = get_adjusted_cost(op);
+        if (succ_node.is_new()) {
+            int succ_g = node.get_g() + adjusted_cost;
+            EvaluationContext eval_context(succ_state, succ_g, &statistics);
+            statistics.inc_evaluated_states();
+            int h =
+                eval_context.get_evaluator_value_or_infinity(evaluator.get());
+            if (h == EvaluationResult::INFTY) {
+                succ_node.mark_as_dead_end();
+                statistics.inc_dead_ends();
+                continue;
+            }
+            if (search_progress.check_progress(eval_context)) {
+                statistics.print_checkpoint_line(succ_g);
+            }
+            forward_h[succ_state] = h;
+            forward_states.push_back(succ_state.get_id());
+            succ_node.open(node, op, adjusted_cost);
+            insert_forward(succ_state, succ_node);
+        } else if (succ_node.get_g() > node.get_g() + adjusted_cost) {
+            // We found a cheaper path to an open or closed state.
+            if (succ_node.is_closed()) {
+                statistics.inc_reopened();
+            } else {
+                int old_g = succ_node.get_g();
+                forward_frontier.remove(old_g, old_g + forward_h[succ_state]);
+            }
+            succ_node.reopen(node, op, adjusted_cost);
+            insert_forward(succ_state, succ_node);
+        }
+    }
+}
+
+void BidirectionalAStarSearch::expand_backward()
+{
+    int node_id = backward_frontier.pop();
+    backward_nodes[node_id].closed = true;
+    statistics.inc_expanded();
+    ++num_backward_expansions;
+
+    vector<int> partial_state = get_partial_state(node_id);
+    vector<OperatorID> relevant_ops;
+    regression_generator.generate_relevant_ops(partial_state, relevant_ops);
+    for (OperatorID op_id : relevant_ops) {
+        OperatorProxy op = task->get_operators()[op_id];
+        // Note that inserting invalidates references to backward nodes.
+        int g = backward_nodes[node_id].g;
+        int real_g = backward_nodes[node_id].real_g;
+        if (real_g + op.get_cost() >= bound) continue;
+
+        vector<int> regression;
+        if (!regression_generator.regress(partial_state, op_id, regression)) {
+            continue;
+        }
+        statistics.inc_generated();
+        insert_backward(
+            std::move(regression),
+            g + get_adjusted_cost(op),
+            real_g + op.get_cost(),
+            node_id,
+            op_id);
+    }
+}
+
+int BidirectionalAStarSearch::compute_lower_bound() const
+{
+    return max(
+        {min(forward_frontier.get_min_priority(),
+             backward_frontier.get_min_priority()),
+         forward_frontier.get_min_f(),
+         backward_frontier.get_min_f(),
+         forward_frontier.get_min_g() + backward_frontier.get_min_g() +
+             epsilon});
+}
+
+void BidirectionalAStarSearch::extract_plan()
+{
+    State state = state_registry.lookup_state(best_forward_state);
+    Plan plan;
+    search_space.trace_path(state, plan);
+    for (int node = best_backward_node; backward_nodes[node].parent != -1;
+         node = backward_nodes[node].parent) {
+        OperatorID op_id = backward_nodes[node].creating_op;
+        plan.push_back(op_id);
+        state = state_registry.get_successor_state(
+            state,
+            task->get_operators()[op_id]);
+    }
+    assert(task_properties::is_goal_state(*task, state));
+    goal_id = state.get_id();
+    set_plan(plan);
+}
+
+SearchStatus BidirectionalAStarSearch::step()
+{
+    forward_frontier.pop_stale([&](int id, int g) {
+        SearchNode node = search_space.get_node(
+            state_registry.lookup_state(StateID(id)));
+        return !node.is_open() || node.get_g() != g;
+    });
+    backward_frontier.pop_stale([&](int id, int g) {
+        return backward_nodes[id].closed || backward_nodes[id].g != g;
+    });
+
+    /*
+      If one direction has no open nodes left, it has generated all states
+      (or partial states) on optimal solution paths, and the solutions
+      through them have been found.
+    */
+    bool exhausted = forward_frontier.empty() || backward_frontier.empty();
+    if (exhausted || best_solution_cost <= compute_lower_bound()) {
+        if (best_solution_cost == EvaluationResult::INFTY) {
+            if (log.is_at_least_normal()) {
+                log << "Completely explored state space -- no solution!"
+                    << endl;
+            }
+            return FAILED;
+        }
+        if (log.is_at_least_normal()) {
+            log << "Solution found!" << endl;
+        }
+        extract_plan();
+        return SOLVED;
+    }
+
+    statistics.report_f_value_progress(compute_lower_bound());
+    int forward_priority = forward_frontier.get_min_priority();
+    int backward_priority = backward_frontier.get_min_priority();
+    if (forward_priority < backward_priority ||
+        (forward_priority == backward_priority &&
+         forward_frontier.size() <= backward_frontier.size())) {
+        expand_forward();
+    } else {
+        expand_backward();
+    }
+    return IN_PROGRESS;
+}
+
+void BidirectionalAStarSearch::print_statistics() const
+{
+    if (log.is_at_least_normal()) {
+        log << "Forward expansions: " << num_forward_expansions << endl;
+        log << "Backward expansions: " << num_backward_expansions << endl;
+        log << "Backward partial states: " << backward_nodes.size() << endl;
+        log << "Backward patterns: " << patterns.size() << endl;
+    }
+    statistics.print_detailed_statistics();
+    search_space.print_statistics();
+}
+} // namespace bidirectional_astar
@@ -7,8 +7,10 @@
 
 #include "downward/algorithms/ordered_set.h"
 #include "downward/plugins/options.h"
+#include "downward/task_utils/incremental_successor_generator.h"
 #include "downward/task_utils/successor_generator.h"
 #include "downward/utils/logging.h"
+#include "downward/utils/system.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -25,10 +27,18 @@ EagerSearch::EagerSearch(
     const shared_ptr<Evaluator>& f_eval,
     const vector<shared_ptr<Evaluator>>& preferred,
     const shared_ptr<CachedHeuristic>& lazy_evaluator,
+    bool store_parent_pointers,
+    int incremental_successors,
+    const shared_ptr<Evaluator>& batch_evaluator,
+    int batch_expansions,
     std::shared_ptr<ClassicalPlanningTask> task,
     OperatorCost cost_type,
     int bound,
     double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
     const string& description,
     utils::Verbosity verbosity)
     : SearchAlgorithm(
@@ -36,6 +46,10 @@ EagerSearch::EagerSearch(
           cost_type,
           bound,
           max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
           description,
           verbosity)
     , reopen_closed_nodes(reopen_closed)
@@ -43,7 +57,59 @@ EagerSearch::EagerSearch(
     , f_evaluator(f_eval)
     , preferred_operator_evaluators(preferred)
     , lazy_evaluator(lazy_evaluator)
+    , batch_evaluator(batch_evaluator)
+    , batch_expansions(batch_expansions)
+    , num_expansions_in_batch(0)
 {
+    // With these cost types, g values are the costs of the paths.
+    bool real_g_is_g = this->cost_type == NORMAL || is_unit_cost;
+    if (real_g_is_g && store_parent_pointers) {
+        search_space_without_real_g =
+            make_unique<BasicSearchSpace<BasicSearchNodeInfo<false, true>>>(
+                state_registry,
+                log,
+                this->cost_type);
+    } else if (!real_g_is_g && !store_parent_pointers) {
+        search_space_without_parents =
+            make_unique<BasicSearchSpace<BasicSearchNodeInfo<true, false>>>(
+                state_registry,
+                log,
+                this->cost_type);
+    } else if (real_g_is_g && !store_parent_pointers) {
+        search_space_without_real_g_and_parents =
+            make_unique<BasicSearchSpace<BasicSearchNodeInfo<false, false>>>(
+                state_registry,
+                log,
+                this->cost_type);
+    }
+
+    if (incremental_successors > 0) {
+        if (!store_parent_pointers) {
+            cerr << "Incremental successor generation needs the parents of "
+                 << "the expanded states, but parent_pointers=false." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        incremental_successor_generator = make_unique<
+            successor_generator::IncrementalSuccessorGenerator>(
+            *this->task,
+            successor_generator,
+            incremental_successors);
+    }
+}
+
+EagerSearch::~EagerSearch() = default;
+
+template <typename Function>
+decltype(auto) EagerSearch::visit_search_space(const Function& function)
+{
+    if (search_space_without_real_g) {
+        return function(*search_space_without_real_g);
+    } else if (search_space_without_parents) {
+        return function(*search_space_without_parents);
+    } else if (search_space_without_real_g_and_parents) {
+        return function(*search_space_without_real_g_and_parents);
+    }
+    return function(search_space);
 }
 
 void EagerSearch::initialize()
@@ -84,6 +150,10 @@ void EagerSearch::initialize()
         lazy_evaluator->get_path_dependent_evaluators(evals);
     }
 
+    if (batch_evaluator) {
+        batch_evaluator->get_path_dependent_evaluators(evals);
+    }
+
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
     State initial_state = state_registry.get_initial_state();
@@ -103,8 +173,9 @@ void EagerSearch::initialize()
         if (search_progress.check_progress(eval_context))
             statistics.print_checkpoint_line(0);
         start_f_value_statistics(eval_context);
-        SearchNode node = search_space.get_node(initial_state);
-        node.open_initial();
+        visit_search_space([&](auto& space) {
+            space.get_node(initial_state).open_initial();
+        });
 
         open_list->insert(eval_context, initial_state.get_id());
     }
@@ -116,10 +187,88 @@ void EagerSearch::print_statistics() const
 {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    if (incremental_successor_generator) {
+        incremental_successor_generator->print_statistics(log);
+    }
 }
 
 SearchStatus EagerSearch::step()
 {
+    return visit_search_space([this](auto& space) { return step(space); });
+}
+
+void EagerSearch::trace_path(const State& goal_state, vector<OperatorID>& path)
+{
+    visit_search_space(
+        [&](auto& space) { space.trace_path(goal_state, path); });
+}
+
+template <typename SearchSpaceType>
+void EagerSearch::generate_applicable_ops(
+    SearchSpaceType& space,
+    const State& state,
+    vector<OperatorID>& applicable_ops)
+{
+    if constexpr (requires { space.get_parent_id(state); }) {
+        if (incremental_successor_generator) {
+            incremental_successor_generator->generate_applicable_ops(
+                state,
+                space.get_parent_id(state),
+                space.get_creating_operator(state),
+                applicable_ops);
+            return;
+        }
+    }
+    successor_generator.generate_applicable_ops(state, applicable_ops);
+}
+
+template <typename SearchSpaceType>
+void EagerSearch::evaluate_pending_successors(SearchSpaceType& space)
+{
+    EvaluationContext::compute_results(
+        batch_evaluator.get(),
+        pending_eval_contexts);
+
+    for (EvaluationContext& succ_eval_context : pending_eval_contexts) {
+        const State& succ_state = succ_eval_context.get_state();
+        statistics.inc_evaluated_states();
+        /*
+          If a cheaper path to the successor was found before the batch was
+          evaluated and we reopen states, it was queued again with its new g
+          value. Then this context is outdated, and the state may even have
+          been expanded already. Without reopening, the cheaper path only
+          updated the parent and this is the only context of the state.
+        */
+        auto succ_node = space.get_node(succ_state);
+        if (!succ_node.is_open() ||
+            (reopen_closed_nodes &&
+             succ_node.get_g() != succ_eval_context.get_g_value()))
+            continue;
+
+        if (open_list->is_dead_end(succ_eval_context)) {
+            succ_node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+            continue;
+        }
+        open_list->insert(succ_eval_context, succ_state.get_id());
+        if (search_progress.check_progress(succ_eval_context)) {
+            statistics.print_checkpoint_line(succ_eval_context.get_g_value());
+            reward_progress();
+        }
+    }
+    pending_eval_contexts.clear();
+    num_expansions_in_batch = 0;
+}
+
+template <typename SearchSpaceType>
+SearchStatus EagerSearch::step(SearchSpaceType& space)
+{
+    using SearchNode = typename SearchSpaceType::Node;
+    // The open list may only become empty because of pending successors.
+    if (open_list->empty() && !pending_eval_contexts.empty()) {
+        evaluate_pending_successors(space);
+    }
+
     std::optional<SearchNode> node;
     while (true) {
         if (open_list->empty()) {
@@ -131,7 +280,7 @@ SearchStatus EagerSearch::step()
         }
         StateID id = open_list->remove_min();
         State s = state_registry.lookup_state(id);
-        node.emplace(search_space.get_node(s));
+        node.emplace(space.get_node(s));
 
         if (node->is_closed()) continue;
 
@@ -182,7 +331,7 @@ SearchStatus EagerSearch::step()
     if (check_goal_and_set_plan(s)) return SOLVED;
 
     vector<OperatorID> applicable_ops;
-    successor_generator.generate_applicable_ops(s, applicable_ops);
+    generate_applicable_ops(space, s, applicable_ops);
 
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task->get_operators()[op_id];
@@ -191,7 +340,7 @@ SearchStatus EagerSearch::step()
         State succ_state = state_registry.get_successor_state(s, op);
         statistics.inc_generated();
 
-        SearchNode succ_node = search_space.get_node(succ_state);
+        SearchNode succ_node = space.get_node(succ_state);
 
         for (Evaluator* evaluator : path_dependent_evaluators) {
             evaluator->notify_state_transition(s, op_id, succ_state);
@@ -209,6 +358,20 @@ SearchStatus EagerSearch::step()
             // TODO: Make this less fragile.
             int succ_g = node->get_g() + get_adjusted_cost(op);
 
+            if (batch_evaluator) {
+                /*
+                  Open the node right away, so that further paths to it
+                  found before the batch is evaluated are treated as
+                  duplicates.
+                */
+                succ_node.open(*node, op, get_adjusted_cost(op));
+                pending_eval_contexts.emplace_back(
+                    succ_state,
+                    succ_g,
+                    &statistics);
+                continue;
+            }
+
             EvaluationContext succ_eval_context(
                 succ_state,
                 succ_g,
@@ -242,6 +405,15 @@ SearchStatus EagerSearch::step()
                 }
                 succ_node.reopen(*node, op, get_adjusted_cost(op));
 
+                if (batch_evaluator) {
+                    // Reopened states are evaluated with the next batch, too.
+                    pending_eval_contexts.emplace_back(
+                        succ_state,
+                        succ_node.get_g(),
+                        &statistics);
+                    continue;
+                }
+
                 EvaluationContext succ_eval_context(
                     succ_state,
                     succ_node.get_g(),
@@ -274,6 +446,10 @@ SearchStatus EagerSearch::step()
         }
     }
 
+    if (batch_evaluator && ++num_expansions_in_batch >= batch_expansions) {
+        evaluate_pending_successors(space);
+    }
+
     return IN_PROGRESS;
 }
 
@@ -281,9 +457,9 @@ void EagerSearch::reward_progress()
 {
 }
 
-void EagerSearch::dump_search_space() const
+void EagerSearch::dump_search_space()
 {
-    search_space.dump(*task);
+    visit_search_space([this](auto& space) { space.dump(*task); });
 }
 
 void EagerSearch::start_f_value_statistics(EvaluationContext& eval_context)
@@ -311,22 +487,72 @@ void add_eager_search_options_to_feature(
 {
     // We do not add a lazy_evaluator options here
     // because it is only used for astar but not the other plugins.
+    feature.add_option<bool>(
+        "parent_pointers",
+        "store the parent of each search node. Otherwise, the plan is "
+        "reconstructed by regression from the goal, which saves 8 bytes per "
+        "state. For each step of the plan, regression looks up every state "
+        "from which an operator whose effects hold in the current state "
+        "may lead there. Effect variables without a precondition can have "
+        "any value in the predecessor, so the number of lookups is the "
+        "product of their domain sizes. If it exceeds 1000000 for an "
+        "operator, the planner stops with an error.",
+        "true");
+    feature.add_option<int>(
+        "incremental_successors",
+        "number of expanded states whose applicable operators are cached to "
+        "compute the applicable operators of their successors incrementally "
+        "from them. Only operators with a precondition on a variable changed "
+        "by the creating operator are rechecked. 0 disables incremental "
+        "successor generation. Needs parent_pointers=true.",
+        "0",
+        plugins::Bounds("0", "infinity"));
+    feature.add_option<shared_ptr<Evaluator>>(
+        "batch_evaluator",
+        "evaluator that evaluates the new and reopened successors of "
+        "batch_expansions expansions in one batch (see "
+        "Evaluator::compute_results) before they are inserted into the open "
+        "list. This should be the most expensive evaluator of the open list, "
+        "for example a learned heuristic that processes whole batches at "
+        "once. If none is given, each successor is evaluated when it is "
+        "generated.",
+        plugins::ArgumentInfo::NO_DEFAULT);
+    feature.add_option<int>(
+        "batch_expansions",
+        "number of expansions whose successors are collected into one batch "
+        "for the batch_evaluator. With values larger than 1, states are "
+        "expanded before the successors of earlier expansions are in the "
+        "open list, so A* can lose its optimality guarantee.",
+        "1",
+        plugins::Bounds("1", "infinity"));
     add_search_algorithm_options_to_feature(feature, description);
 }
 
 tuple<
     shared_ptr<CachedHeuristic>,
+    bool,
+    int,
+    shared_ptr<Evaluator>,
+    int,
     std::shared_ptr<ClassicalPlanningTask>,
     OperatorCost,
     int,
     double,
+    StateHashing,
+    shared_ptr<StateStorage>,
+    StatePacking,
+    SuccessorGeneratorType,
     string,
     utils::Verbosity>
 get_eager_search_arguments_from_options(const plugins::Options& opts)
 {
     return tuple_cat(
         make_tuple(
-            opts.get<shared_ptr<CachedHeuristic>>("lazy_evaluator", nullptr)),
+            opts.get<shared_ptr<CachedHeuristic>>("lazy_evaluator", nullptr),
+            opts.get<bool>("parent_pointers"),
+            opts.get<int>("incremental_successors"),
+            opts.get<shared_ptr<Evaluator>>("batch_evaluator", nullptr),
+            opts.get<int>("batch_expansions")),
         get_search_algorithm_arguments_from_options(opts));
 }
 } // namespace eager_search
@@ -0,0 +1,521 @@
+#include "downward/search_algorithms/external_bfs.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+#include "downward/utils/timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <numeric>
+#include <queue>
+
+using namespace std;
+
+namespace external_bfs {
+static void exit_with_io_error(const string& message)
+{
+    cerr << message << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+/*
+  Reads a file of records in chunks of a fixed number of records. The
+  current record stays valid until the next call to advance.
+*/
+class RecordReader {
+    ifstream file;
+    const filesystem::path path;
+    const int record_size;
+    SearchStatistics& statistics;
+    vector<PackedStateBin> buffer;
+    size_t num_buffered_records;
+    size_t position;
+
+    void refill()
+    {
+        file.read(
+            reinterpret_cast<char*>(buffer.data()),
+            buffer.size() * sizeof(PackedStateBin));
+        streamsize bytes = file.gcount();
+        if (file.bad()) {
+            exit_with_io_error("Could not read " + path.string());
+        }
+        statistics.inc_bytes_read(bytes);
+        num_buffered_records = bytes / (record_size * sizeof(PackedStateBin));
+        position = 0;
+    }
+
+public:
+    RecordReader(
+        const filesystem::path& path,
+        int record_size,
+        int buffer_records,
+        SearchStatistics& statistics)
+        : file(path, ios::binary)
+        , path(path)
+        , record_size(record_size)
+        , statistics(statistics)
+        , buffer(static_cast<size_t>(record_size) * buffer_records)
+    {
+        if (!file) {
+            exit_with_io_error("Could not open " + path.string());
+        }
+        refill();
+    }
+
+    bool done() const { return position >= num_buffered_records; }
+
+    const PackedStateBin* get_record() const
+    {
+        assert(!done());
+        return buffer.data() + position * record_size;
+    }
+
+    void advance()
+    {
+        ++position;
+        if (position == num_buffered_records && file) {
+            refill();
+        }
+    }
+};
+
+// Writes records to a file through a buffer of a fixed number of records.
+class RecordWriter {
+    ofstream file;
+    const filesystem::path path;
+    const int record_size;
+    SearchStatistics& statistics;
+    vector<PackedStateBin> buffer;
+    const size_t capacity;
+    long long num_records;
+
+public:
+    RecordWriter(
+        const filesystem::path& path,
+        int record_size,
+        int buffer_records,
+        SearchStatistics& statistics)
+        : file(path, ios::binary | ios::trunc)
+        , path(path)
+        , record_size(record_size)
+        , statistics(statistics)
+        , capacity(static_cast<size_t>(record_size) * buffer_records)
+        , num_records(0)
+    {
+        if (!file) {
+            exit_with_io_error("Could not create " + path.string());
+        }
+        buffer.reserve(capacity);
+    }
+
+    ~RecordWriter() { flush(); }
+
+    void write(const PackedStateBin* record)
+    {
+        buffer.insert(buffer.end(), record, record + record_size);
+        ++num_records;
+        if (buffer.size() >= capacity) {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (buffer.empty()) {
+            return;
+        }
+        streamsize bytes = buffer.size() * sizeof(PackedStateBin);
+        file.write(reinterpret_cast<const char*>(buffer.data()), bytes);
+        if (!file) {
+            exit_with_io_error("Could not write " + path.string());
+        }
+        statistics.inc_bytes_written(bytes);
+        buffer.clear();
+    }
+
+    long long get_num_records() const { return num_records; }
+};
+
+ExternalBFSSearch::ExternalBFSSearch(
+    const string& scratch_dir,
+    int buffer_size,
+    int io_buffer_size,
+    int merge_fan_in,
+    int locality,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , scratch_dir(
+          filesystem::path(scratch_dir) /
+          ("external_bfs_" +
+           to_string(
+               chrono::steady_clock::now().time_since_epoch().count())))
+    , buffer_size(buffer_size)
+    , io_buffer_size(io_buffer_size)
+    , merge_fan_in(merge_fan_in)
+    , locality(locality)
+    , num_bins(state_registry.get_state_packer().get_num_bins())
+    , record_size(num_bins + 1)
+{
+    error_code error;
+    if (!filesystem::create_directories(this->scratch_dir, error)) {
+        exit_with_io_error(
+            "Could not create scratch directory " +
+            this->scratch_dir.string() + ": " + error.message());
+    }
+}
+
+ExternalBFSSearch::~ExternalBFSSearch()
+{
+    remove_scratch_dir();
+}
+
+void ExternalBFSSearch::remove_scratch_dir()
+{
+    error_code error;
+    filesystem::remove_all(scratch_dir, error);
+}
+
+filesystem::path ExternalBFSSearch::get_layer_path(int layer) const
+{
+    return scratch_dir / ("layer_" + to_string(layer));
+}
+
+filesystem::path ExternalBFSSearch::get_run_path(int run) const
+{
+    return scratch_dir / ("run_" + to_string(run));
+}
+
+/*
+  Records are ordered by their bins and then by their g values, so the
+  first of several records of the same state is the cheapest one.
+*/
+static bool
+record_less(const PackedStateBin* lhs, const PackedStateBin* rhs, int size)
+{
+    return lexicographical_compare(lhs, lhs + size, rhs, rhs + size);
+}
+
+void ExternalBFSSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting external breadth-first search in " << scratch_dir
+            << ", (real) bound = " << bound << endl;
+    }
+    vector<PackedStateBin> record(record_size);
+    state_registry.get_state_packer().pack_all(
+        task->get_initial_state().get_unpacked_values().data(),
+        record.data());
+    record[num_bins] = 0;
+    RecordWriter writer(get_layer_path(0), record_size, 1, statistics);
+    writer.write(record.data());
+    layer_sizes.push_back(1);
+}
+
+void ExternalBFSSearch::write_run(
+    vector<PackedStateBin>& buffer,
+    const filesystem::path& path)
+{
+    size_t num_records = buffer.size() / record_size;
+    vector<size_t> order(num_records);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return record_less(
+            buffer.data() + lhs * record_size,
+            buffer.data() + rhs * record_size,
+            record_size);
+    });
+    RecordWriter writer(path, record_size, io_buffer_size, statistics);
+    const PackedStateBin* previous = nullptr;
+    for (size_t index : order) {
+        const PackedStateBin* record = buffer.data() + index * record_size;
+        // Keep the cheapest record of each state.
+        if (!previous || !equal(record, record + num_bins, previous)) {
+            writer.write(record);
+            previous = record;
+        }
+    }
+    buffer.clear();
+}
+
+/*
+  Merge the sorted input files into one sorted file with the cheapest record
+  of each state and remove the inputs.
+*/
+long long ExternalBFSSearch::merge_files(
+    const vector<filesystem::path>& inputs,
+    const filesystem::path& path)
+{
+    vector<unique_ptr<RecordReader>> readers;
+    for (const filesystem::path& input : inputs) {
+        readers.push_back(make_unique<RecordReader>(
+            input,
+            record_size,
+            io_buffer_size,
+            statistics));
+    }
+    auto greater_record = [&](int lhs, int rhs) {
+        return record_less(
+            readers[rhs]->get_record(),
+            readers[lhs]->get_record(),
+            record_size);
+    };
+    priority_queue<int, vector<int>, decltype(greater_record)> queue(
+        greater_record);
+    for (size_t i = 0; i < readers.size(); ++i) {
+        if (!readers[i]->done()) {
+            queue.push(i);
+        }
+    }
+
+    RecordWriter writer(path, record_size, io_buffer_size, statistics);
+    vector<PackedStateBin> previous;
+    while (!queue.empty()) {
+        int i = queue.top();
+        queue.pop();
+        const PackedStateBin* record = readers[i]->get_record();
+        if (previous.empty() ||
+            !equal(record, record + num_bins, previous.begin())) {
+            writer.write(record);
+            previous.assign(record, record + record_size);
+        }
+        readers[i]->advance();
+        if (!readers[i]->done()) {
+            queue.push(i);
+        }
+    }
+    readers.clear();
+    for (const filesystem::path& input : inputs) {
+        filesystem::remove(input);
+    }
+    return writer.get_num_records();
+}
+
+long long
+ExternalBFSSearch::merge_runs(int num_runs, const filesystem::path& path)
+{
+    vector<filesystem::path> runs;
+    for (int run = 0; run < num_runs; ++run) {
+        runs.push_back(get_run_path(run));
+    }
+    // Merge groups of merge_fan_in runs until one pass can merge the rest.
+    int next_run = num_runs;
+    while (static_cast<int>(runs.size()) > merge_fan_in) {
+        vector<filesystem::path> merged_runs;
+        for (size_t begin = 0; begin < runs.size(); begin += merge_fan_in) {
+            size_t end = min(runs.size(), begin + merge_fan_in);
+            if (end - begin == 1) {
+                merged_runs.push_back(runs[begin]);
+                continue;
+            }
+            filesystem::path merged_run = get_run_path(next_run++);
+            merge_files(
+                vector<filesystem::path>(
+                    runs.begin() + begin,
+                    runs.begin() + end),
+                merged_run);
+            merged_runs.push_back(merged_run);
+        }
+        runs = move(merged_runs);
+    }
+    return merge_files(runs, path);
+}
+
+long long ExternalBFSSearch::subtract_layer(
+    const filesystem::path& candidates_path,
+    int layer,
+    const filesystem::path& path)
+{
+    RecordReader candidates(
+        candidates_path,
+        record_size,
+        io_buffer_size,
+        statistics);
+    RecordReader old_states(
+        get_layer_path(layer),
+        record_size,
+        io_buffer_size,
+        statistics);
+    RecordWriter writer(path, record_size, io_buffer_size, statistics);
+    for (; !candidates.done(); candidates.advance()) {
+        const PackedStateBin* record = candidates.get_record();
+        // Both files are sorted by their bins, so we compare only those.
+        while (!old_states.done() &&
+               record_less(old_states.get_record(), record, num_bins)) {
+            old_states.advance();
+        }
+        if (old_states.done() ||
+            !equal(record, record + num_bins, old_states.get_record())) {
+            writer.write(record);
+        }
+    }
+    return writer.get_num_records();
+}
+
+void ExternalBFSSearch::extract_plan(
+    int layer,
+    vector<PackedStateBin> goal_record)
+{
+    const int_packer::IntPacker& packer = state_registry.get_state_packer();
+    int num_variables = task->get_num_variables();
+    vector<int> values(num_variables);
+    vector<PackedStateBin> successor(num_bins);
+    vector<OperatorID> applicable_ops;
+    Plan plan;
+    for (; layer > 0; --layer) {
+        bool found = false;
+        RecordReader reader(
+            get_layer_path(layer - 1),
+            record_size,
+            io_buffer_size,
+            statistics);
+        for (; !reader.done() && !found; reader.advance()) {
+            const PackedStateBin* record = reader.get_record();
+            packer.unpack_all(record, values.data());
+            State state(values);
+            applicable_ops.clear();
+            successor_generator.generate_applicable_ops(state, applicable_ops);
+            for (OperatorID op_id : applicable_ops) {
+                OperatorProxy op = task->get_operators()[op_id];
+                if (record[num_bins] + op.get_cost() !=
+                    goal_record[num_bins]) {
+                    continue;
+                }
+                State succ_state = get_unregistered_successor(state, op);
+                packer.pack_all(
+                    succ_state.get_unpacked_values().data(),
+                    successor.data());
+                if (equal(successor.begin(), successor.end(),
+                          goal_record.begin())) {
+                    plan.push_back(op_id);
+                    goal_record.assign(record, record + record_size);
+                    found = true;
+                    break;
+                }
+            }
+        }
+        assert(found);
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus ExternalBFSSearch::step()
+{
+    int layer = layer_sizes.size() - 1;
+    if (layer_sizes[layer] == 0) {
+        if (log.is_at_least_normal()) {
+            log << "Completely explored state space -- no solution!" << endl;
+        }
+        remove_scratch_dir();
+        return FAILED;
+    }
+    statistics.report_f_value_progress(layer);
+
+    const int_packer::IntPacker& packer = state_registry.get_state_packer();
+    vector<int> values(task->get_num_variables());
+    vector<PackedStateBin> buffer;
+    buffer.reserve(static_cast<size_t>(record_size) * buffer_size);
+    vector<PackedStateBin> successor(record_size);
+    vector<OperatorID> applicable_ops;
+    int num_runs = 0;
+
+    RecordReader reader(
+        get_layer_path(layer),
+        record_size,
+        io_buffer_size,
+        statistics);
+    for (; !reader.done(); reader.advance()) {
+        const PackedStateBin* record = reader.get_record();
+        packer.unpack_all(record, values.data());
+        State state(values);
+        if (task_properties::is_goal_state(*task, state)) {
+            if (log.is_at_least_normal()) {
+                log << "Solution found!" << endl;
+            }
+            extract_plan(
+                layer,
+                vector<PackedStateBin>(record, record + record_size));
+            remove_scratch_dir();
+            return SOLVED;
+        }
+        statistics.inc_expanded();
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = task->get_operators()[op_id];
+            int succ_real_g = record[num_bins] + op.get_cost();
+            if (succ_real_g >= bound) continue;
+
+            State succ_state = get_unregistered_successor(state, op);
+            statistics.inc_generated();
+            packer.pack_all(
+                succ_state.get_unpacked_values().data(),
+                successor.data());
+            successor[num_bins] = succ_real_g;
+            buffer.insert(buffer.end(), successor.begin(), successor.end());
+            if (buffer.size() >=
+                static_cast<size_t>(record_size) * buffer_size) {
+                write_run(buffer, get_run_path(num_runs++));
+            }
+        }
+    }
+    if (!buffer.empty() || num_runs == 0) {
+        write_run(buffer, get_run_path(num_runs++));
+    }
+
+    utils::Timer merge_timer;
+    filesystem::path candidates_path = scratch_dir / "candidates";
+    filesystem::path next_path = scratch_dir / "next";
+    long long num_states = merge_runs(num_runs, candidates_path);
+    int first_layer = max(0, layer + 1 - locality);
+    for (int old_layer = layer; old_layer >= first_layer && num_states > 0;
+         --old_layer) {
+        num_states = subtract_layer(candidates_path, old_layer, next_path);
+        filesystem::rename(next_path, candidates_path);
+    }
+    filesystem::rename(candidates_path, get_layer_path(layer + 1));
+    statistics.inc_merge_time(merge_timer());
+    layer_sizes.push_back(num_states);
+
+    if (log.is_at_least_verbose()) {
+        log << "Layer " << layer + 1 << ": " << num_states << " states from "
+            << num_runs << " run(s)" << endl;
+    }
+    return IN_PROGRESS;
+}
+
+void ExternalBFSSearch::print_statistics() const
+{
+    if (log.is_at_least_normal()) {
+        log << "Layers: " << layer_sizes.size() << endl;
+        log << "Largest layer: "
+            << *max_element(layer_sizes.begin(), layer_sizes.end())
+            << " state(s)" << endl;
+    }
+    statistics.print_detailed_statistics();
+}
+} // namespace external_bfs
@@ -0,0 +1,718 @@
+#include "downward/search_algorithms/hda_astar.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+#include "downward/open_list_factory.h"
+#include "downward/per_state_information.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/task_utils/flat_operator_table.h"
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/countdown_timer.h"
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hda_astar {
+/*
+  Number of messages a worker collects for one receiver before handing them
+  over as one batch. Partially filled batches are flushed every
+  FLUSH_INTERVAL expansions and whenever a worker runs out of open nodes.
+*/
+static const size_t MESSAGE_BATCH_SIZE = 64;
+static const int FLUSH_INTERVAL = 64;
+
+// Querying the timer is comparatively expensive, so we only do it this often.
+static const int TIMER_CHECK_INTERVAL = 1024;
+
+static const int NO_WORKER = -1;
+
+/*
+  A successor sent to the worker owning it. The packed state data of the i-th
+  message of a batch is stored at offset i * bins_per_state of
+  MessageBatch::buffers.
+*/
+struct Message {
+    int g;
+    int real_g;
+    int parent_worker;
+    StateID parent_id;
+    OperatorID creating_operator;
+};
+
+struct MessageBatch {
+    MessageBatch* next = nullptr;
+    vector<Message> messages;
+    vector<PackedStateBin> buffers;
+};
+
+/*
+  Multiple-producer single-consumer mailbox implemented as a lock-free stack
+  of message batches. Senders push complete batches, the receiver takes all
+  pending batches at once. The order in which batches are received does not
+  matter for correctness.
+*/
+class Mailbox {
+    atomic<MessageBatch*> head;
+
+public:
+    Mailbox()
+        : head(nullptr)
+    {
+    }
+
+    ~Mailbox()
+    {
+        MessageBatch* batch = take_all();
+        while (batch) {
+            MessageBatch* next = batch->next;
+            delete batch;
+            batch = next;
+        }
+    }
+
+    void push(MessageBatch* batch)
+    {
+        batch->next = head.load(memory_order_relaxed);
+        while (!head.compare_exchange_weak(
+            batch->next,
+            batch,
+            memory_order_release,
+            memory_order_relaxed)) {
+        }
+    }
+
+    MessageBatch* take_all()
+    {
+        return head.exchange(nullptr, memory_order_acquire);
+    }
+};
+
+/*
+  Parent of a node whose parent is registered by another worker. Nodes
+  without a parent in their own registry are the roots of the paths traced
+  by SearchSpace::trace_path. For the initial state, worker is NO_WORKER.
+*/
+struct RemoteParent {
+    int worker;
+    StateID state_id;
+    OperatorID creating_operator;
+
+    RemoteParent()
+        : worker(NO_WORKER)
+        , state_id(StateID::no_state)
+        , creating_operator(OperatorID::no_operator)
+    {
+    }
+
+    RemoteParent(int worker, StateID state_id, OperatorID creating_operator)
+        : worker(worker)
+        , state_id(state_id)
+        , creating_operator(creating_operator)
+    {
+    }
+};
+
+struct SharedSearchData {
+    vector<HDAStarWorker*> workers;
+
+    /*
+      Number of open list entries plus messages that have not been received
+      yet, summed over all workers. Workers publish the entries and messages
+      they create before the messages become visible to their receivers, and
+      the entries and messages they consume only after all work created from
+      them is published. So the counter can only drop to zero once the search
+      space is exhausted.
+    */
+    atomic<int64_t> pending_work;
+    atomic<bool> stop;
+
+    // Cost (as adjusted by cost_type) of the cheapest goal found so far.
+    atomic<int> incumbent_cost;
+    mutex goal_mutex;
+    int goal_worker;
+    StateID goal_id;
+
+    SharedSearchData()
+        : pending_work(0)
+        , stop(false)
+        , incumbent_cost(numeric_limits<int>::max())
+        , goal_worker(NO_WORKER)
+        , goal_id(StateID::no_state)
+    {
+    }
+};
+
+static int
+get_owner(const PackedStateBin* buffer, int bins_per_state, int num_workers)
+{
+    /*
+      We hash the packed data like StateRegistry::StateIDSemanticHash but use
+      the upper half of the 64-bit hash. The lower half is what the registry
+      uses for its hash set, and states of one worker must not all share the
+      same lower bits.
+    */
+    utils::HashState hash_state;
+    for (int i = 0; i < bins_per_state; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    return static_cast<int>((hash_state.get_hash64() >> 32) % num_workers);
+}
+
+class HDAStarWorker {
+    const int id;
+    const ClassicalPlanningTask& task;
+    const successor_generator::SuccessorGenerator& successor_generator;
+    SharedSearchData& shared;
+    const OperatorCost cost_type;
+    const bool is_unit_cost;
+    const int bound;
+
+    utils::LogProxy log;
+
+public:
+    StateRegistry state_registry;
+    SearchSpace search_space;
+    SearchStatistics statistics;
+
+private:
+    const int bins_per_state;
+    const shared_ptr<Evaluator> evaluator;
+    unique_ptr<StateOpenList> open_list;
+    PerStateInformation<int> h_values;
+    PerStateInformation<RemoteParent> remote_parents;
+
+    Mailbox mailbox;
+    vector<unique_ptr<MessageBatch>> outboxes;
+    vector<PackedStateBin> successor_buffer;
+    vector<OperatorID> applicable_ops;
+
+    // Work created and consumed by this worker but not yet published.
+    int64_t unpublished_created_work;
+    int64_t unpublished_consumed_work;
+
+    void publish_created_work();
+    bool publish_work();
+    void send(int receiver, const Message& message);
+    void flush(int receiver);
+    void flush_all();
+    void receive_messages();
+    void expand_next_node();
+    void report_goal(const SearchNode& node);
+
+public:
+    HDAStarWorker(
+        int id,
+        const ClassicalPlanningTask& task,
+        const successor_generator::SuccessorGenerator& successor_generator,
+        SharedSearchData& shared,
+        const shared_ptr<Evaluator>& evaluator,
+        OperatorCost cost_type,
+        bool is_unit_cost,
+        int bound,
+        StatePacking state_packing);
+
+    /*
+      Add the state to the search space and the open list unless it is a
+      dead end or has already been reached with a g-value that is at least
+      as good. Returns true iff an open list entry was added. If local_parent
+      is given, the parent is registered in this worker's registry and
+      parent.creating_operator leads from it to the state.
+    */
+    bool insert_node(
+        const State& state,
+        int g,
+        int real_g,
+        const RemoteParent& parent,
+        const SearchNode* local_parent);
+
+    void run(const utils::CountdownTimer& timer);
+
+    RemoteParent get_remote_parent(const State& state)
+    {
+        return remote_parents[state];
+    }
+};
+
+HDAStarWorker::HDAStarWorker(
+    int id,
+    const ClassicalPlanningTask& task,
+    const successor_generator::SuccessorGenerator& successor_generator,
+    SharedSearchData& shared,
+    const shared_ptr<Evaluator>& evaluator,
+    OperatorCost cost_type,
+    bool is_unit_cost,
+    int bound,
+    StatePacking state_packing)
+    : id(id)
+    , task(task)
+    , successor_generator(successor_generator)
+    , shared(shared)
+    , cost_type(cost_type)
+    , is_unit_cost(is_unit_cost)
+    , bound(bound)
+    , log(utils::get_silent_log())
+    , state_registry(task, StateHashing::PACKED_DATA, nullptr, state_packing)
+    , search_space(state_registry, log)
+    , statistics(log)
+    , bins_per_state(state_registry.get_state_packer().get_num_bins())
+    , evaluator(evaluator)
+    , h_values(EvaluationResult::INFTY)
+    , successor_buffer(bins_per_state)
+    , unpublished_created_work(0)
+    , unpublished_consumed_work(0)
+{
+    open_list = search_common::create_astar_open_list_factory_and_f_eval(
+                    evaluator,
+                    utils::Verbosity::SILENT)
+                    .first->create_state_open_list();
+}
+
+bool HDAStarWorker::insert_node(
+    const State& state,
+    int g,
+    int real_g,
+    const RemoteParent& parent,
+    const SearchNode* local_parent)
+{
+    SearchNode node = search_space.get_node(state);
+    if (node.is_dead_end()) return false;
+    if (!node.is_new() && node.get_g() <= g) return false;
+
+    EvaluationContext eval_context(state, g, &statistics);
+    if (node.is_new()) {
+        statistics.inc_evaluated_states();
+        if (open_list->is_dead_end(eval_context)) {
+            node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+            return false;
+        }
+        h_values[state] =
+            eval_context.get_evaluator_value_or_infinity(evaluator.get());
+        node.open_without_parent(g, real_g);
+    } else {
+        if (node.is_closed()) {
+            statistics.inc_reopened();
+        }
+        node.reopen_without_parent(g, real_g);
+    }
+
+    if (local_parent) {
+        OperatorProxy op = task.get_operators()[parent.creating_operator];
+        node.update_parent(
+            *local_parent,
+            op,
+            get_adjusted_action_cost(op, cost_type, is_unit_cost));
+        assert(node.get_g() == g && node.get_real_g() == real_g);
+    } else {
+        remote_parents[state] = parent;
+    }
+    open_list->insert(eval_context, state.get_id());
+    return true;
+}
+
+void HDAStarWorker::publish_created_work()
+{
+    if (unpublished_created_work != 0) {
+        shared.pending_work.fetch_add(unpublished_created_work);
+        unpublished_created_work = 0;
+    }
+}
+
+/*
+  Publish all unpublished work. Consumed work may only be subtracted once
+  everything created from it is counted. Returns true iff the counter
+  changed.
+*/
+bool HDAStarWorker::publish_work()
+{
+    int64_t work_delta = unpublished_created_work - unpublished_consumed_work;
+    unpublished_created_work = 0;
+    unpublished_consumed_work = 0;
+    if (work_delta == 0) return false;
+    shared.pending_work.fetch_add(work_delta);
+    return true;
+}
+
+void HDAStarWorker::send(int receiver, const Message& message)
+{
+    unique_ptr<MessageBatch>& batch = outboxes[receiver];
+    if (!batch) {
+        batch = make_unique<MessageBatch>();
+        batch->messages.reserve(MESSAGE_BATCH_SIZE);
+        batch->buffers.reserve(MESSAGE_BATCH_SIZE * bins_per_state);
+    }
+    batch->messages.push_back(message);
+    ++unpublished_created_work;
+    batch->buffers.insert(
+        batch->buffers.end(),
+        successor_buffer.begin(),
+        successor_buffer.end());
+    if (batch->messages.size() >= MESSAGE_BATCH_SIZE) {
+        flush(receiver);
+    }
+}
+
+void HDAStarWorker::flush(int receiver)
+{
+    if (outboxes[receiver]) {
+        // The receiver may consume the batch as soon as it is pushed.
+        publish_created_work();
+        shared.workers[receiver]->mailbox.push(outboxes[receiver].release());
+    }
+}
+
+void HDAStarWorker::flush_all()
+{
+    for (size_t receiver = 0; receiver < outboxes.size(); ++receiver) {
+        flush(receiver);
+    }
+}
+
+void HDAStarWorker::receive_messages()
+{
+    MessageBatch* batch = mailbox.take_all();
+    while (batch) {
+        for (size_t i = 0; i < batch->messages.size(); ++i) {
+            const Message& message = batch->messages[i];
+            State state = state_registry.insert_packed_state(
+                &batch->buffers[i * bins_per_state]);
+            RemoteParent parent(
+                message.parent_worker,
+                message.parent_id,
+                message.creating_operator);
+            if (insert_node(
+                    state,
+                    message.g,
+                    message.real_g,
+                    parent,
+                    nullptr)) {
+                ++unpublished_created_work;
+            }
+        }
+        unpublished_consumed_work += batch->messages.size();
+        MessageBatch* next = batch->next;
+        delete batch;
+        batch = next;
+    }
+}
+
+void HDAStarWorker::report_goal(const SearchNode& node)
+{
+    lock_guard<mutex> lock(shared.goal_mutex);
+    if (node.get_g() < shared.incumbent_cost.load()) {
+        shared.incumbent_cost.store(node.get_g());
+        shared.goal_worker = id;
+        shared.goal_id = node.get_state().get_id();
+    }
+}
+
+void HDAStarWorker::expand_next_node()
+{
+    StateID state_id = open_list->remove_min();
+    ++unpublished_consumed_work;
+    State s = state_registry.lookup_state(state_id);
+    SearchNode node = search_space.get_node(s);
+    if (node.is_closed()) return;
+
+    // Nodes that cannot lead to a cheaper plan than the incumbent are pruned.
+    int h = h_values[s];
+    if (h == EvaluationResult::INFTY ||
+        node.get_g() + h >= shared.incumbent_cost.load(memory_order_relaxed)) {
+        return;
+    }
+
+    node.close();
+    statistics.inc_expanded();
+    if (task_properties::is_goal_state(task, s)) {
+        report_goal(node);
+        return;
+    }
+
+    const int_packer::IntPacker& state_packer =
+        state_registry.get_state_packer();
+    const flat_operator_table::FlatOperatorTable& flat_operators =
+        *state_registry.get_flat_operators();
+    const PackedStateBin* parent_buffer = state_registry.get_packed_state(s);
+    int num_workers = shared.workers.size();
+
+    applicable_ops.clear();
+    successor_generator.generate_applicable_ops(s, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        int op_cost = flat_operators.get_cost(op_id.get_index());
+        if ((node.get_real_g() + op_cost) >= bound) continue;
+
+        copy(
+            parent_buffer,
+            parent_buffer + bins_per_state,
+            successor_buffer.begin());
+        state_packer.visit_layout([&](const auto& vars) {
+            for (FactPair effect :
+                 flat_operators.get_effects(op_id.get_index())) {
+                vars.set(successor_buffer.data(), effect.var, effect.value);
+            }
+        });
+        statistics.inc_generated();
+
+        int succ_g = node.get_g() +
+                     get_adjusted_action_cost(op_cost, cost_type, is_unit_cost);
+        int succ_real_g = node.get_real_g() + op_cost;
+        int owner =
+            get_owner(successor_buffer.data(), bins_per_state, num_workers);
+        if (owner == id) {
+            State succ_state =
+                state_registry.insert_packed_state(successor_buffer.data());
+            RemoteParent parent(id, s.get_id(), op_id);
+            if (insert_node(succ_state, succ_g, succ_real_g, parent, &node)) {
+                ++unpublished_created_work;
+            }
+        } else {
+            send(owner, Message{succ_g, succ_real_g, id, s.get_id(), op_id});
+        }
+    }
+}
+
+void HDAStarWorker::run(const utils::CountdownTimer& timer)
+{
+    outboxes.resize(shared.workers.size());
+    int iterations = 0;
+    while (!shared.stop.load(memory_order_relaxed)) {
+        ++iterations;
+        if (id == 0 && iterations % TIMER_CHECK_INTERVAL == 0 &&
+            timer.is_expired()) {
+            shared.stop.store(true);
+            break;
+        }
+
+        receive_messages();
+        if (!open_list->empty()) {
+            expand_next_node();
+            if (iterations % FLUSH_INTERVAL == 0) {
+                flush_all();
+            }
+        } else {
+            flush_all();
+        }
+
+        if (!publish_work() && open_list->empty()) {
+            if (shared.pending_work.load() == 0) break;
+            this_thread::yield();
+        }
+    }
+}
+
+HDAStarSearch::HDAStarSearch(
+    const vector<shared_ptr<Evaluator>>& worker_evaluators,
+    shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , worker_evaluators(worker_evaluators)
+    , shared_data(make_unique<SharedSearchData>())
+{
+    assert(!worker_evaluators.empty());
+    set<Evaluator*> distinct_evaluators;
+    for (const shared_ptr<Evaluator>& evaluator : worker_evaluators) {
+        set<Evaluator*> path_dependent_evaluators;
+        evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "hda_astar does not support path-dependent evaluators."
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        distinct_evaluators.insert(evaluator.get());
+    }
+    if (distinct_evaluators.size() != worker_evaluators.size()) {
+        cerr << "hda_astar needs a separate evaluator for each thread. "
+             << "Evaluators bound to variables cannot be used." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+HDAStarSearch::~HDAStarSearch() = default;
+
+void HDAStarSearch::initialize()
+{
+    int num_workers = worker_evaluators.size();
+    if (log.is_at_least_normal()) {
+        log << "Conducting hash-distributed A* search with " << num_workers
+            << " thread(s), (real) bound = " << bound << endl;
+    }
+
+    /*
+      Everything that accesses global per-task data (state packers,
+      successor generators) has to be set up here, before the worker threads
+      are started.
+    */
+    for (int i = 0; i < num_workers; ++i) {
+        workers.push_back(make_unique<HDAStarWorker>(
+            i,
+            *task,
+            successor_generator,
+            *shared_data,
+            worker_evaluators[i],
+            cost_type,
+            is_unit_cost,
+            bound,
+            state_registry.get_state_packing()));
+        shared_data->workers.push_back(workers.back().get());
+    }
+
+    const State& initial_state = state_registry.get_initial_state();
+    const PackedStateBin* buffer =
+        state_registry.get_packed_state(initial_state);
+    int owner = get_owner(
+        buffer,
+        state_registry.get_state_packer().get_num_bins(),
+        num_workers);
+    HDAStarWorker& owning_worker = *workers[owner];
+    State owned_initial_state =
+        owning_worker.state_registry.insert_packed_state(buffer);
+    if (owning_worker.insert_node(
+            owned_initial_state,
+            0,
+            0,
+            RemoteParent(),
+            nullptr)) {
+        shared_data->pending_work.store(1);
+    } else if (log.is_at_least_normal()) {
+        log << "Initial state is a dead end." << endl;
+    }
+}
+
+SearchStatus HDAStarSearch::step()
+{
+    vector<thread> threads;
+    for (size_t i = 1; i < workers.size(); ++i) {
+        threads.emplace_back(
+            &HDAStarWorker::run,
+            workers[i].get(),
+            cref(*timer));
+    }
+    workers[0]->run(*timer);
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    collect_statistics();
+    bool timed_out = shared_data->stop.load();
+    if (shared_data->goal_worker != NO_WORKER) {
+        if (log.is_at_least_normal()) {
+            log << "Solution found!" << endl;
+            if (timed_out) {
+                log << "Search was interrupted, the solution might not be "
+                    << "optimal." << endl;
+            }
+        }
+        extract_plan();
+    } else if (!timed_out && log.is_at_least_normal()) {
+        log << "Completely explored state space -- no solution!" << endl;
+    }
+
+    if (timed_out) return TIMEOUT;
+    return found_solution() ? SOLVED : FAILED;
+}
+
+void HDAStarSearch::extract_plan()
+{
+    /*
+      Each worker can only trace the path back to the first state on it that
+      was reached from a state owned by another worker. We continue from
+      there in the registry of the parent until we reach the initial state.
+    */
+    vector<Plan> segments;
+    int worker_id = shared_data->goal_worker;
+    StateID state_id = shared_data->goal_id;
+    while (true) {
+        HDAStarWorker& worker = *workers[worker_id];
+        State state = worker.state_registry.lookup_state(state_id);
+        Plan segment;
+        vector<StateID> trajectory;
+        worker.search_space.trace_path(state, segment, trajectory);
+        RemoteParent parent = worker.get_remote_parent(
+            worker.state_registry.lookup_state(trajectory.front()));
+        if (parent.worker == NO_WORKER) {
+            segments.push_back(std::move(segment));
+            break;
+        }
+        segment.insert(segment.begin(), parent.creating_operator);
+        segments.push_back(std::move(segment));
+        worker_id = parent.worker;
+        state_id = parent.state_id;
+    }
+
+    Plan plan;
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        plan.insert(plan.end(), it->begin(), it->end());
+    }
+
+    // Register the goal state in our own registry for get_goal_state().
+    HDAStarWorker& goal_worker = *workers[shared_data->goal_worker];
+    State goal_state =
+        goal_worker.state_registry.lookup_state(shared_data->goal_id);
+    goal_id = state_registry
+                  .insert_packed_state(
+                      goal_worker.state_registry.get_packed_state(goal_state))
+                  .get_id();
+    set_plan(plan);
+}
+
+void HDAStarSearch::collect_statistics()
+{
+    for (const unique_ptr<HDAStarWorker>& worker : workers) {
+        const SearchStatistics& worker_statistics = worker->statistics;
+        statistics.inc_expanded(worker_statistics.get_expanded());
+        statistics.inc_evaluated_states(
+            worker_statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker_statistics.get_evaluations());
+        statistics.inc_generated(worker_statistics.get_generated());
+        statistics.inc_reopened(worker_statistics.get_reopened());
+        statistics.inc_dead_ends(worker_statistics.get_dead_ends());
+    }
+}
+
+void HDAStarSearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    size_t num_registered_states = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        const HDAStarWorker& worker = *workers[i];
+        if (log.is_at_least_verbose()) {
+            log << "Worker " << i << ": expanded "
+                << worker.statistics.get_expanded() << " state(s), registered "
+                << worker.state_registry.size() << " state(s)." << endl;
+        }
+        num_registered_states += worker.state_registry.size();
+    }
+    log << "Number of registered states: " << num_registered_states << endl;
+}
+} // namespace hda_astar
@@ -0,0 +1,208 @@
+#include "downward/search_algorithms/idastar.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace idastar {
+IDAStarSearch::IDAStarSearch(
+    const shared_ptr<Evaluator>& evaluator,
+    int transposition_table_size,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , evaluator(evaluator)
+    , iteration(0)
+    , threshold(0)
+    , next_threshold(EvaluationResult::INFTY)
+{
+    if (transposition_table_size > 0) {
+        transposition_table = make_unique<
+            transposition_table::TranspositionTable<TranspositionEntry>>(
+            state_registry.get_state_packer(),
+            transposition_table_size);
+    }
+}
+
+void IDAStarSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting IDA* search, (real) bound = " << bound << endl;
+    }
+    State initial_state = task->get_initial_state();
+    EvaluationContext eval_context(initial_state, 0, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+    if (search_progress.check_progress(eval_context)) {
+        statistics.print_checkpoint_line(0);
+    }
+    // The first iteration uses the f value of the initial state.
+    next_threshold =
+        eval_context.get_evaluator_value_or_infinity(evaluator.get());
+    if (next_threshold == EvaluationResult::INFTY) {
+        if (log.is_at_least_normal()) {
+            log << "Initial state is a dead end." << endl;
+        }
+        statistics.inc_dead_ends();
+    }
+}
+
+bool IDAStarSearch::is_on_path(const State& state) const
+{
+    const vector<int>& values = state.get_unpacked_values();
+    return any_of(path.begin(), path.end(), [&](const Frame& frame) {
+        return frame.state.get_unpacked_values() == values;
+    });
+}
+
+bool IDAStarSearch::is_transposition(const State& state, int g)
+{
+    if (!transposition_table) {
+        return false;
+    }
+    TranspositionEntry* entry =
+        transposition_table->find_or_insert(state, {g, -1});
+    if (!entry) {
+        return false;
+    }
+    if (entry->iteration == iteration && entry->g <= g) {
+        return true;
+    }
+    *entry = {g, iteration};
+    return false;
+}
+
+void IDAStarSearch::start_iteration()
+{
+    ++iteration;
+    threshold = next_threshold;
+    next_threshold = EvaluationResult::INFTY;
+    if (log.is_at_least_normal()) {
+        log << "Starting iteration " << iteration << " with f threshold "
+            << threshold << endl;
+    }
+    statistics.report_f_value_progress(threshold);
+}
+
+bool IDAStarSearch::push(
+    State&& state,
+    OperatorID creating_op,
+    int g,
+    int real_g)
+{
+    statistics.inc_expanded();
+    path.push_back(Frame{std::move(state), creating_op, g, real_g, {}});
+    Frame& frame = path.back();
+    if (task_properties::is_goal_state(*task, frame.state)) {
+        if (log.is_at_least_normal()) {
+            log << "Solution found!" << endl;
+        }
+        Plan plan;
+        for (size_t i = 1; i < path.size(); ++i) {
+            plan.push_back(path[i].creating_op);
+        }
+        set_plan(plan);
+        return true;
+    }
+    successor_generator.generate_applicable_ops(
+        frame.state,
+        frame.applicable_ops);
+    return false;
+}
+
+SearchStatus IDAStarSearch::step()
+{
+    if (path.empty()) {
+        if (next_threshold == EvaluationResult::INFTY) {
+            if (log.is_at_least_normal()) {
+                log << "Completely explored state space -- no solution!"
+                    << endl;
+            }
+            return FAILED;
+        }
+        start_iteration();
+        State initial_state = task->get_initial_state();
+        is_transposition(initial_state, 0);
+        if (push(std::move(initial_state), OperatorID::no_operator, 0, 0)) {
+            return SOLVED;
+        }
+        return IN_PROGRESS;
+    }
+
+    Frame& frame = path.back();
+    while (frame.next_op < frame.applicable_ops.size()) {
+        OperatorID op_id = frame.applicable_ops[frame.next_op++];
+        OperatorProxy op = task->get_operators()[op_id];
+        int succ_real_g = frame.real_g + op.get_cost();
+        if (succ_real_g >= bound) continue;
+
+        State succ_state = get_unregistered_successor(frame.state, op);
+        statistics.inc_generated();
+        int succ_g = frame.g + get_adjusted_cost(op);
+        if (is_on_path(succ_state) || is_transposition(succ_state, succ_g)) {
+            continue;
+        }
+
+        EvaluationContext eval_context(succ_state, succ_g, &statistics);
+        statistics.inc_evaluated_states();
+        int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+        if (h == EvaluationResult::INFTY) {
+            statistics.inc_dead_ends();
+            continue;
+        }
+        if (search_progress.check_progress(eval_context)) {
+            statistics.print_checkpoint_line(succ_g);
+        }
+        int f = succ_g + h;
+        if (f > threshold) {
+            next_threshold = min(next_threshold, f);
+            continue;
+        }
+        // Note that pushing invalidates frame.
+        if (push(std::move(succ_state), op_id, succ_g, succ_real_g)) {
+            return SOLVED;
+        }
+        return IN_PROGRESS;
+    }
+    path.pop_back();
+    return IN_PROGRESS;
+}
+
+void IDAStarSearch::print_statistics() const
+{
+    if (log.is_at_least_normal()) {
+        log << "IDA* iterations: " << iteration << endl;
+        if (transposition_table) {
+            transposition_table->print_statistics(log);
+        }
+    }
+    statistics.print_detailed_statistics();
+}
+} // namespace idastar
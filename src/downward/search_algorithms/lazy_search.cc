@@ -0,0 +1,221 @@
+#include "downward/search_algorithms/lazy_search.h"
+
+#include "downward/evaluator.h"
+#include "downward/open_list_factory.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/rng.h"
+#include "downward/utils/rng_options.h"
+
+#include <cassert>
+#include <set>
+
+using namespace std;
+
+namespace lazy_search {
+LazySearch::LazySearch(
+    const shared_ptr<OpenListFactory>& open,
+    bool reopen_closed,
+    bool randomize_successors,
+    int random_seed,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , open_list(open->create_edge_open_list())
+    , reopen_closed_nodes(reopen_closed)
+    , randomize_successors(randomize_successors)
+    , rng(utils::get_rng(random_seed))
+    , current_state(state_registry.get_initial_state())
+    , current_predecessor_id(StateID::no_state)
+    , current_operator_id(OperatorID::no_operator)
+    , current_g(0)
+    , current_real_g(0)
+    , current_eval_context(current_state, 0, &statistics)
+{
+}
+
+void LazySearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting lazy best first search"
+            << (reopen_closed_nodes ? " with" : " without")
+            << " reopening closed nodes, (real) bound = " << bound << endl;
+    }
+
+    assert(open_list);
+    set<Evaluator*> evals;
+    open_list->get_path_dependent_evaluators(evals);
+    path_dependent_evaluators.assign(evals.begin(), evals.end());
+    for (Evaluator* evaluator : path_dependent_evaluators) {
+        evaluator->notify_initial_state(current_state);
+    }
+}
+
+vector<OperatorID> LazySearch::get_successor_operators() const
+{
+    vector<OperatorID> applicable_operators;
+    successor_generator.generate_applicable_ops(
+        current_state,
+        applicable_operators);
+
+    if (randomize_successors) {
+        rng->shuffle(applicable_operators);
+    }
+    return applicable_operators;
+}
+
+void LazySearch::generate_successors()
+{
+    vector<OperatorID> successor_operators = get_successor_operators();
+
+    statistics.inc_generated(successor_operators.size());
+
+    for (OperatorID op_id : successor_operators) {
+        OperatorProxy op = task->get_operators()[op_id];
+        int new_g = current_g + get_adjusted_cost(op);
+        int new_real_g = current_real_g + op.get_cost();
+        if (new_real_g < bound) {
+            /*
+              The successor is keyed by the evaluator values of the current
+              state, which are copied from current_eval_context. It is only
+              generated and evaluated once it is removed from the open list.
+            */
+            EvaluationContext new_eval_context(
+                current_eval_context,
+                new_g,
+                nullptr);
+            open_list->insert(
+                new_eval_context,
+                make_pair(current_state.get_id(), op_id));
+        }
+    }
+}
+
+SearchStatus LazySearch::fetch_next_state()
+{
+    if (open_list->empty()) {
+        if (log.is_at_least_normal()) {
+            log << "Completely explored state space -- no solution!" << endl;
+        }
+        return FAILED;
+    }
+
+    EdgeOpenListEntry next = open_list->remove_min();
+
+    current_predecessor_id = next.first;
+    current_operator_id = next.second;
+    State current_predecessor =
+        state_registry.lookup_state(current_predecessor_id);
+    OperatorProxy current_operator =
+        task->get_operators()[current_operator_id];
+    assert(
+        task_properties::is_applicable(current_operator, current_predecessor));
+    current_state = state_registry.get_successor_state(
+        current_predecessor,
+        current_operator);
+
+    SearchNode pred_node = search_space.get_node(current_predecessor);
+    current_g = pred_node.get_g() + get_adjusted_cost(current_operator);
+    current_real_g = pred_node.get_real_g() + current_operator.get_cost();
+
+    current_eval_context =
+        EvaluationContext(current_state, current_g, &statistics);
+    return IN_PROGRESS;
+}
+
+SearchStatus LazySearch::step()
+{
+    /*
+      Invariants:
+      - current_state is the next state to be expanded
+      - current_operator_id is the operator which leads to current_state
+        (or no_operator for the initial state)
+      - current_predecessor_id is the predecessor of current_state
+        (or no_state for the initial state)
+    */
+    SearchNode node = search_space.get_node(current_state);
+    bool reopen = reopen_closed_nodes && !node.is_new() &&
+                  !node.is_dead_end() && (current_g < node.get_g());
+
+    if (node.is_new() || reopen) {
+        if (current_operator_id != OperatorID::no_operator) {
+            assert(current_predecessor_id != StateID::no_state);
+            if (!path_dependent_evaluators.empty()) {
+                State parent_state =
+                    state_registry.lookup_state(current_predecessor_id);
+                for (Evaluator* evaluator : path_dependent_evaluators) {
+                    evaluator->notify_state_transition(
+                        parent_state,
+                        current_operator_id,
+                        current_state);
+                }
+            }
+        }
+        statistics.inc_evaluated_states();
+        if (!open_list->is_dead_end(current_eval_context)) {
+            if (current_predecessor_id == StateID::no_state) {
+                node.open_initial();
+                if (search_progress.check_progress(current_eval_context))
+                    statistics.print_checkpoint_line(current_g);
+            } else {
+                State parent_state =
+                    state_registry.lookup_state(current_predecessor_id);
+                SearchNode parent_node = search_space.get_node(parent_state);
+                OperatorProxy current_operator =
+                    task->get_operators()[current_operator_id];
+                if (reopen) {
+                    node.reopen(
+                        parent_node,
+                        current_operator,
+                        get_adjusted_cost(current_operator));
+                    statistics.inc_reopened();
+                } else {
+                    node.open(
+                        parent_node,
+                        current_operator,
+                        get_adjusted_cost(current_operator));
+                }
+            }
+            node.close();
+            if (check_goal_and_set_plan(current_state)) return SOLVED;
+            if (search_progress.check_progress(current_eval_context))
+                statistics.print_checkpoint_line(current_g);
+            generate_successors();
+            statistics.inc_expanded();
+        } else {
+            node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+        }
+        if (current_predecessor_id == StateID::no_state) {
+            print_initial_evaluator_values(current_eval_context);
+        }
+    }
+    return fetch_next_state();
+}
+
+void LazySearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    search_space.print_statistics();
+}
+} // namespace lazy_search
@@ -0,0 +1,82 @@
+#include "downward/search_algorithms/anytime_wastar.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_anytime_wastar {
+class AnytimeWAstarSearchFeature
+    : public plugins::
+          TypedFeature<SearchAlgorithm, anytime_wastar::AnytimeWAstarSearch> {
+public:
+    AnytimeWAstarSearchFeature()
+        : TypedFeature("anytime_wastar")
+    {
+        document_title("Anytime weighted A* search");
+        document_synopsis(
+            "Restarting weighted A* search that improves its plan within a "
+            "single planner process. It runs weighted A* with each of the "
+            "given weights in turn. Every plan is saved as soon as it is "
+            "found and its cost becomes the bound for the remaining "
+            "iterations, so each saved plan is cheaper than the previous one. "
+            "The search stops when an iteration finds no cheaper plan.");
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+        add_list_option<int>(
+            "weights",
+            "weights of the iterations",
+            "[5, 3, 2, 1]");
+        add_option<bool>(
+            "repeat_last_weight",
+            "keep searching with the last weight after it found a plan, "
+            "until no cheaper plan is found",
+            "true");
+        add_option<bool>(
+            "reuse_search_space",
+            "keep the g values and parents of the states reached in earlier "
+            "iterations. Otherwise, each iteration starts from scratch. The "
+            "state registry is always shared by all iterations.",
+            "true");
+        add_search_algorithm_options_to_feature(*this, "anytime_wastar");
+
+        document_note(
+            "Plan files",
+            "The plans are written to FILENAME.1, FILENAME.2, ... where "
+            "FILENAME is the plan file name (sas_plan by default).");
+        document_note(
+            "Heuristic values",
+            "All iterations use the same evaluator object and state "
+            "registry, so evaluators that cache values per state keep their "
+            "caches between iterations. Otherwise, states that are reached "
+            "again in later iterations are evaluated again.");
+        document_note(
+            "Optimality",
+            "Each iteration reopens closed states when it finds cheaper "
+            "paths to them, so an iteration that finds no plan proves that "
+            "no cheaper plan exists.");
+    }
+
+    virtual shared_ptr<anytime_wastar::AnytimeWAstarSearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context& context) const override
+    {
+        plugins::verify_list_non_empty<int>(context, opts, "weights");
+        for (int weight : opts.get_list<int>("weights")) {
+            if (weight < 0) {
+                context.error(
+                    "List argument 'weights' must not contain negative "
+                    "weights.");
+            }
+        }
+        return plugins::make_shared_from_arg_tuples<
+            anytime_wastar::AnytimeWAstarSearch>(
+            opts.get<shared_ptr<Evaluator>>("eval"),
+            opts.get_list<int>("weights"),
+            opts.get<bool>("repeat_last_weight"),
+            opts.get<bool>("reuse_search_space"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<AnytimeWAstarSearchFeature> _plugin;
+} // namespace plugin_anytime_wastar
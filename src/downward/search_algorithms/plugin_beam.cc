@@ -0,0 +1,56 @@
+#include "downward/search_algorithms/beam_search.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_beam {
+class BeamSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, beam_search::BeamSearch> {
+public:
+    BeamSearchFeature()
+        : TypedFeature("beam")
+    {
+        document_title("Beam search");
+        document_synopsis(
+            "Breadth-first search that only keeps the best states of every "
+            "layer according to the evaluator. It trades plan quality and "
+            "completeness for memory that is linear in the width times the "
+            "plan length. With a blind evaluator, it is a bounded-width "
+            "breadth-first search.");
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+        add_option<int>(
+            "width",
+            "number of states kept per layer",
+            "100",
+            plugins::Bounds("1", "infinity"));
+        add_option<bool>(
+            "filter_duplicates",
+            "discard successors that equal a state of the current or the "
+            "previous layer or another successor in the same layer",
+            "true");
+        add_search_algorithm_options_to_feature(*this, "beam");
+
+        document_note(
+            "Termination",
+            "The search fails when no successor of the current layer "
+            "survives. Since earlier layers are forgotten, it can run in "
+            "circles forever, so use it with a time limit (max_time) or a "
+            "bound.");
+    }
+
+    virtual shared_ptr<beam_search::BeamSearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context&) const override
+    {
+        return plugins::make_shared_from_arg_tuples<beam_search::BeamSearch>(
+            opts.get<shared_ptr<Evaluator>>("eval"),
+            opts.get<int>("width"),
+            opts.get<bool>("filter_duplicates"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<BeamSearchFeature> _plugin;
+} // namespace plugin_beam
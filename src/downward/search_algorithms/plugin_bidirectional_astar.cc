@@ -0,0 +1,50 @@
+#include "downward/search_algorithms/bidirectional_astar.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_bidirectional_astar {
+class BidirectionalAStarSearchFeature
+    : public plugins::TypedFeature<
+          SearchAlgorithm,
+          bidirectional_astar::BidirectionalAStarSearch> {
+public:
+    BidirectionalAStarSearchFeature()
+        : TypedFeature("bidirectional_astar")
+    {
+        document_title("Bidirectional A* search");
+        document_synopsis(
+            "Bidirectional heuristic search with the MM algorithm. A forward "
+            "search from the initial state and a backward search that "
+            "regresses partial states from the goal meet in the middle. "
+            "Both directions expand nodes in the order of max(f, 2g).");
+
+        add_option<shared_ptr<Evaluator>>(
+            "eval",
+            "evaluator for the h-value of the forward search");
+        add_search_algorithm_options_to_feature(*this, "bidirectional_astar");
+
+        document_note(
+            "Backward heuristic",
+            "Evaluators estimate the distance of states to the goal, so the "
+            "backward search has no heuristic. Its f value equals its g "
+            "value.");
+        document_note(
+            "Optimality",
+            "With an admissible evaluator, the plan is optimal.");
+    }
+
+    virtual shared_ptr<bidirectional_astar::BidirectionalAStarSearch>
+    create_component(const plugins::Options& opts, const utils::Context&)
+        const override
+    {
+        return plugins::make_shared_from_arg_tuples<
+            bidirectional_astar::BidirectionalAStarSearch>(
+            opts.get<shared_ptr<Evaluator>>("eval"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<BidirectionalAStarSearchFeature> _plugin;
+} // namespace plugin_bidirectional_astar
@@ -0,0 +1,86 @@
+#include "downward/search_algorithms/external_bfs.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_external_bfs {
+class ExternalBFSSearchFeature
+    : public plugins::
+          TypedFeature<SearchAlgorithm, external_bfs::ExternalBFSSearch> {
+public:
+    ExternalBFSSearchFeature()
+        : TypedFeature("external_bfs")
+    {
+        document_title("External breadth-first search");
+        document_synopsis(
+            "Breadth-first search with delayed duplicate detection that "
+            "stores the layers of the search in sorted files of packed "
+            "states. It only needs memory for its buffers, so it can "
+            "explore state spaces that do not fit into memory.");
+
+        add_option<string>(
+            "scratch_dir",
+            "directory in which a temporary directory for the layer and run "
+            "files is created. The temporary directory is removed when the "
+            "search ends.",
+            "\".\"");
+        add_option<int>(
+            "buffer_size",
+            "number of successor states that are sorted in memory before "
+            "they are written to a run file",
+            "1000000",
+            plugins::Bounds("1", "infinity"));
+        add_option<int>(
+            "io_buffer_size",
+            "number of states read or written at once per open file",
+            "4096",
+            plugins::Bounds("1", "infinity"));
+        add_option<int>(
+            "merge_fan_in",
+            "maximum number of run files that are merged at once. With more "
+            "runs, they are merged in several passes, each of which reads "
+            "and writes all successors of the layer once more. Every open "
+            "file needs a buffer of io_buffer_size states and a file "
+            "descriptor.",
+            "64",
+            plugins::Bounds("2", "infinity"));
+        add_option<int>(
+            "locality",
+            "number of previous layers whose states are removed from a new "
+            "layer. In state spaces in which every operator can be undone, "
+            "2 suffices. With fewer layers than the longest back edge of "
+            "the state space, states are expanded repeatedly and the search "
+            "might not terminate on unsolvable tasks.",
+            "infinity",
+            plugins::Bounds("1", "infinity"));
+        add_search_algorithm_options_to_feature(*this, "external_bfs");
+
+        document_note(
+            "Optimality",
+            "The search finds plans with the fewest operators, which are "
+            "optimal for tasks with unit costs. Of these plans, it finds a "
+            "cheapest one.");
+        document_note(
+            "Statistics",
+            "The bytes read and written and the time spent merging files "
+            "are reported with the other statistics.");
+    }
+
+    virtual shared_ptr<external_bfs::ExternalBFSSearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context&) const override
+    {
+        return plugins::make_shared_from_arg_tuples<
+            external_bfs::ExternalBFSSearch>(
+            opts.get<string>("scratch_dir"),
+            opts.get<int>("buffer_size"),
+            opts.get<int>("io_buffer_size"),
+            opts.get<int>("merge_fan_in"),
+            opts.get<int>("locality"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<ExternalBFSSearchFeature> _plugin;
+} // namespace plugin_external_bfs
@@ -0,0 +1,66 @@
+#include "downward/search_algorithms/hda_astar.h"
+
+#include "downward/parser/decorated_abstract_syntax_tree.h"
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_hda_astar {
+class HDAStarSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, hda_astar::HDAStarSearch> {
+public:
+    HDAStarSearchFeature()
+        : TypedFeature("hda_astar")
+    {
+        document_title("Hash-distributed A* search");
+        document_synopsis(
+            "Parallel A* search that partitions the state space among "
+            "several threads by a hash of the state. Each thread runs A* "
+            "on its own partition with its own open list and sends "
+            "generated states it does not own to the owning thread. "
+            "Accepts the same options as astar (except lazy_evaluator), "
+            "so astar(h) can be switched to the parallel engine by "
+            "replacing it with hda_astar(h, threads=N).");
+
+        add_option<shared_ptr<Evaluator>>(
+            "eval",
+            "evaluator for h-value. It is constructed once per thread.",
+            "",
+            plugins::Bounds::unlimited(),
+            true);
+        add_option<int>(
+            "threads",
+            "number of worker threads",
+            "1",
+            plugins::Bounds("1", "infinity"));
+        add_search_algorithm_options_to_feature(*this, "hda_astar");
+
+        document_note(
+            "Evaluators",
+            "Evaluators are not thread-safe, so each thread needs its own "
+            "instance of eval. This rules out evaluators bound to variables "
+            "with let and path-dependent evaluators.");
+        document_note(
+            "Time limit",
+            "max_time is measured in CPU time of the whole process, i.e., "
+            "summed over all threads.");
+    }
+
+    virtual shared_ptr<hda_astar::HDAStarSearch>
+    create_component(const plugins::Options& opts, const utils::Context&)
+        const override
+    {
+        parser::LazyValue lazy_eval = opts.get<parser::LazyValue>("eval");
+        vector<shared_ptr<Evaluator>> worker_evaluators;
+        for (int i = 0; i < opts.get<int>("threads"); ++i) {
+            worker_evaluators.push_back(
+                lazy_eval.construct<shared_ptr<Evaluator>>());
+        }
+        return plugins::make_shared_from_arg_tuples<hda_astar::HDAStarSearch>(
+            worker_evaluators,
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<HDAStarSearchFeature> _plugin;
+} // namespace plugin_hda_astar
@@ -0,0 +1,47 @@
+#include "downward/search_algorithms/idastar.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_idastar {
+class IDAStarSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, idastar::IDAStarSearch> {
+public:
+    IDAStarSearchFeature()
+        : TypedFeature("idastar")
+    {
+        document_title("IDA* search");
+        document_synopsis(
+            "Iterative deepening A* search. It runs a series of depth-first "
+            "searches with increasing f thresholds and only keeps the current "
+            "path in memory. States are not registered in the state registry.");
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+        add_option<int>(
+            "transposition_table_size",
+            "maximum number of states in the transposition table, which "
+            "prunes states that were already reached at most as cheaply in "
+            "the current iteration. 0 disables the table.",
+            "0",
+            plugins::Bounds("0", "infinity"));
+        add_search_algorithm_options_to_feature(*this, "idastar");
+
+        document_note(
+            "Optimality",
+            "With an admissible evaluator, the first plan found is optimal.");
+    }
+
+    virtual shared_ptr<idastar::IDAStarSearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context&) const override
+    {
+        return plugins::make_shared_from_arg_tuples<idastar::IDAStarSearch>(
+            opts.get<shared_ptr<Evaluator>>("eval"),
+            opts.get<int>("transposition_table_size"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<IDAStarSearchFeature> _plugin;
+} // namespace plugin_idastar
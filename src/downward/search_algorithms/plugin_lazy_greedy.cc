@@ -0,0 +1,59 @@
+#include "downward/search_algorithms/lazy_search.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_lazy_greedy {
+class LazyGreedySearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, lazy_search::LazySearch> {
+public:
+    LazyGreedySearchFeature()
+        : TypedFeature("lazy_greedy")
+    {
+        document_title("Greedy search (lazy)");
+        document_synopsis("");
+
+        add_list_option<shared_ptr<Evaluator>>("evals", "evaluators");
+        add_option<bool>("reopen_closed", "reopen closed nodes", "false");
+        add_successors_order_options_to_feature(*this);
+        add_search_algorithm_options_to_feature(*this, "lazy_greedy");
+
+        document_note(
+            "Open lists",
+            "In most cases, lazy greedy best first search uses "
+            "an alternation open list with one queue for each evaluator. "
+            "If only one evaluator is used, the search does not use an "
+            "alternation open list but a standard open list with only one "
+            "queue. No evaluator computes preferred operators yet, so "
+            "there are no queues restricted to preferred successors.");
+        document_note(
+            "Deferred evaluation",
+            "Successors are inserted into the open list with the "
+            "evaluator values of their parent. A state is only generated "
+            "and evaluated when it is removed from the open list.");
+    }
+
+    virtual shared_ptr<lazy_search::LazySearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context& context) const override
+    {
+        plugins::verify_list_non_empty<shared_ptr<Evaluator>>(
+            context,
+            opts,
+            "evals");
+
+        return plugins::make_shared_from_arg_tuples<lazy_search::LazySearch>(
+            search_common::create_greedy_open_list_factory(
+                opts.get_list<shared_ptr<Evaluator>>("evals"),
+                {},
+                0),
+            opts.get<bool>("reopen_closed"),
+            get_successors_order_arguments_from_options(opts),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<LazyGreedySearchFeature> _plugin;
+} // namespace plugin_lazy_greedy
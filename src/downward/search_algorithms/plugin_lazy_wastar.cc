@@ -0,0 +1,65 @@
+#include "downward/search_algorithms/lazy_search.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_lazy_wastar {
+class LazyWAstarSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, lazy_search::LazySearch> {
+public:
+    LazyWAstarSearchFeature()
+        : TypedFeature("lazy_wastar")
+    {
+        document_title("(Weighted) A* search (lazy)");
+        document_synopsis(
+            "Weighted A* is a special case of lazy best first search.");
+
+        add_list_option<shared_ptr<Evaluator>>("evals", "evaluators");
+        add_option<bool>("reopen_closed", "reopen closed nodes", "true");
+        add_option<int>("w", "evaluator weight", "1");
+        add_successors_order_options_to_feature(*this);
+        add_search_algorithm_options_to_feature(*this, "lazy_wastar");
+
+        document_note(
+            "Open lists",
+            "In the general case, it uses an alternation open list "
+            "with one queue for each evaluator h that ranks the nodes "
+            "by g + w * h. In the special case with only one evaluator, "
+            "it uses a single queue that is ranked by g + w * h. ");
+        document_note(
+            "Equivalent statements using general lazy search",
+            "\n```\n--evaluator h1=eval1\n"
+            "--search lazy_wastar([h1, eval2], w=2)\n```\n"
+            "is equivalent to\n"
+            "```\n--evaluator h1=eval1\n"
+            "--search lazy_greedy([sum([g(), weight(h1, 2)]), "
+            "sum([g(), weight(eval2, 2)])], reopen_closed=true)\n```\n",
+            true);
+    }
+
+    virtual shared_ptr<lazy_search::LazySearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context& context) const override
+    {
+        plugins::verify_list_non_empty<shared_ptr<Evaluator>>(
+            context,
+            opts,
+            "evals");
+
+        return plugins::make_shared_from_arg_tuples<lazy_search::LazySearch>(
+            search_common::create_wastar_open_list_factory(
+                opts.get_list<shared_ptr<Evaluator>>("evals"),
+                {},
+                0,
+                opts.get<int>("w"),
+                opts.get<utils::Verbosity>("verbosity")),
+            opts.get<bool>("reopen_closed"),
+            get_successors_order_arguments_from_options(opts),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<LazyWAstarSearchFeature> _plugin;
+} // namespace plugin_lazy_wastar
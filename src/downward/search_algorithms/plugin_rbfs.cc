@@ -0,0 +1,49 @@
+#include "downward/search_algorithms/rbfs.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_rbfs {
+class RBFSSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, rbfs::RBFSSearch> {
+public:
+    RBFSSearchFeature()
+        : TypedFeature("rbfs")
+    {
+        document_title("Recursive best-first search");
+        document_synopsis(
+            "Best-first search that only keeps the current path and the "
+            "siblings of the states on it in memory. Abandoned subtrees are "
+            "summarized by the smallest f value on their frontier. States are "
+            "not registered in the state registry.");
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+        add_option<int>(
+            "transposition_table_size",
+            "maximum number of states in the transposition table, which "
+            "remembers the backed-up values of abandoned subtrees. With the "
+            "table, the search only prunes states on the current path if "
+            "they close a cycle of cost 0. 0 disables the table.",
+            "0",
+            plugins::Bounds("0", "infinity"));
+        add_search_algorithm_options_to_feature(*this, "rbfs");
+
+        document_note(
+            "Optimality",
+            "With an admissible evaluator, the first plan found is optimal.");
+    }
+
+    virtual shared_ptr<rbfs::RBFSSearch> create_component(
+        const plugins::Options& opts,
+        const utils::Context&) const override
+    {
+        return plugins::make_shared_from_arg_tuples<rbfs::RBFSSearch>(
+            opts.get<shared_ptr<Evaluator>>("eval"),
+            opts.get<int>("transposition_table_size"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<RBFSSearchFeature> _plugin;
+} // namespace plugin_rbfs
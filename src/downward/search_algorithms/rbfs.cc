@@ -0,0 +1,318 @@
+#include "downward/search_algorithms/rbfs.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace rbfs {
+RBFSSearch::RBFSSearch(
+    const shared_ptr<Evaluator>& evaluator,
+    int transposition_table_size,
+    std::shared_ptr<ClassicalPlanningTask> task,
+    OperatorCost cost_type,
+    int bound,
+    double max_time,
+    StateHashing state_hashing,
+    const shared_ptr<StateStorage>& state_storage,
+    StatePacking state_packing,
+    SuccessorGeneratorType successor_generator_type,
+    const string& description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          std::move(task),
+          cost_type,
+          bound,
+          max_time,
+          state_hashing,
+          state_storage,
+          state_packing,
+          successor_generator_type,
+          description,
+          verbosity)
+    , evaluator(evaluator)
+{
+    if (transposition_table_size > 0) {
+        transposition_table =
+            make_unique<transposition_table::TranspositionTable<int>>(
+                state_registry.get_state_packer(),
+                transposition_table_size);
+    }
+}
+
+void RBFSSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting RBFS search, (real) bound = " << bound << endl;
+    }
+}
+
+int RBFSSearch::get_depth_on_path(const State& state) const
+{
+    const vector<int>& values = state.get_unpacked_values();
+    auto it = find_if(path.begin(), path.end(), [&](const Frame& frame) {
+        return frame.state.get_unpacked_values() == values;
+    });
+    return it == path.end() ? -1 : it - path.begin();
+}
+
+/*
+  A pruned successor is only needed if no other one with at most its depth
+  has at most its f value, because the one with the smaller depth matters
+  for at least as many frames.
+*/
+template <typename PrunedSuccessor>
+static void add_pruned_successor(
+    vector<PrunedSuccessor>& pruned_successors,
+    PrunedSuccessor pruned)
+{
+    for (const PrunedSuccessor& other : pruned_successors) {
+        if (other.depth <= pruned.depth && other.f <= pruned.f) {
+            return;
+        }
+    }
+    erase_if(pruned_successors, [&](const PrunedSuccessor& other) {
+        return other.depth >= pruned.depth && other.f >= pruned.f;
+    });
+    auto pos = find_if(
+        pruned_successors.begin(),
+        pruned_successors.end(),
+        [&](const PrunedSuccessor& other) {
+            return other.depth > pruned.depth;
+        });
+    pruned_successors.insert(pos, pruned);
+}
+
+bool RBFSSearch::push(
+    State&& state,
+    OperatorID creating_op,
+    int g,
+    int real_g,
+    int f,
+    int backed_up_f,
+    int f_limit)
+{
+    statistics.inc_expanded();
+    statistics.report_f_value_progress(backed_up_f);
+    /*
+      A backed-up value above the static one was inherited from an earlier
+      search of the subtree. It may depend on the successors pruned there,
+      which the parent remembers.
+    */
+    vector<PrunedSuccessor> pruned_successors;
+    if (backed_up_f > f && !path.empty()) {
+        pruned_successors = path.back().pruned_successors;
+    }
+    path.push_back(Frame{
+        std::move(state),
+        creating_op,
+        g,
+        real_g,
+        f - g,
+        f_limit,
+        {},
+        -1,
+        std::move(pruned_successors)});
+    Frame& frame = path.back();
+    if (task_properties::is_goal_state(*task, frame.state)) {
+        if (log.is_at_least_normal()) {
+            log << "Solution found!" << endl;
+        }
+        Plan plan;
+        for (size_t i = 1; i < path.size(); ++i) {
+            plan.push_back(path[i].creating_op);
+        }
+        set_plan(plan);
+        return true;
+    }
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(frame.state, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task->get_operators()[op_id];
+        int succ_g = g + get_adjusted_cost(op);
+        if (real_g + op.get_cost() >= bound) {
+            if (transposition_table) {
+                add_pruned_successor(
+                    frame.pruned_successors,
+                    PrunedSuccessor{-1, succ_g});
+            }
+            continue;
+        }
+
+        State succ_state = get_unregistered_successor(frame.state, op);
+        statistics.inc_generated();
+        int succ_depth = get_depth_on_path(succ_state);
+        if (succ_depth != -1) {
+            if (!transposition_table) {
+                continue;
+            }
+            // Cycles with positive cost end when they exceed the f limit.
+            if (path[succ_depth].g == succ_g) {
+                add_pruned_successor(
+                    frame.pruned_successors,
+                    PrunedSuccessor{succ_depth, succ_g + path[succ_depth].h});
+                continue;
+            }
+        }
+
+        EvaluationContext eval_context(succ_state, succ_g, &statistics);
+        statistics.inc_evaluated_states();
+        int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+        if (h == EvaluationResult::INFTY) {
+            statistics.inc_dead_ends();
+            continue;
+        }
+        if (search_progress.check_progress(eval_context)) {
+            statistics.print_checkpoint_line(succ_g);
+        }
+        if (transposition_table) {
+            // Use what earlier visits learned about the cost-to-go.
+            const int* learned_h = transposition_table->find(succ_state);
+            if (learned_h) {
+                h = max(h, *learned_h);
+            }
+        }
+        int succ_f = succ_g + h;
+        /*
+          If the backed-up value of this state exceeds its static value, the
+          subtree has been searched before, and no child can have a smaller
+          value than the backed-up one.
+        */
+        int succ_backed_up_f = f < backed_up_f ? max(backed_up_f, succ_f)
+                                                : succ_f;
+        frame.children.push_back(Child{op_id, succ_f, succ_backed_up_f});
+    }
+    return false;
+}
+
+void RBFSSearch::pop(int backed_up_f)
+{
+    Frame& frame = path.back();
+    int depth = path.size() - 1;
+    /*
+      Paths through successors that are pruned at this frame or below it
+      contain a cycle, so they do not matter for this frame.
+    */
+    erase_if(frame.pruned_successors, [&](const PrunedSuccessor& pruned) {
+        return pruned.depth >= depth;
+    });
+    int lower_bound = backed_up_f;
+    if (!frame.pruned_successors.empty()) {
+        lower_bound = min(lower_bound, frame.pruned_successors.back().f);
+    }
+    if (transposition_table && lower_bound != EvaluationResult::INFTY) {
+        int learned_h = lower_bound - frame.g;
+        int* entry =
+            transposition_table->find_or_insert(frame.state, learned_h);
+        if (entry) {
+            *entry = max(*entry, learned_h);
+        }
+    }
+    vector<PrunedSuccessor> pruned_successors =
+        std::move(frame.pruned_successors);
+    path.pop_back();
+    if (!path.empty()) {
+        Frame& parent = path.back();
+        assert(parent.active_child != -1);
+        parent.children[parent.active_child].backed_up_f = backed_up_f;
+        for (const PrunedSuccessor& pruned : pruned_successors) {
+            add_pruned_successor(parent.pruned_successors, pruned);
+        }
+    }
+}
+
+SearchStatus RBFSSearch::step()
+{
+    if (path.empty()) {
+        State initial_state = task->get_initial_state();
+        EvaluationContext eval_context(initial_state, 0, &statistics);
+        statistics.inc_evaluated_states();
+        print_initial_evaluator_values(eval_context);
+        if (search_progress.check_progress(eval_context)) {
+            statistics.print_checkpoint_line(0);
+        }
+        int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+        if (h == EvaluationResult::INFTY) {
+            if (log.is_at_least_normal()) {
+                log << "Initial state is a dead end." << endl;
+            }
+            statistics.inc_dead_ends();
+            return FAILED;
+        }
+        if (push(
+                std::move(initial_state),
+                OperatorID::no_operator,
+                0,
+                0,
+                h,
+                h,
+                EvaluationResult::INFTY)) {
+            return SOLVED;
+        }
+        return IN_PROGRESS;
+    }
+
+    Frame& frame = path.back();
+    int best = -1;
+    int second_best_f = EvaluationResult::INFTY;
+    for (size_t i = 0; i < frame.children.size(); ++i) {
+        int child_f = frame.children[i].backed_up_f;
+        if (best == -1 || child_f < frame.children[best].backed_up_f) {
+            if (best != -1) {
+                second_best_f = frame.children[best].backed_up_f;
+            }
+            best = i;
+        } else if (child_f < second_best_f) {
+            second_best_f = child_f;
+        }
+    }
+
+    int best_f = best == -1 ? EvaluationResult::INFTY
+                            : frame.children[best].backed_up_f;
+    if (best_f == EvaluationResult::INFTY || best_f > frame.f_limit) {
+        pop(best_f);
+        if (path.empty()) {
+            if (log.is_at_least_normal()) {
+                log << "Completely explored state space -- no solution!"
+                    << endl;
+            }
+            return FAILED;
+        }
+        return IN_PROGRESS;
+    }
+
+    const Child& child = frame.children[best];
+    frame.active_child = best;
+    OperatorProxy op = task->get_operators()[child.op];
+    State succ_state = get_unregistered_successor(frame.state, op);
+    // Note that pushing invalidates frame and child.
+    if (push(
+            std::move(succ_state),
+            child.op,
+            frame.g + get_adjusted_cost(op),
+            frame.real_g + op.get_cost(),
+            child.f,
+            child.backed_up_f,
+            min(frame.f_limit, second_best_f))) {
+        return SOLVED;
+    }
+    return IN_PROGRESS;
+}
+
+void RBFSSearch::print_statistics() const
+{
+    if (log.is_at_least_normal() && transposition_table) {
+        transposition_table->print_statistics(log);
+    }
+    statistics.print_detailed_statistics();
+}
+} // namespace rbfs
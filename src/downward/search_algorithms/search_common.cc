@@ -8,7 +8,7 @@
 
 #include "downward/open_lists/alternation_open_list.h"
 #include "downward/open_lists/best_first_open_list.h"
-#include "downward/open_lists/tiebreaking_open_list.h"
+#include "downward/open_lists/bucket_open_list.h"
 
 #include <memory>
 
@@ -126,9 +126,7 @@ create_astar_open_list_factory_and_f_eval(
     vector<shared_ptr<Evaluator>> evals = {f, h_eval};
 
     shared_ptr<OpenListFactory> open =
-        make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(
-            evals,
-            false);
+        make_shared<bucket_open_list::BucketOpenListFactory>(evals, false);
     return make_pair(open, f);
 }
 } // namespace search_common
@@ -3,244 +3,566 @@
 #include "downward/search_node_info.h"
 #include "downward/task_proxy.h"
 
+#include "downward/task_utils/flat_operator_table.h"
 #include "downward/task_utils/task_properties.h"
 #include "downward/utils/logging.h"
+#include "downward/utils/system.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <unordered_set>
 
 using namespace std;
 
-SearchNode::SearchNode(const State& state, SearchNodeInfo& info)
+template <typename NodeInfo>
+BasicSearchNode<NodeInfo>::BasicSearchNode(const State& state, NodeInfo& info)
     : state(state)
     , info(info)
 {
     assert(state.get_id() != StateID::no_state);
 }
 
-const State& SearchNode::get_state() const
+template <typename NodeInfo>
+const State& BasicSearchNode<NodeInfo>::get_state() const
 {
     return state;
 }
 
-bool SearchNode::is_open() const
+template <typename NodeInfo>
+bool BasicSearchNode<NodeInfo>::is_open() const
 {
-    return info.status == SearchNodeInfo::OPEN;
+    return info.status == NodeInfo::OPEN;
 }
 
-bool SearchNode::is_closed() const
+template <typename NodeInfo>
+bool BasicSearchNode<NodeInfo>::is_closed() const
 {
-    return info.status == SearchNodeInfo::CLOSED;
+    return info.status == NodeInfo::CLOSED;
 }
 
-bool SearchNode::is_dead_end() const
+template <typename NodeInfo>
+bool BasicSearchNode<NodeInfo>::is_dead_end() const
 {
-    return info.status == SearchNodeInfo::DEAD_END;
+    return info.status == NodeInfo::DEAD_END;
 }
 
-bool SearchNode::is_new() const
+template <typename NodeInfo>
+bool BasicSearchNode<NodeInfo>::is_new() const
 {
-    return info.status == SearchNodeInfo::NEW;
+    return info.status == NodeInfo::NEW;
 }
 
-int SearchNode::get_g() const
+template <typename NodeInfo>
+int BasicSearchNode<NodeInfo>::get_g() const
 {
     assert(info.g >= 0);
     return info.g;
 }
 
-int SearchNode::get_real_g() const
+template <typename NodeInfo>
+int BasicSearchNode<NodeInfo>::get_real_g() const
 {
-    return info.real_g;
+    if constexpr (NodeInfo::stores_real_g) {
+        return info.real_g;
+    } else {
+        return info.g;
+    }
 }
 
-void SearchNode::open_initial()
+/*
+  Set g, real g and the parent pointers of a node, ignoring the fields that
+  are not stored.
+*/
+template <typename NodeInfo>
+static void set_g_and_parent(
+    NodeInfo& info,
+    int g,
+    int real_g,
+    StateID parent_state_id,
+    OperatorID creating_operator)
 {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    info.g = g;
+    if constexpr (NodeInfo::stores_real_g) {
+        info.real_g = real_g;
+    } else {
+        assert(real_g == g);
+    }
+    if constexpr (NodeInfo::stores_parent) {
+        info.parent_state_id = parent_state_id;
+        info.creating_operator = creating_operator;
+    }
 }
 
-void SearchNode::open(
-    const SearchNode& parent_node,
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::open_initial()
+{
+    assert(info.status == NodeInfo::NEW);
+    info.status = NodeInfo::OPEN;
+    set_g_and_parent(info, 0, 0, StateID::no_state, OperatorID::no_operator);
+}
+
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::open(
+    const BasicSearchNode& parent_node,
     const OperatorProxy& parent_op,
     int adjusted_cost)
 {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    assert(info.status == NodeInfo::NEW);
+    info.status = NodeInfo::OPEN;
+    set_g_and_parent(
+        info,
+        parent_node.info.g + adjusted_cost,
+        parent_node.get_real_g() + parent_op.get_cost(),
+        parent_node.get_state().get_id(),
+        OperatorID(parent_op.get_id()));
 }
 
-void SearchNode::reopen(
-    const SearchNode& parent_node,
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::reopen(
+    const BasicSearchNode& parent_node,
     const OperatorProxy& parent_op,
     int adjusted_cost)
 {
-    assert(
-        info.status == SearchNodeInfo::OPEN ||
-        info.status == SearchNodeInfo::CLOSED);
+    assert(info.status == NodeInfo::OPEN || info.status == NodeInfo::CLOSED);
 
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    info.status = NodeInfo::OPEN;
+    set_g_and_parent(
+        info,
+        parent_node.info.g + adjusted_cost,
+        parent_node.get_real_g() + parent_op.get_cost(),
+        parent_node.get_state().get_id(),
+        OperatorID(parent_op.get_id()));
 }
 
 // like reopen, except doesn't change status
-void SearchNode::update_parent(
-    const SearchNode& parent_node,
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::update_parent(
+    const BasicSearchNode& parent_node,
     const OperatorProxy& parent_op,
     int adjusted_cost)
 {
-    assert(
-        info.status == SearchNodeInfo::OPEN ||
-        info.status == SearchNodeInfo::CLOSED);
+    assert(info.status == NodeInfo::OPEN || info.status == NodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_g_and_parent(
+        info,
+        parent_node.info.g + adjusted_cost,
+        parent_node.get_real_g() + parent_op.get_cost(),
+        parent_node.get_state().get_id(),
+        OperatorID(parent_op.get_id()));
+}
+
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::open_without_parent(int g, int real_g)
+{
+    assert(info.status == NodeInfo::NEW);
+    info.status = NodeInfo::OPEN;
+    set_g_and_parent(
+        info,
+        g,
+        real_g,
+        StateID::no_state,
+        OperatorID::no_operator);
 }
 
-void SearchNode::close()
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::reopen_without_parent(int g, int real_g)
 {
-    assert(info.status == SearchNodeInfo::OPEN);
-    info.status = SearchNodeInfo::CLOSED;
+    assert(info.status == NodeInfo::OPEN || info.status == NodeInfo::CLOSED);
+    info.status = NodeInfo::OPEN;
+    set_g_and_parent(
+        info,
+        g,
+        real_g,
+        StateID::no_state,
+        OperatorID::no_operator);
 }
 
-void SearchNode::mark_as_dead_end()
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::close()
 {
-    info.status = SearchNodeInfo::DEAD_END;
+    assert(info.status == NodeInfo::OPEN);
+    info.status = NodeInfo::CLOSED;
 }
 
-void SearchNode::dump(const ClassicalPlanningTask& task, utils::LogProxy& log) const
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::mark_as_dead_end()
+{
+    info.status = NodeInfo::DEAD_END;
+}
+
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::dump(
+    const ClassicalPlanningTask& task,
+    utils::LogProxy& log) const
 {
     if (log.is_at_least_debug()) {
         log << state.get_id() << ": ";
         task_properties::dump_fdr(task, state);
-        if (info.creating_operator != OperatorID::no_operator) {
-            OperatorsProxy operators = task.get_operators();
-            OperatorProxy op = operators[info.creating_operator.get_index()];
-            log << " created by " << op.get_name() << " from "
-                << info.parent_state_id << endl;
-        } else {
-            log << " no parent" << endl;
+        if constexpr (NodeInfo::stores_parent) {
+            if (info.creating_operator != OperatorID::no_operator) {
+                OperatorsProxy operators = task.get_operators();
+                OperatorProxy op =
+                    operators[info.creating_operator.get_index()];
+                log << " created by " << op.get_name() << " from "
+                    << info.parent_state_id << endl;
+                return;
+            }
         }
+        log << " no parent" << endl;
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry& state_registry, utils::LogProxy& log)
+template <typename NodeInfo>
+void BasicSearchNode<NodeInfo>::reopen()
+{
+    assert(info.status == NodeInfo::OPEN || info.status == NodeInfo::CLOSED);
+    info.status = NodeInfo::OPEN;
+}
+
+template <typename NodeInfo>
+BasicSearchSpace<NodeInfo>::BasicSearchSpace(
+    StateRegistry& state_registry,
+    utils::LogProxy& log,
+    OperatorCost cost_type)
     : state_registry(state_registry)
     , log(log)
+    , cost_type(cost_type)
 {
 }
 
-SearchNode SearchSpace::get_node(const State& state)
+template <typename NodeInfo>
+BasicSearchNode<NodeInfo>
+BasicSearchSpace<NodeInfo>::get_node(const State& state)
 {
-    return SearchNode(state, search_node_infos[state]);
+    return BasicSearchNode<NodeInfo>(state, search_node_infos[state]);
 }
 
-void SearchSpace::trace_path(const State& goal_state, vector<OperatorID>& path)
-    const
+/*
+  Regressing a state through an operator whose effect variables have no
+  precondition enumerates all values of these variables in the predecessor.
+  We give up if an operator has more candidate predecessors than this.
+*/
+static const int64_t MAX_PREDECESSOR_CANDIDATES = 1000000;
+
+/*
+  Index of the operators by the fact of their first effect. An operator can
+  only lead to a state in which this fact is true.
+*/
+class OperatorsByFirstEffect {
+    vector<int> fact_offsets;
+    vector<vector<int>> operators_by_fact;
+
+public:
+    OperatorsByFirstEffect(
+        const ClassicalPlanningTask& task,
+        const flat_operator_table::FlatOperatorTable& flat_operators)
+    {
+        int num_facts = 0;
+        for (int var = 0; var < task.get_num_variables(); ++var) {
+            fact_offsets.push_back(num_facts);
+            num_facts += task.get_variable_domain_size(var);
+        }
+        operators_by_fact.resize(num_facts);
+        for (int op = 0; op < flat_operators.get_num_operators(); ++op) {
+            // Operators without effects cannot lead to a different state.
+            auto effects = flat_operators.get_effects(op);
+            if (!effects.empty()) {
+                FactPair fact = effects.front();
+                operators_by_fact[fact_offsets[fact.var] + fact.value]
+                    .push_back(op);
+            }
+        }
+    }
+
+    const vector<int>& get_operators(int var, int value) const
+    {
+        return operators_by_fact[fact_offsets[var] + value];
+    }
+};
+
+/*
+  Collect the registered states from which applying an operator leads to the
+  given state, together with these operators. Effect variables without a
+  precondition may have had any value in the predecessor.
+*/
+static void get_registered_predecessors(
+    StateRegistry& state_registry,
+    const ClassicalPlanningTask& task,
+    const flat_operator_table::FlatOperatorTable& flat_operators,
+    const OperatorsByFirstEffect& operators_by_first_effect,
+    const State& state,
+    vector<pair<OperatorID, StateID>>& predecessors)
 {
-    State current_state = goal_state;
+    const vector<int>& values = state.get_unpacked_values();
+    int num_vars = values.size();
+    vector<int> predecessor_values;
+    vector<int> free_vars;
+    for (int fact_var = 0; fact_var < num_vars; ++fact_var) {
+        for (int op : operators_by_first_effect.get_operators(
+                 fact_var,
+                 values[fact_var])) {
+            bool is_regressable = true;
+            free_vars.clear();
+            for (FactPair fact : flat_operators.get_effects(op)) {
+                if (values[fact.var] != fact.value) {
+                    is_regressable = false;
+                    break;
+                }
+                free_vars.push_back(fact.var);
+            }
+            if (!is_regressable) {
+                continue;
+            }
+            predecessor_values = values;
+            for (FactPair fact : flat_operators.get_preconditions(op)) {
+                auto it = find(free_vars.begin(), free_vars.end(), fact.var);
+                if (it != free_vars.end()) {
+                    free_vars.erase(it);
+                } else if (values[fact.var] != fact.value) {
+                    is_regressable = false;
+                    break;
+                }
+                predecessor_values[fact.var] = fact.value;
+            }
+            if (!is_regressable) {
+                continue;
+            }
+
+            int64_t num_candidates = 1;
+            for (int var : free_vars) {
+                num_candidates *= task.get_variable_domain_size(var);
+                if (num_candidates > MAX_PREDECESSOR_CANDIDATES) {
+                    cerr << "Reconstructing the plan by regression needs to "
+                         << "look up more than " << MAX_PREDECESSOR_CANDIDATES
+                         << " predecessors of a state for operator "
+                         << task.get_operators()[op].get_name()
+                         << ". Use parent_pointers=true." << endl;
+                    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+                }
+            }
+
+            // Enumerate all values of the free variables like an odometer.
+            for (int var : free_vars) {
+                predecessor_values[var] = 0;
+            }
+            while (true) {
+                StateID id = state_registry.find_state(predecessor_values);
+                if (id != StateID::no_state && id != state.get_id()) {
+                    predecessors.emplace_back(OperatorID(op), id);
+                }
+                size_t i = 0;
+                for (; i < free_vars.size(); ++i) {
+                    int var = free_vars[i];
+                    if (++predecessor_values[var] <
+                        task.get_variable_domain_size(var)) {
+                        break;
+                    }
+                    predecessor_values[var] = 0;
+                }
+                if (i == free_vars.size()) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+template <typename NodeInfo>
+void BasicSearchSpace<NodeInfo>::trace_path_by_regression(
+    const State& goal_state,
+    vector<OperatorID>& path,
+    vector<StateID>& trajectory) const
+{
+    const ClassicalPlanningTask& task =
+        dynamic_cast<const ClassicalPlanningTask&>(
+            state_registry.get_task_proxy());
+    const flat_operator_table::FlatOperatorTable& flat_operators =
+        *state_registry.get_flat_operators();
+    OperatorsByFirstEffect operators_by_first_effect(task, flat_operators);
+    bool is_unit_cost = task_properties::is_unit_cost(task);
+    StateID initial_state_id = state_registry.get_initial_state().get_id();
+
+    /*
+      Depth-first search backwards from the goal. With zero-cost operators,
+      a predecessor can have the same g value as the state, so we need to
+      avoid cycles and be able to backtrack.
+    */
+    struct Frame {
+        StateID id;
+        vector<pair<OperatorID, StateID>> predecessors;
+        size_t next_predecessor;
+    };
+    vector<Frame> stack;
+    unordered_set<int> visited;
+    stack.push_back({goal_state.get_id(), {}, 0});
+    visited.insert(goal_state.get_id().get_value());
+    bool is_new_frame = true;
+    while (stack.back().id != initial_state_id) {
+        Frame& frame = stack.back();
+        State state = state_registry.lookup_state(frame.id);
+        if (is_new_frame) {
+            state.unpack();
+            get_registered_predecessors(
+                state_registry,
+                task,
+                flat_operators,
+                operators_by_first_effect,
+                state,
+                frame.predecessors);
+        }
+        int g = search_node_infos[state].g;
+        is_new_frame = false;
+        while (frame.next_predecessor < frame.predecessors.size()) {
+            auto [op_id, predecessor_id] =
+                frame.predecessors[frame.next_predecessor++];
+            if (visited.count(predecessor_id.get_value())) {
+                continue;
+            }
+            const NodeInfo& predecessor_info =
+                search_node_infos[state_registry.lookup_state(predecessor_id)];
+            int cost = get_adjusted_action_cost(
+                flat_operators.get_cost(op_id.get_index()),
+                cost_type,
+                is_unit_cost);
+            if (predecessor_info.status != NodeInfo::NEW &&
+                predecessor_info.g >= 0 && predecessor_info.g + cost <= g) {
+                visited.insert(predecessor_id.get_value());
+                stack.push_back({predecessor_id, {}, 0});
+                is_new_frame = true;
+                break;
+            }
+        }
+        if (!is_new_frame) {
+            // All predecessors failed. Backtrack.
+            stack.pop_back();
+            if (stack.empty()) {
+                cerr << "Could not reconstruct the plan by regression." << endl;
+                utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+            }
+        }
+    }
+
+    /*
+      The stack holds the path from the goal to the initial state. The
+      operator leading from stack[i] to stack[i - 1] is the last predecessor
+      that was tried in stack[i - 1].
+    */
     assert(path.empty());
-    for (;;) {
-        const SearchNodeInfo& info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
-            break;
+    assert(trajectory.empty());
+    for (int i = stack.size() - 1; i >= 0; --i) {
+        trajectory.push_back(stack[i].id);
+        if (i > 0) {
+            const Frame& successor = stack[i - 1];
+            path.push_back(
+                successor.predecessors[successor.next_predecessor - 1].first);
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
     }
-    reverse(path.begin(), path.end());
 }
 
-void SearchSpace::dump(const ClassicalPlanningTask& task) const
+template <typename NodeInfo>
+void BasicSearchSpace<NodeInfo>::trace_path(
+    const State& goal_state,
+    vector<OperatorID>& path) const
+{
+    if constexpr (!NodeInfo::stores_parent) {
+        vector<StateID> trajectory;
+        trace_path_by_regression(goal_state, path, trajectory);
+    } else {
+        State current_state = goal_state;
+        assert(path.empty());
+        for (;;) {
+            const NodeInfo& info = search_node_infos[current_state];
+            if (info.creating_operator == OperatorID::no_operator) {
+                assert(info.parent_state_id == StateID::no_state);
+                break;
+            }
+            path.push_back(info.creating_operator);
+            current_state = state_registry.lookup_state(info.parent_state_id);
+        }
+        reverse(path.begin(), path.end());
+    }
+}
+
+template <typename NodeInfo>
+void BasicSearchSpace<NodeInfo>::dump(const ClassicalPlanningTask& task) const
 {
     OperatorsProxy operators = task.get_operators();
     for (StateID id : state_registry) {
         /* The body duplicates SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         State state = state_registry.lookup_state(id);
-        const SearchNodeInfo& node_info = search_node_infos[state];
+        const NodeInfo& node_info = search_node_infos[state];
         log << id << ": ";
         task_properties::dump_fdr(task, state);
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
-            OperatorProxy op =
-                operators[node_info.creating_operator.get_index()];
-            log << " created by " << op.get_name() << " from "
-                << node_info.parent_state_id << endl;
-        } else {
-            log << "has no parent" << endl;
+        if constexpr (NodeInfo::stores_parent) {
+            if (node_info.creating_operator != OperatorID::no_operator &&
+                node_info.parent_state_id != StateID::no_state) {
+                OperatorProxy op =
+                    operators[node_info.creating_operator.get_index()];
+                log << " created by " << op.get_name() << " from "
+                    << node_info.parent_state_id << endl;
+                continue;
+            }
         }
+        log << "has no parent" << endl;
     }
 }
 
-void SearchSpace::print_statistics() const
+template <typename NodeInfo>
+void BasicSearchSpace<NodeInfo>::print_statistics() const
 {
     state_registry.print_statistics(log);
 }
 
-void SearchSpace::trace_path(
+template <typename NodeInfo>
+void BasicSearchSpace<NodeInfo>::trace_path(
     const State& goal_state,
     vector<StateID>& trajectory) const
 {
-    State current_state = goal_state;
-
-    assert(trajectory.empty());
-    trajectory.push_back(goal_state.get_id());
-    for (;;) {
-        const SearchNodeInfo& info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
-            break;
-        }
-        trajectory.push_back(info.parent_state_id);
-        current_state = state_registry.lookup_state(info.parent_state_id);
-    }
-    reverse(trajectory.begin(), trajectory.end());
+    vector<OperatorID> path;
+    trace_path(goal_state, path, trajectory);
 }
 
-void SearchSpace::trace_path(
+template <typename NodeInfo>
+void BasicSearchSpace<NodeInfo>::trace_path(
     const State& goal_state,
     vector<OperatorID>& path,
     vector<StateID>& trajectory) const
 {
-    State current_state = goal_state;
+    if constexpr (!NodeInfo::stores_parent) {
+        trace_path_by_regression(goal_state, path, trajectory);
+    } else {
+        State current_state = goal_state;
 
-    assert(path.empty());
-    assert(trajectory.empty());
-    trajectory.push_back(goal_state.get_id());
-    for (;;) {
-        const SearchNodeInfo& info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
-            break;
+        assert(path.empty());
+        assert(trajectory.empty());
+        trajectory.push_back(goal_state.get_id());
+        for (;;) {
+            const NodeInfo& info = search_node_infos[current_state];
+            if (info.creating_operator == OperatorID::no_operator) {
+                assert(info.parent_state_id == StateID::no_state);
+                break;
+            }
+            path.push_back(info.creating_operator);
+            trajectory.push_back(info.parent_state_id);
+            current_state = state_registry.lookup_state(info.parent_state_id);
         }
-        path.push_back(info.creating_operator);
-        trajectory.push_back(info.parent_state_id);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        reverse(path.begin(), path.end());
+        reverse(trajectory.begin(), trajectory.end());
     }
-    reverse(path.begin(), path.end());
-    reverse(trajectory.begin(), trajectory.end());
 }
 
-void SearchNode::reopen()
-{
-    assert(
-        info.status == SearchNodeInfo::OPEN ||
-        info.status == SearchNodeInfo::CLOSED);
-    info.status = SearchNodeInfo::OPEN;
-}
+template class BasicSearchNode<BasicSearchNodeInfo<true, true>>;
+template class BasicSearchNode<BasicSearchNodeInfo<false, true>>;
+template class BasicSearchNode<BasicSearchNodeInfo<true, false>>;
+template class BasicSearchNode<BasicSearchNodeInfo<false, false>>;
+
+template class BasicSearchSpace<BasicSearchNodeInfo<true, true>>;
+template class BasicSearchSpace<BasicSearchNodeInfo<false, true>>;
+template class BasicSearchSpace<BasicSearchNodeInfo<true, false>>;
+template class BasicSearchSpace<BasicSearchNodeInfo<false, false>>;
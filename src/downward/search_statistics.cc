@@ -20,6 +20,10 @@ SearchStatistics::SearchStatistics(utils::LogProxy& log)
     dead_end_states = 0;
     generated_ops = 0;
 
+    bytes_read = 0;
+    bytes_written = 0;
+    merge_time = 0;
+
     lastjump_expanded_states = 0;
     lastjump_reopened_states = 0;
     lastjump_evaluated_states = 0;
@@ -74,6 +78,11 @@ void SearchStatistics::print_detailed_statistics() const
     log << "Evaluations: " << evaluations << endl;
     log << "Generated " << generated_states << " state(s)." << endl;
     log << "Dead ends: " << dead_end_states << " state(s)." << endl;
+    if (bytes_read > 0 || bytes_written > 0) {
+        log << "Bytes read: " << bytes_read << endl;
+        log << "Bytes written: " << bytes_written << endl;
+        log << "Merge time: " << merge_time << "s" << endl;
+    }
 
     if (lastjump_f_value >= 0) {
         log << "Expanded until last jump: " << lastjump_expanded_states
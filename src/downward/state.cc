@@ -12,7 +12,7 @@
 using namespace std;
 
 State::State(
-    const StateRegistry& registry,
+    const StateRegistryBase& registry,
     StateID id,
     const PackedStateBin* buffer)
     : registry(&registry)
@@ -36,6 +36,19 @@ State::State(vector<int> values)
 {
 }
 
+template <typename F>
+auto State::visit_values(F&& f) const
+{
+    if (values) {
+        return f(*values);
+    }
+    return state_packer->visit_layout([&](const auto& vars) {
+        return f(
+            views::iota(0, num_variables) |
+            views::transform([&](int var) { return vars.get(buffer, var); }));
+    });
+}
+
 bool operator==(const State& left, const State& right)
 {
     if (left.registry && right.registry) {
@@ -43,32 +56,18 @@ bool operator==(const State& left, const State& right)
         return left.id == right.id;
     }
 
-    // Compare values directly.
-    if (!left.values) {
-        auto left_range = std::views::iota(0, left.num_variables) |
-                          std::views::transform([&](int var) {
-                              return left.state_packer->get(left.buffer, var);
-                          });
-        if (!right.values) {
-            auto right_range =
-                std::views::iota(0, left.num_variables) |
-                std::views::transform([&](int var) {
-                    return right.state_packer->get(right.buffer, var);
-                });
-            return std::ranges::equal(left_range, right_range);
-        } else {
-            return std::ranges::equal(left_range, *right.values);
-        }
-    } else if (!right.values) {
-        auto right_range =
-            std::views::iota(0, left.num_variables) |
-            std::views::transform([&](int var) {
-                return right.state_packer->get(right.buffer, var);
-            });
-        return std::ranges::equal(*left.values, right_range);
+    if (!left.values && !right.values &&
+        left.state_packer == right.state_packer) {
+        // Both states are packed in the same way. Compare the packed data.
+        return left.state_packer->equal(left.buffer, right.buffer);
     }
 
-    return *left.values == *right.values;
+    // Compare values directly.
+    return left.visit_values([&](const auto& left_values) {
+        return right.visit_values([&](const auto& right_values) {
+            return ranges::equal(left_values, right_values);
+        });
+    });
 }
 
 std::strong_ordering operator<=>(const State& left, const State& right)
@@ -79,43 +78,15 @@ std::strong_ordering operator<=>(const State& left, const State& right)
     }
 
     // Compare values directly.
-    if (!left.values) {
-        auto left_range = std::views::iota(0, left.num_variables) |
-                          std::views::transform([&](int var) {
-                              return left.state_packer->get(left.buffer, var);
-                          });
-        if (!right.values) {
-            auto right_range =
-                std::views::iota(0, left.num_variables) |
-                std::views::transform([&](int var) {
-                    return right.state_packer->get(right.buffer, var);
-                });
-            return std::lexicographical_compare_three_way(
-                left_range.begin(),
-                left_range.end(),
-                right_range.begin(),
-                right_range.end());
-        } else {
-            return std::lexicographical_compare_three_way(
-                left_range.begin(),
-                left_range.end(),
-                right.values->begin(),
-                right.values->end());
-        }
-    } else if (!right.values) {
-        auto right_range =
-            std::views::iota(0, left.num_variables) |
-            std::views::transform([&](int var) {
-                return right.state_packer->get(right.buffer, var);
-            });
-        return std::lexicographical_compare_three_way(
-            left.values->begin(),
-            left.values->end(),
-            right_range.begin(),
-            right_range.end());
-    }
-
-    return *left.values <=> *right.values;
+    return left.visit_values([&](const auto& left_values) {
+        return right.visit_values([&](const auto& right_values) {
+            return lexicographical_compare_three_way(
+                left_values.begin(),
+                left_values.end(),
+                right_values.begin(),
+                right_values.end());
+        });
+    });
 }
 
 void State::unpack() const
@@ -125,18 +96,10 @@ void State::unpack() const
         /*
           A micro-benchmark in issue348 showed that constructing the vector
           in the required size and then assigning values was faster than the
-          more obvious reserve/push_back. Although, the benchmark did not
-          profile this specific code.
-
-          We might consider a bulk-unpack method in state_packer that could be
-          more efficient. (One can imagine state packer to have extra data
-          structures that exploit sequentially unpacking each entry, by doing
-          things bin by bin.)
+          more obvious reserve/push_back.
         */
         values = std::make_shared<std::vector<int>>(num_variables);
-        for (int var = 0; var < num_variables; ++var) {
-            (*values)[var] = state_packer->get(buffer, var);
-        }
+        state_packer->unpack_all(buffer, values->data());
     }
 }
 
@@ -162,7 +125,7 @@ int State::operator[](VariableProxy var) const
     return (*this)[var.get_id()];
 }
 
-const StateRegistry* State::get_registry() const
+const StateRegistryBase* State::get_registry() const
 {
     return registry;
 }
@@ -3,38 +3,139 @@
 #include "downward/per_state_information.h"
 #include "downward/task_proxy.h"
 
+#include "downward/plugins/plugin.h"
 #include "downward/utils/logging.h"
 
+#include <random>
+
 using namespace std;
 
-StateRegistry::StateRegistry(const AbstractPlanningTask& task)
+StateRegistryBase::StateRegistryBase(
+    const AbstractPlanningTask& task,
+    StatePacking state_packing)
     : task(task)
-    , state_packer(task_properties::g_state_packers[task])
+    , state_packing(state_packing)
+    , state_packer(task_properties::g_state_packers[task][state_packing])
     , num_variables(task.get_variables().size())
-    , state_data_pool(get_bins_per_state())
+    , flat_operators(nullptr)
+    , state_id_bound(0)
+{
+    if (auto classical_task =
+            dynamic_cast<const ClassicalPlanningTask*>(&task)) {
+        flat_operators =
+            &flat_operator_table::get_flat_operator_table(*classical_task);
+    }
+}
+
+int StateRegistryBase::get_bins_per_state() const
+{
+    return state_packer.get_num_bins();
+}
+
+int StateRegistryBase::get_state_size_in_bytes() const
+{
+    return get_bins_per_state() * sizeof(PackedStateBin);
+}
+
+StateRegistry::StateRegistry(
+    const AbstractPlanningTask& task,
+    StateHashing hashing,
+    shared_ptr<StateStorage> state_storage,
+    StatePacking state_packing)
+    : StateRegistryBase(task, state_packing)
+    , hashing(hashing)
+    , state_storage(
+          state_storage ? state_storage : make_shared<HeapStateStorage>())
+    , state_data_pool(
+          get_bins_per_state(),
+          StateStorageAllocator<PackedStateBin>(this->state_storage))
     , registered_states(
-          StateIDSemanticHash(state_data_pool, get_bins_per_state()),
+          StateIDSemanticHash(
+              state_data_pool,
+              get_bins_per_state(),
+              hashing == StateHashing::ZOBRIST ? &state_hashes : nullptr),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state()))
+    , scratch_buffer(get_bins_per_state())
 {
+    if (hashing == StateHashing::ZOBRIST) {
+        // Use a fixed seed so that hashes agree between registries and runs.
+        mt19937_64 rng(2024);
+        for (int var = 0; var < num_variables; ++var) {
+            zobrist_offsets.push_back(zobrist_keys.size());
+            int domain_size = task.get_variables()[var].get_domain_size();
+            for (int value = 0; value < domain_size; ++value) {
+                zobrist_keys.push_back(rng());
+            }
+        }
+    }
 }
 
-StateID StateRegistry::insert_id_or_pop_state()
+uint64_t StateRegistry::compute_state_hash(const PackedStateBin* buffer) const
 {
+    if (hashing == StateHashing::ZOBRIST) {
+        return state_packer.visit_layout([&](const auto& vars) {
+            uint64_t hash = 0;
+            for (int var = 0; var < num_variables; ++var) {
+                hash ^= get_zobrist_key(var, vars.get(buffer, var));
+            }
+            return hash;
+        });
+    }
     /*
-      Attempt to insert a StateID for the last state of state_data_pool
-      if none is present yet. If this fails (another entry for this state
-      is present), we have to remove the duplicate entry from the
-      state data pool.
+      The lower 32 bits of the 64-bit hash are the 32-bit hash, so the hash
+      set sees the same hash as when it hashes a registered state itself.
     */
-    StateID id(state_data_pool.size() - 1);
-    pair<int, bool> result = registered_states.insert(id.value);
-    bool is_new_entry = result.second;
-    if (!is_new_entry) {
-        state_data_pool.pop_back();
+    utils::HashState hash_state;
+    for (int i = 0; i < get_bins_per_state(); ++i) {
+        hash_state.feed(buffer[i]);
     }
+    return hash_state.get_hash64();
+}
+
+StateID
+StateRegistry::insert_if_new(const PackedStateBin* buffer, uint64_t hash)
+{
+    /*
+      Probe registered_states with the data in the buffer. We only add the
+      state to state_data_pool once we know that it is new, so buffers of
+      registered states are never invalidated by this method.
+    */
+    int existing_id = find_registered_state(buffer, hash);
+    if (existing_id != -1) {
+        return StateID(existing_id);
+    }
+
+    StateID id(state_data_pool.size());
+    state_data_pool.push_back(buffer);
+    if (hashing == StateHashing::ZOBRIST) {
+        state_hashes.push_back(hash);
+    }
+    int_hash_set::HashType set_hash =
+        static_cast<int_hash_set::HashType>(hash);
+    registered_states.insert_new_with_hash(id.value, set_hash);
     assert(
         registered_states.size() == static_cast<int>(state_data_pool.size()));
-    return StateID(result.first);
+    state_id_bound.store(state_data_pool.size(), memory_order_relaxed);
+    return id;
+}
+
+int StateRegistry::find_registered_state(
+    const PackedStateBin* buffer,
+    uint64_t hash) const
+{
+    int_hash_set::HashType set_hash =
+        static_cast<int_hash_set::HashType>(hash);
+    return registered_states.find(set_hash, [&](int id) {
+        return state_packer.equal(state_data_pool[id], buffer);
+    });
+}
+
+PackedStateBin*
+StateRegistry::pack_into_scratch_buffer(const vector<int>& values)
+{
+    assert(static_cast<int>(values.size()) == num_variables);
+    state_packer.pack_all(values.data(), scratch_buffer.data());
+    return scratch_buffer.data();
 }
 
 State StateRegistry::lookup_state(StateID id) const
@@ -46,17 +147,10 @@ State StateRegistry::lookup_state(StateID id) const
 const State& StateRegistry::get_initial_state()
 {
     if (!cached_initial_state) {
-        int num_bins = get_bins_per_state();
-        unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
-        // Avoid garbage values in half-full bins.
-        fill_n(buffer.get(), num_bins, 0);
-
         State initial_state = task.get_initial_state();
-        for (size_t i = 0; i < initial_state.size(); ++i) {
-            state_packer.set(buffer.get(), i, initial_state[i]);
-        }
-        state_data_pool.push_back(buffer.get());
-        StateID id = insert_id_or_pop_state();
+        PackedStateBin* buffer =
+            pack_into_scratch_buffer(initial_state.get_unpacked_values());
+        StateID id = insert_if_new(buffer, compute_state_hash(buffer));
         cached_initial_state = std::make_unique<State>(lookup_state(id));
     }
     return *cached_initial_state;
@@ -64,64 +158,78 @@ const State& StateRegistry::get_initial_state()
 
 State StateRegistry::insert_state(std::vector<int>&& state)
 {
-    int num_bins = get_bins_per_state();
-    unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
-    // Avoid garbage values in half-full bins.
-    fill_n(buffer.get(), num_bins, 0);
+    PackedStateBin* buffer = pack_into_scratch_buffer(state);
+    return lookup_state(insert_if_new(buffer, compute_state_hash(buffer)));
+}
 
-    for (size_t i = 0; i < state.size(); ++i) {
-        state_packer.set(buffer.get(), i, state[i]);
+StateID StateRegistry::find_state(const vector<int>& values)
+{
+    for (int var = 0; var < num_variables; ++var) {
+        if (!state_packer.can_store(var, values[var])) {
+            // No registered state has this value.
+            return StateID::no_state;
+        }
     }
-    state_data_pool.push_back(buffer.get());
-    // buffer is copied by push_back
-    StateID id = insert_id_or_pop_state();
-    return lookup_state(id);
+    PackedStateBin* buffer = pack_into_scratch_buffer(values);
+    int id = find_registered_state(buffer, compute_state_hash(buffer));
+    return id == -1 ? StateID::no_state : StateID(id);
 }
 
-// TODO it would be nice to move the actual state creation (and operator
-// application)
-//      out of the StateRegistry. This could for example be done by global
-//      functions operating on state buffers (PackedStateBin *).
-State StateRegistry::get_successor_state(
-    const State& predecessor,
-    const OperatorProxy& op)
+State StateRegistry::insert_packed_state(const PackedStateBin* buffer)
 {
-    state_data_pool.push_back(predecessor.get_buffer());
-    /*
-      TODO: ideally, we would not modify state_data_pool here and in
-      insert_id_or_pop_state, but only at one place, to avoid errors like
-      buffer becoming a dangling pointer. This used to be a bug before being
-      fixed in https://issues.fast-downward.org/issue1115.
-    */
-    PackedStateBin* buffer = state_data_pool[state_data_pool.size() - 1];
-    /* Experiments for issue348 showed that for domains with axioms it's faster
-       to compute successor states using unpacked data. */
-
-    for (FactProxy effect : op.get_effects()) {
-        FactPair effect_pair = effect.get_pair();
-        state_packer.set(buffer, effect_pair.var, effect_pair.value);
-    }
+    return lookup_state(insert_if_new(buffer, compute_state_hash(buffer)));
+}
 
-    /*
-      NOTE: insert_id_or_pop_state possibly invalidates buffer, hence
-      we use lookup_state to retrieve the state using the correct buffer.
-    */
-    StateID id = insert_id_or_pop_state();
-    return lookup_state(id);
+const PackedStateBin* StateRegistry::get_packed_state(const State& state) const
+{
+    assert(state.get_registry() == this);
+    return state.get_buffer();
 }
 
-int StateRegistry::get_bins_per_state() const
+uint64_t StateRegistry::get_state_hash(const State& state) const
 {
-    return state_packer.get_num_bins();
+    assert(state.get_registry() == this);
+    if (hashing == StateHashing::ZOBRIST) {
+        return state_hashes[state.get_id().value];
+    }
+    return compute_state_hash(state.get_buffer());
 }
 
-int StateRegistry::get_state_size_in_bytes() const
+State StateRegistry::get_successor_state(
+    const State& predecessor,
+    const OperatorProxy& op)
 {
-    return get_bins_per_state() * sizeof(PackedStateBin);
+    if (flat_operators) {
+        return get_successor_state(
+            predecessor,
+            flat_operators->get_effects(op.get_id()));
+    }
+    return get_successor_state(predecessor, op.get_effects());
 }
 
 void StateRegistry::print_statistics(utils::LogProxy& log) const
 {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
+    state_storage->print_statistics(log);
 }
+
+static plugins::TypedEnumPlugin<StateHashing> _enum_plugin(
+    {{"packed_data",
+      "hash the packed data of a state whenever it is inserted"},
+     {"zobrist",
+      "store a 64-bit Zobrist hash for every state and derive the hashes of "
+      "successors from the hashes of their predecessors"}});
+
+static plugins::TypedEnumPlugin<StatePacking> _state_packing_enum_plugin(
+    {{"bins",
+      "pack variables greedily into 32-bit bins; no variable is split "
+      "across two bins"},
+     {"minimal",
+      "pack variables without gaps, splitting them across bins where "
+      "necessary, to use the minimal number of bits"},
+     {"dictionary",
+      "like minimal, but encode each value by its index among the values "
+      "the variable can take in reachable states (its initial value and "
+      "the values of effects); variables that no operator changes use no "
+      "memory"}});
@@ -0,0 +1,51 @@
+#include "downward/state_storage.h"
+
+#include "downward/plugins/plugin.h"
+
+using namespace std;
+
+void StateStorage::print_statistics(utils::LogProxy&) const
+{
+}
+
+void* HeapStateStorage::allocate(size_t num_bytes)
+{
+    return ::operator new(num_bytes);
+}
+
+void HeapStateStorage::deallocate(void* memory, size_t)
+{
+    ::operator delete(memory);
+}
+
+class HeapStateStorageFeature
+    : public plugins::TypedFeature<StateStorage, HeapStateStorage> {
+public:
+    HeapStateStorageFeature()
+        : TypedFeature("heap")
+    {
+        document_title("Heap state storage");
+        document_synopsis("Stores the state data on the heap.");
+    }
+
+    virtual shared_ptr<HeapStateStorage>
+    create_component(const plugins::Options&, const utils::Context&)
+        const override
+    {
+        return make_shared<HeapStateStorage>();
+    }
+};
+
+static plugins::FeaturePlugin<HeapStateStorageFeature> _plugin;
+
+static class StateStorageCategoryPlugin
+    : public plugins::TypedCategoryPlugin<StateStorage> {
+public:
+    StateStorageCategoryPlugin()
+        : TypedCategoryPlugin("StateStorage")
+    {
+        document_synopsis(
+            "Memory in which search algorithms store the data of the states "
+            "they register.");
+    }
+} _category_plugin;
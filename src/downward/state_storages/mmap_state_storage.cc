@@ -0,0 +1,176 @@
+#include "downward/state_storages/mmap_state_storage.h"
+
+#include "downward/plugins/plugin.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mmap_state_storage {
+// Segments are aligned to cache lines.
+static const size_t ALIGNMENT = 64;
+
+static void exit_with_system_error(const string& message)
+{
+    cerr << message << ": " << strerror(errno) << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+MmapStateStorage::MmapStateStorage(const string& path, int chunk_size_in_mb)
+    : path(path)
+    , chunk_size(static_cast<size_t>(chunk_size_in_mb) << 20)
+    , file_descriptor(-1)
+    , used_bytes_in_chunk(0)
+    , file_size(0)
+{
+    file_descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (file_descriptor == -1) {
+        exit_with_system_error("Could not create state storage file " + path);
+    }
+    /*
+      The mapping keeps the file alive, so we can remove it from the file
+      system right away. This way, it is also removed if the planner crashes.
+    */
+    if (unlink(path.c_str()) == -1) {
+        exit_with_system_error("Could not unlink state storage file " + path);
+    }
+    used_bytes_in_chunk = chunk_size;
+}
+
+MmapStateStorage::~MmapStateStorage()
+{
+    for (char* chunk : chunks) {
+        munmap(chunk, chunk_size);
+    }
+    close(file_descriptor);
+}
+
+void MmapStateStorage::add_chunk()
+{
+    /*
+      Growing the file with ftruncate does not write any data, so the file
+      stays sparse until pages are written back to it.
+    */
+    off_t offset = file_size;
+    file_size += chunk_size;
+    if (ftruncate(file_descriptor, file_size) == -1) {
+        exit_with_system_error("Could not grow state storage file " + path);
+    }
+    void* chunk = mmap(
+        nullptr,
+        chunk_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        file_descriptor,
+        offset);
+    if (chunk == MAP_FAILED) {
+        exit_with_system_error("Could not map state storage file " + path);
+    }
+    // Lookups of registered states do not follow any access pattern.
+    madvise(chunk, chunk_size, MADV_RANDOM);
+    chunks.push_back(static_cast<char*>(chunk));
+    used_bytes_in_chunk = 0;
+}
+#else
+MmapStateStorage::MmapStateStorage(const string& path, int chunk_size_in_mb)
+    : path(path)
+    , chunk_size(static_cast<size_t>(chunk_size_in_mb) << 20)
+    , file_descriptor(-1)
+    , used_bytes_in_chunk(0)
+    , file_size(0)
+{
+    cerr << "Memory-mapped state storage is not supported on this operating "
+         << "system." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+
+MmapStateStorage::~MmapStateStorage()
+{
+}
+
+void MmapStateStorage::add_chunk()
+{
+}
+#endif
+
+void* MmapStateStorage::allocate(size_t num_bytes)
+{
+    size_t aligned_size = (num_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (aligned_size > chunk_size) {
+        cerr << "Cannot store " << num_bytes << " bytes in state storage "
+             << "chunks of " << chunk_size << " bytes." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    if (used_bytes_in_chunk + aligned_size > chunk_size) {
+        add_chunk();
+    }
+    void* memory = chunks.back() + used_bytes_in_chunk;
+    used_bytes_in_chunk += aligned_size;
+    return memory;
+}
+
+void MmapStateStorage::deallocate(void*, size_t)
+{
+    // Memory is only released when the whole storage is destroyed.
+}
+
+void MmapStateStorage::print_statistics(utils::LogProxy& log) const
+{
+    log << "Memory-mapped state storage: " << chunks.size() << " chunk(s) "
+        << "of " << (chunk_size >> 20) << " MB" << endl;
+}
+
+class MmapStateStorageFeature
+    : public plugins::TypedFeature<StateStorage, MmapStateStorage> {
+public:
+    MmapStateStorageFeature()
+        : TypedFeature("mmap")
+    {
+        document_title("Memory-mapped state storage");
+        document_synopsis(
+            "Stores the state data in a memory-mapped file, so that the "
+            "operating system can page out state data that is not accessed "
+            "instead of running out of memory. This lets searches that "
+            "register more states than fit into memory continue, albeit "
+            "more slowly.");
+        add_option<string>(
+            "path",
+            "path of the file backing the state data. The file must not "
+            "exist; it is removed from the file system immediately after "
+            "it is created.");
+        add_option<int>(
+            "chunk_size",
+            "size in MB of the pieces in which the file is mapped into memory",
+            "64",
+            plugins::Bounds("1", "infinity"));
+        document_language_support("operating systems", "Linux and macOS");
+        document_note(
+            "Memory limits",
+            "The mapped file counts towards the address space of the "
+            "planner. Limit the physical memory (e.g., with cgroups) instead "
+            "of the address space to benefit from this storage.");
+    }
+
+    virtual shared_ptr<MmapStateStorage>
+    create_component(const plugins::Options& opts, const utils::Context&)
+        const override
+    {
+        return make_shared<MmapStateStorage>(
+            opts.get<string>("path"),
+            opts.get<int>("chunk_size"));
+    }
+};
+
+static plugins::FeaturePlugin<MmapStateStorageFeature> _plugin;
+} // namespace mmap_state_storage
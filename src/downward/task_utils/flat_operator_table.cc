@@ -0,0 +1,44 @@
+#include "downward/task_utils/flat_operator_table.h"
+
+#include "downward/abstract_task.h"
+
+using namespace std;
+
+namespace flat_operator_table {
+FlatOperatorTable::FlatOperatorTable(const ClassicalPlanningTask& task)
+{
+    int num_operators = task.get_num_operators();
+    precondition_begin.reserve(num_operators + 1);
+    effect_begin.reserve(num_operators + 1);
+    costs.reserve(num_operators);
+    for (int op = 0; op < num_operators; ++op) {
+        precondition_begin.push_back(preconditions.size());
+        int num_preconditions = task.get_num_operator_preconditions(op);
+        for (int i = 0; i < num_preconditions; ++i) {
+            preconditions.push_back(task.get_operator_precondition(op, i));
+        }
+        effect_begin.push_back(effects.size());
+        int num_effects = task.get_num_operator_effects(op);
+        for (int i = 0; i < num_effects; ++i) {
+            effects.push_back(task.get_operator_effect(op, i));
+        }
+        costs.push_back(task.get_operator_cost(op));
+    }
+    precondition_begin.push_back(preconditions.size());
+    effect_begin.push_back(effects.size());
+    preconditions.shrink_to_fit();
+    effects.shrink_to_fit();
+}
+
+static PerTaskInformation<FlatOperatorTable> flat_operator_tables(
+    [](const AbstractPlanningTask& task) {
+        return make_unique<FlatOperatorTable>(
+            dynamic_cast<const ClassicalPlanningTask&>(task));
+    });
+
+const FlatOperatorTable& get_flat_operator_table(
+    const ClassicalPlanningTask& task)
+{
+    return flat_operator_tables[task];
+}
+} // namespace flat_operator_table
@@ -0,0 +1,126 @@
+#include "downward/task_utils/incremental_successor_generator.h"
+
+#include "downward/task_utils/flat_operator_table.h"
+#include "downward/task_utils/successor_generator.h"
+
+#include "downward/abstract_task.h"
+#include "downward/state.h"
+
+#include "downward/utils/logging.h"
+
+using namespace std;
+
+namespace successor_generator {
+IncrementalSuccessorGenerator::IncrementalSuccessorGenerator(
+    const ClassicalPlanningTask& task,
+    const SuccessorGenerator& successor_generator,
+    int max_cached_states)
+    : successor_generator(successor_generator)
+    , flat_operators(flat_operator_table::get_flat_operator_table(task))
+    , max_cached_states(max_cached_states)
+    , operators_by_precondition_var(task.get_variables().size())
+    , var_marks(task.get_variables().size(), 0)
+    , op_marks(task.get_num_operators(), 0)
+    , current_mark(0)
+    , num_incremental_generations(0)
+    , num_full_generations(0)
+{
+    for (int op = 0; op < flat_operators.get_num_operators(); ++op) {
+        for (FactPair precondition : flat_operators.get_preconditions(op)) {
+            operators_by_precondition_var[precondition.var].emplace_back(op);
+        }
+    }
+}
+
+void IncrementalSuccessorGenerator::cache(
+    StateID id,
+    const vector<OperatorID>& applicable_ops)
+{
+    if (max_cached_states == 0) {
+        return;
+    }
+    auto [it, is_new] =
+        cached_applicable_ops.try_emplace(id.get_value(), applicable_ops);
+    if (!is_new) {
+        // The state is expanded again, e.g., after reopening.
+        it->second = applicable_ops;
+        return;
+    }
+    cache_order.push_back(id.get_value());
+    if (static_cast<int>(cache_order.size()) > max_cached_states) {
+        cached_applicable_ops.erase(cache_order.front());
+        cache_order.pop_front();
+    }
+}
+
+void IncrementalSuccessorGenerator::generate_applicable_ops(
+    const State& state,
+    StateID parent_id,
+    OperatorID creating_operator,
+    vector<OperatorID>& applicable_ops)
+{
+    auto parent_it = cached_applicable_ops.end();
+    if (parent_id != StateID::no_state) {
+        parent_it = cached_applicable_ops.find(parent_id.get_value());
+    }
+    if (parent_it == cached_applicable_ops.end()) {
+        ++num_full_generations;
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        cache(state.get_id(), applicable_ops);
+        return;
+    }
+
+    ++num_incremental_generations;
+    ++current_mark;
+    int op = creating_operator.get_index();
+    for (FactPair effect : flat_operators.get_effects(op)) {
+        var_marks[effect.var] = current_mark;
+    }
+
+    // Keep the operators whose preconditions are not affected by the effect.
+    for (OperatorID parent_op : parent_it->second) {
+        bool is_affected = false;
+        for (FactPair precondition :
+             flat_operators.get_preconditions(parent_op.get_index())) {
+            if (var_marks[precondition.var] == current_mark) {
+                is_affected = true;
+                break;
+            }
+        }
+        if (!is_affected) {
+            applicable_ops.push_back(parent_op);
+        }
+    }
+
+    // Recheck all operators whose preconditions are affected.
+    for (FactPair effect : flat_operators.get_effects(op)) {
+        for (OperatorID candidate : operators_by_precondition_var[effect.var]) {
+            int candidate_index = candidate.get_index();
+            if (op_marks[candidate_index] == current_mark) {
+                continue;
+            }
+            op_marks[candidate_index] = current_mark;
+            bool is_applicable = true;
+            for (FactPair precondition :
+                 flat_operators.get_preconditions(candidate_index)) {
+                if (state[precondition.var] != precondition.value) {
+                    is_applicable = false;
+                    break;
+                }
+            }
+            if (is_applicable) {
+                applicable_ops.push_back(candidate);
+            }
+        }
+    }
+    cache(state.get_id(), applicable_ops);
+}
+
+void IncrementalSuccessorGenerator::print_statistics(
+    utils::LogProxy& log) const
+{
+    log << "Incrementally generated applicable operators: "
+        << num_incremental_generations << " state(s), fully generated: "
+        << num_full_generations << " state(s)" << endl;
+}
+} // namespace successor_generator
@@ -0,0 +1,93 @@
+#include "downward/task_utils/regression_successor_generator.h"
+
+#include "downward/abstract_task.h"
+
+#include "downward/task_utils/flat_operator_table.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace regression_successor_generator {
+RegressionSuccessorGenerator::RegressionSuccessorGenerator(
+    const ClassicalPlanningTask& task)
+    : task(task)
+    , flat_operators(flat_operator_table::get_flat_operator_table(task))
+    , op_marks(task.get_num_operators(), 0)
+    , current_mark(0)
+{
+    int num_facts = 0;
+    for (int var = 0; var < task.get_num_variables(); ++var) {
+        fact_offsets.push_back(num_facts);
+        num_facts += task.get_variable_domain_size(var);
+    }
+    achievers.resize(num_facts);
+    for (int op = 0; op < flat_operators.get_num_operators(); ++op) {
+        for (FactPair effect : flat_operators.get_effects(op)) {
+            achievers[fact_offsets[effect.var] + effect.value].emplace_back(op);
+        }
+    }
+}
+
+void RegressionSuccessorGenerator::generate_relevant_ops(
+    const vector<int>& partial_state,
+    vector<OperatorID>& ops) const
+{
+    ++current_mark;
+    for (size_t var = 0; var < partial_state.size(); ++var) {
+        int value = partial_state[var];
+        if (value == UNASSIGNED) continue;
+        for (OperatorID op : achievers[fact_offsets[var] + value]) {
+            int& mark = op_marks[op.get_index()];
+            if (mark == current_mark) continue;
+            mark = current_mark;
+            bool consistent = true;
+            for (FactPair effect :
+                 flat_operators.get_effects(op.get_index())) {
+                int goal_value = partial_state[effect.var];
+                if (goal_value != UNASSIGNED && goal_value != effect.value) {
+                    consistent = false;
+                    break;
+                }
+            }
+            if (consistent) {
+                ops.push_back(op);
+            }
+        }
+    }
+}
+
+bool RegressionSuccessorGenerator::regress(
+    const vector<int>& partial_state,
+    OperatorID op,
+    vector<int>& result) const
+{
+    result = partial_state;
+    for (FactPair effect : flat_operators.get_effects(op.get_index())) {
+        assert(result[effect.var] == UNASSIGNED ||
+               result[effect.var] == effect.value);
+        result[effect.var] = UNASSIGNED;
+    }
+    for (FactPair precondition :
+         flat_operators.get_preconditions(op.get_index())) {
+        int& value = result[precondition.var];
+        if (value != UNASSIGNED && value != precondition.value) {
+            return false;
+        }
+        value = precondition.value;
+    }
+    for (FactPair precondition :
+         flat_operators.get_preconditions(op.get_index())) {
+        for (size_t var = 0; var < result.size(); ++var) {
+            if (result[var] != UNASSIGNED &&
+                static_cast<int>(var) != precondition.var &&
+                task.are_facts_mutex(
+                    precondition,
+                    FactPair(var, result[var]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace regression_successor_generator
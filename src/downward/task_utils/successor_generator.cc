@@ -1,28 +1,91 @@
 #include "downward/task_utils/successor_generator.h"
 
+#include "downward/task_utils/successor_generator_bitset.h"
 #include "downward/task_utils/successor_generator_factory.h"
 #include "downward/task_utils/successor_generator_internals.h"
+#include "downward/task_utils/successor_generator_program.h"
 
 #include "downward/abstract_task.h"
 #include "downward/state.h"
 
+#include "downward/plugins/plugin.h"
+
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const AbstractPlanningTask& task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create())
+SuccessorGenerator::SuccessorGenerator(
+    const AbstractPlanningTask& task_proxy,
+    SuccessorGeneratorType type)
 {
+    if (type == SuccessorGeneratorType::BITSET) {
+        bitset_generator = make_unique<BitsetGenerator>(task_proxy);
+        return;
+    }
+    root = SuccessorGeneratorFactory(task_proxy).create();
+    if (type == SuccessorGeneratorType::COMPILED) {
+        program = make_unique<GeneratorProgram>(*root);
+        root = nullptr;
+    }
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
 
+template <typename Generator>
+void SuccessorGenerator::generate_applicable_ops(
+    const Generator& generator,
+    const State& state,
+    vector<OperatorID>& applicable_ops)
+{
+    // Avoid unpacking registered states.
+    if (state.values) {
+        generator.generate_applicable_ops(*state.values, applicable_ops);
+    } else {
+        generator.generate_applicable_ops(
+            state.get_buffer(),
+            *state.state_packer,
+            applicable_ops);
+    }
+}
+
 void SuccessorGenerator::generate_applicable_ops(
     const State& state,
     vector<OperatorID>& applicable_ops) const
 {
+    if (program) {
+        generate_applicable_ops(*program, state, applicable_ops);
+        return;
+    } else if (bitset_generator) {
+        generate_applicable_ops(*bitset_generator, state, applicable_ops);
+        return;
+    }
     state.unpack();
     root->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
 }
 
-PerTaskInformation<SuccessorGenerator> g_successor_generators;
+SuccessorGenerators::SuccessorGenerators(const AbstractPlanningTask& task)
+    : task(task)
+{
+}
+
+SuccessorGenerator& SuccessorGenerators::operator[](SuccessorGeneratorType type)
+{
+    unique_ptr<SuccessorGenerator>& generator =
+        generators[static_cast<int>(type)];
+    if (!generator) {
+        generator = make_unique<SuccessorGenerator>(task, type);
+    }
+    return *generator;
+}
+
+PerTaskInformation<SuccessorGenerators> g_successor_generators;
+
+static plugins::TypedEnumPlugin<SuccessorGeneratorType> _enum_plugin(
+    {{"tree",
+      "walk a tree of polymorphic nodes on the unpacked state"},
+     {"compiled",
+      "walk the same tree flattened into a single array, reading the "
+      "values from the packed state data"},
+     {"bitset",
+      "intersect the bitsets of operators compatible with the facts of the "
+      "state; for tasks with very many operators"}});
 } // namespace successor_generator
@@ -0,0 +1,160 @@
+#include "downward/task_utils/successor_generator_bitset.h"
+
+#include "downward/task_utils/successor_generator_program.h"
+
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace successor_generator {
+/*
+  Computes result &= bitset for bitsets of num_words words. num_words is a
+  multiple of 4, so we can process 256 bits at a time.
+*/
+static void and_bitsets(
+    uint64_t* result,
+    const uint64_t* bitset,
+    int num_words)
+{
+#if defined(__AVX2__)
+    for (int i = 0; i < num_words; i += 4) {
+        __m256i lhs =
+            _mm256_loadu_si256(reinterpret_cast<__m256i*>(result + i));
+        __m256i rhs =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bitset + i));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(result + i),
+            _mm256_and_si256(lhs, rhs));
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < num_words; i += 2) {
+        __m128i lhs = _mm_loadu_si128(reinterpret_cast<__m128i*>(result + i));
+        __m128i rhs =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(bitset + i));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(result + i),
+            _mm_and_si128(lhs, rhs));
+    }
+#else
+    for (int i = 0; i < num_words; ++i) {
+        result[i] &= bitset[i];
+    }
+#endif
+}
+
+BitsetGenerator::BitsetGenerator(const AbstractPlanningTask& task)
+    : num_operators(task.get_num_operators())
+{
+    int num_used_words = (num_operators + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    num_words = (num_used_words + 3) / 4 * 4;
+    auto set_bit = [](Word* bitset, int op) {
+        bitset[op / BITS_PER_WORD] |= Word(1) << (op % BITS_PER_WORD);
+    };
+
+    all_operators.assign(num_words, 0);
+    for (int op = 0; op < num_operators; ++op) {
+        set_bit(all_operators.data(), op);
+    }
+
+    VariablesProxy variables = task.get_variables();
+    // Pairs of operator IDs and precondition values for each variable.
+    vector<vector<pair<int, int>>> preconditions_by_var(variables.size());
+    for (AbstractOperatorProxy op : task.get_abstract_operators()) {
+        for (FactProxy precondition : op.get_preconditions()) {
+            FactPair fact = precondition.get_pair();
+            preconditions_by_var[fact.var].emplace_back(
+                op.get_id(),
+                fact.value);
+        }
+    }
+
+    int num_bitsets = 0;
+    for (VariableProxy var : variables) {
+        if (!preconditions_by_var[var.get_id()].empty()) {
+            precondition_vars.push_back(var.get_id());
+            first_bitset.push_back(num_bitsets);
+            num_bitsets += var.get_domain_size();
+        }
+    }
+    bitsets.reserve(static_cast<size_t>(num_bitsets) * num_words);
+    for (int var : precondition_vars) {
+        /*
+          Operators without a precondition on var are compatible with all
+          values. Operators with a precondition on var only with its value.
+        */
+        vector<Word> unconstrained = all_operators;
+        for (auto [op, value] : preconditions_by_var[var]) {
+            unconstrained[op / BITS_PER_WORD] &=
+                ~(Word(1) << (op % BITS_PER_WORD));
+        }
+        int domain_size = variables[var].get_domain_size();
+        size_t begin = bitsets.size();
+        for (int value = 0; value < domain_size; ++value) {
+            bitsets.insert(
+                bitsets.end(),
+                unconstrained.begin(),
+                unconstrained.end());
+        }
+        for (auto [op, value] : preconditions_by_var[var]) {
+            set_bit(bitsets.data() + begin + value * num_words, op);
+        }
+    }
+}
+
+template <typename Values>
+void BitsetGenerator::compute_applicable_ops(
+    const Values& values,
+    vector<OperatorID>& applicable_ops) const
+{
+    // The buffer is reused to avoid allocating memory for every state.
+    thread_local vector<Word> applicable;
+    int num_precondition_vars = precondition_vars.size();
+    if (num_precondition_vars == 0) {
+        applicable = all_operators;
+    } else {
+        const Word* bitset =
+            get_bitset(first_bitset[0] + values[precondition_vars[0]]);
+        applicable.assign(bitset, bitset + num_words);
+        for (int i = 1; i < num_precondition_vars; ++i) {
+            int var = precondition_vars[i];
+            and_bitsets(
+                applicable.data(),
+                get_bitset(first_bitset[i] + values[var]),
+                num_words);
+        }
+    }
+    for (int i = 0; i < num_words; ++i) {
+        Word word = applicable[i];
+        while (word) {
+            int bit = countr_zero(word);
+            applicable_ops.emplace_back(i * BITS_PER_WORD + bit);
+            word &= word - 1;
+        }
+    }
+}
+
+void BitsetGenerator::generate_applicable_ops(
+    const vector<int>& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    compute_applicable_ops(state, applicable_ops);
+}
+
+void BitsetGenerator::generate_applicable_ops(
+    const PackedStateBin* buffer,
+    const int_packer::IntPacker& state_packer,
+    vector<OperatorID>& applicable_ops) const
+{
+    state_packer.visit_layout([&](const auto& vars) {
+        compute_applicable_ops(PackedValues(buffer, vars), applicable_ops);
+    });
+}
+} // namespace successor_generator
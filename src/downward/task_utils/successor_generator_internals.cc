@@ -1,7 +1,10 @@
 #include "downward/task_utils/successor_generator_internals.h"
 
+#include "downward/task_utils/successor_generator_program.h"
+
 #include "downward/task_proxy.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -21,7 +24,9 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. GeneratorProgram
+    (selected with successor_generator=compiled) implements a variant
+    of this that is compiled from the tree built here.
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -89,6 +94,17 @@ void GeneratorForkBinary::generate_applicable_ops(
     generator2->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkBinary::append_to(vector<int>& code) const
+{
+    int child1 = generator1->append_to(code);
+    int child2 = generator2->append_to(code);
+    int pos = code.size();
+    code.insert(
+        code.end(),
+        {static_cast<int>(GeneratorOpcode::FORK), 2, child1, child2});
+    return pos;
+}
+
 GeneratorForkMulti::GeneratorForkMulti(
     vector<unique_ptr<GeneratorBase>> children)
     : children(std::move(children))
@@ -108,6 +124,18 @@ void GeneratorForkMulti::generate_applicable_ops(
         generator->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkMulti::append_to(vector<int>& code) const
+{
+    vector<int> child_positions;
+    for (const auto& generator : children)
+        child_positions.push_back(generator->append_to(code));
+    int pos = code.size();
+    code.push_back(static_cast<int>(GeneratorOpcode::FORK));
+    code.push_back(child_positions.size());
+    code.insert(code.end(), child_positions.begin(), child_positions.end());
+    return pos;
+}
+
 GeneratorSwitchVector::GeneratorSwitchVector(
     int switch_var_id,
     vector<unique_ptr<GeneratorBase>>&& generator_for_value)
@@ -128,6 +156,20 @@ void GeneratorSwitchVector::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchVector::append_to(vector<int>& code) const
+{
+    vector<int> child_positions;
+    for (const auto& generator : generator_for_value) {
+        child_positions.push_back(generator ? generator->append_to(code) : -1);
+    }
+    int pos = code.size();
+    code.push_back(static_cast<int>(GeneratorOpcode::SWITCH_VECTOR));
+    code.push_back(switch_var_id);
+    code.push_back(child_positions.size());
+    code.insert(code.end(), child_positions.begin(), child_positions.end());
+    return pos;
+}
+
 GeneratorSwitchHash::GeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<GeneratorBase>>&& generator_for_value)
@@ -148,6 +190,25 @@ void GeneratorSwitchHash::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchHash::append_to(vector<int>& code) const
+{
+    vector<pair<int, int>> children;
+    for (const auto& [value, generator] : generator_for_value) {
+        children.emplace_back(value, generator->append_to(code));
+    }
+    // Sort by value for binary search and to make the program deterministic.
+    sort(children.begin(), children.end());
+    int pos = code.size();
+    code.push_back(static_cast<int>(GeneratorOpcode::SWITCH_SORTED));
+    code.push_back(switch_var_id);
+    code.push_back(children.size());
+    for (const auto& child : children)
+        code.push_back(child.first);
+    for (const auto& child : children)
+        code.push_back(child.second);
+    return pos;
+}
+
 GeneratorSwitchSingle::GeneratorSwitchSingle(
     int switch_var_id,
     int value,
@@ -167,6 +228,19 @@ void GeneratorSwitchSingle::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchSingle::append_to(vector<int>& code) const
+{
+    int child = generator_for_value->append_to(code);
+    int pos = code.size();
+    code.insert(
+        code.end(),
+        {static_cast<int>(GeneratorOpcode::SWITCH_SINGLE),
+         switch_var_id,
+         value,
+         child});
+    return pos;
+}
+
 GeneratorLeafVector::GeneratorLeafVector(
     vector<OperatorID>&& applicable_operators)
     : applicable_operators(std::move(applicable_operators))
@@ -189,6 +263,16 @@ void GeneratorLeafVector::generate_applicable_ops(
     }
 }
 
+int GeneratorLeafVector::append_to(vector<int>& code) const
+{
+    int pos = code.size();
+    code.push_back(static_cast<int>(GeneratorOpcode::LEAF));
+    code.push_back(applicable_operators.size());
+    for (OperatorID id : applicable_operators)
+        code.push_back(id.get_index());
+    return pos;
+}
+
 GeneratorLeafSingle::GeneratorLeafSingle(OperatorID applicable_operator)
     : applicable_operator(applicable_operator)
 {
@@ -201,4 +285,15 @@ void GeneratorLeafSingle::generate_applicable_ops(
     applicable_ops.push_back(applicable_operator);
 }
 
+int GeneratorLeafSingle::append_to(vector<int>& code) const
+{
+    int pos = code.size();
+    code.insert(
+        code.end(),
+        {static_cast<int>(GeneratorOpcode::LEAF),
+         1,
+         applicable_operator.get_index()});
+    return pos;
+}
+
 } // namespace successor_generator
@@ -0,0 +1,99 @@
+#include "downward/task_utils/successor_generator_program.h"
+
+#include "downward/task_utils/successor_generator_internals.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace successor_generator {
+GeneratorProgram::GeneratorProgram(const GeneratorBase& root)
+    : root(root.append_to(code))
+{
+    code.shrink_to_fit();
+}
+
+template <typename Values>
+void GeneratorProgram::generate_applicable_ops(
+    int node,
+    const Values& values,
+    vector<OperatorID>& applicable_ops) const
+{
+    /*
+      Nodes with a single child to visit are handled by continuing the loop
+      with the child, so we only recurse for all but the last child of a
+      fork.
+    */
+    while (true) {
+        const int* data = code.data() + node;
+        switch (static_cast<GeneratorOpcode>(data[0])) {
+        case GeneratorOpcode::FORK: {
+            int num_children = data[1];
+            if (num_children == 0) {
+                return;
+            }
+            for (int i = 0; i < num_children - 1; ++i) {
+                generate_applicable_ops(data[2 + i], values, applicable_ops);
+            }
+            node = data[1 + num_children];
+            break;
+        }
+        case GeneratorOpcode::SWITCH_VECTOR: {
+            int value = values[data[1]];
+            assert(value < data[2]);
+            node = data[3 + value];
+            if (node == -1) {
+                return;
+            }
+            break;
+        }
+        case GeneratorOpcode::SWITCH_SORTED: {
+            int value = values[data[1]];
+            int num_children = data[2];
+            const int* values_begin = data + 3;
+            const int* values_end = values_begin + num_children;
+            const int* it = lower_bound(values_begin, values_end, value);
+            if (it == values_end || *it != value) {
+                return;
+            }
+            node = values_end[it - values_begin];
+            break;
+        }
+        case GeneratorOpcode::SWITCH_SINGLE:
+            if (values[data[1]] != data[2]) {
+                return;
+            }
+            node = data[3];
+            break;
+        case GeneratorOpcode::LEAF: {
+            int num_operators = data[1];
+            for (int i = 0; i < num_operators; ++i) {
+                applicable_ops.emplace_back(data[2 + i]);
+            }
+            return;
+        }
+        }
+    }
+}
+
+void GeneratorProgram::generate_applicable_ops(
+    const vector<int>& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    generate_applicable_ops(root, state, applicable_ops);
+}
+
+void GeneratorProgram::generate_applicable_ops(
+    const PackedStateBin* buffer,
+    const int_packer::IntPacker& state_packer,
+    vector<OperatorID>& applicable_ops) const
+{
+    state_packer.visit_layout([&](const auto& vars) {
+        generate_applicable_ops(
+            root,
+            PackedValues(buffer, vars),
+            applicable_ops);
+    });
+}
+} // namespace successor_generator
@@ -87,9 +87,11 @@ int get_num_total_effects(const ClassicalPlanningTask& task_proxy)
 
 void print_variable_statistics(
     const AbstractPlanningTask& task_proxy,
+    StatePacking packing,
     utils::LogProxy& log)
 {
-    const int_packer::IntPacker& state_packer = g_state_packers[task_proxy];
+    const int_packer::IntPacker& state_packer =
+        g_state_packers[task_proxy][packing];
 
     int num_facts = 0;
     VariablesProxy variables = task_proxy.get_variables();
@@ -158,14 +160,79 @@ void dump_task(const ClassicalPlanningTask& task_proxy)
     dump_goals(task_proxy.get_goal());
 }
 
-PerTaskInformation<int_packer::IntPacker>
-    g_state_packers([](const AbstractPlanningTask& task_proxy) {
-        VariablesProxy variables = task_proxy.get_variables();
+/*
+  Return the values each variable can take in states reachable from the
+  initial state, sorted by value. This over-approximates the reachable
+  values by the initial value and the values of all effects. For tasks
+  without classical operators, all values are considered possible.
+*/
+static vector<vector<int>>
+get_possible_values(const AbstractPlanningTask& task_proxy)
+{
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<vector<bool>> is_possible;
+    is_possible.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        is_possible.emplace_back(var.get_domain_size(), false);
+    }
+    auto classical_task =
+        dynamic_cast<const ClassicalPlanningTask*>(&task_proxy);
+    if (classical_task) {
+        vector<int> initial_values = task_proxy.get_initial_state_values();
+        for (size_t var = 0; var < initial_values.size(); ++var) {
+            is_possible[var][initial_values[var]] = true;
+        }
+        for (OperatorProxy op : classical_task->get_operators()) {
+            for (FactProxy effect : op.get_effects()) {
+                FactPair fact = effect.get_pair();
+                is_possible[fact.var][fact.value] = true;
+            }
+        }
+    } else {
+        for (vector<bool>& values : is_possible) {
+            values.assign(values.size(), true);
+        }
+    }
+
+    vector<vector<int>> possible_values(is_possible.size());
+    for (size_t var = 0; var < is_possible.size(); ++var) {
+        for (size_t value = 0; value < is_possible[var].size(); ++value) {
+            if (is_possible[var][value]) {
+                possible_values[var].push_back(value);
+            }
+        }
+    }
+    return possible_values;
+}
+
+StatePackers::StatePackers(const AbstractPlanningTask& task)
+    : task(task)
+{
+}
+
+const int_packer::IntPacker& StatePackers::operator[](StatePacking packing)
+{
+    unique_ptr<int_packer::IntPacker>& packer =
+        packers[static_cast<int>(packing)];
+    if (!packer) {
+        VariablesProxy variables = task.get_variables();
         vector<int> variable_ranges;
         variable_ranges.reserve(variables.size());
         for (VariableProxy var : variables) {
             variable_ranges.push_back(var.get_domain_size());
         }
-        return std::make_unique<int_packer::IntPacker>(variable_ranges);
-    });
+        if (packing == StatePacking::DICTIONARY) {
+            packer = make_unique<int_packer::IntPacker>(
+                variable_ranges,
+                get_possible_values(task));
+        } else {
+            packer = make_unique<int_packer::IntPacker>(
+                variable_ranges,
+                packing == StatePacking::MINIMAL);
+        }
+    }
+    return *packer;
+}
+
+PerTaskInformation<StatePackers> g_state_packers;
 } // namespace task_properties
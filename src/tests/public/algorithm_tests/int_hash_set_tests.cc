@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/int_hash_set.h"
+#include "downward/algorithms/int_hash_set_64.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/*
+  Keys are indices into a vector of values and two keys are equal if they
+  refer to equal values, like StateIDs in the state registry.
+*/
+static std::uint64_t mix(std::uint64_t x)
+{
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+struct ValueHash {
+    const std::vector<std::uint64_t>& values;
+    std::uint64_t operator()(std::int64_t key) const
+    {
+        return mix(values[key]);
+    }
+};
+
+struct ValueHash32 {
+    const std::vector<std::uint64_t>& values;
+    int_hash_set::HashType operator()(int key) const
+    {
+        return static_cast<int_hash_set::HashType>(mix(values[key]));
+    }
+};
+
+struct ValueEqual {
+    const std::vector<std::uint64_t>& values;
+    bool operator()(std::int64_t lhs, std::int64_t rhs) const
+    {
+        return values[lhs] == values[rhs];
+    }
+};
+
+static std::vector<std::uint64_t> create_values(int num_keys, int num_values)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::uint64_t> dist(0, num_values - 1);
+    std::vector<std::uint64_t> values;
+    for (int i = 0; i < num_keys; ++i) {
+        values.push_back(dist(rng));
+    }
+    return values;
+}
+
+TEST(IntHashSetTestsPublic, test_int_hash_set_64_detects_duplicates)
+{
+    std::vector<std::uint64_t> values = create_values(100000, 30000);
+    int_hash_set::IntHashSet64<ValueHash, ValueEqual> hash_set(
+        ValueHash{values},
+        ValueEqual{values});
+    std::unordered_map<std::uint64_t, std::int64_t> first_key;
+    for (std::int64_t key = 0; key < std::ssize(values); ++key) {
+        auto [it, is_new] = first_key.emplace(values[key], key);
+        std::pair<std::int64_t, bool> result = hash_set.insert(key);
+        EXPECT_EQ(result.second, is_new);
+        EXPECT_EQ(result.first, it->second);
+        EXPECT_EQ(hash_set.size(), first_key.size());
+    }
+    for (const auto& [value, key] : first_key) {
+        std::int64_t found = hash_set.find(
+            mix(value),
+            [&](std::int64_t other) { return values[other] == value; });
+        EXPECT_EQ(found, key);
+    }
+    EXPECT_EQ(
+        hash_set.find(mix(30000), [](std::int64_t) { return true; }),
+        -1);
+}
+
+TEST(IntHashSetTestsPublic, test_insert_new_after_failed_find)
+{
+    std::vector<std::uint64_t> values = create_values(100000, 30000);
+    ValueHash32 hasher{values};
+    int_hash_set::IntHashSet<ValueHash32, ValueEqual> hash_set(
+        hasher,
+        ValueEqual{values});
+    std::unordered_map<std::uint64_t, int> first_key;
+    for (int key = 0; key < std::ssize(values); ++key) {
+        std::uint64_t value = values[key];
+        int found = hash_set.find(hasher(key), [&](int other) {
+            return values[other] == value;
+        });
+        if (found == -1) {
+            hash_set.insert_new_with_hash(key, hasher(key));
+            first_key.emplace(value, key);
+        } else {
+            EXPECT_EQ(found, first_key.at(value));
+        }
+        EXPECT_EQ(hash_set.size(), std::ssize(first_key));
+    }
+    for (const auto& [value, key] : first_key) {
+        EXPECT_EQ(hash_set.insert(key), std::make_pair(key, false));
+    }
+}
+
+/*
+  Microbenchmark comparing IntHashSet and IntHashSet64. Run it with
+  project_tests --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+*/
+template <typename HashSet>
+static void run_benchmark(
+    const std::string& name,
+    HashSet& hash_set,
+    int num_keys)
+{
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    for (int key = 0; key < num_keys; ++key) {
+        hash_set.insert(key);
+    }
+    Clock::time_point middle = Clock::now();
+    // All keys are inserted a second time, so these are pure lookups.
+    std::int64_t checksum = 0;
+    for (int key = 0; key < num_keys; ++key) {
+        checksum += hash_set.insert(key).first;
+    }
+    Clock::time_point end = Clock::now();
+    double insert_seconds =
+        std::chrono::duration<double>(middle - start).count();
+    double lookup_seconds =
+        std::chrono::duration<double>(end - middle).count();
+    std::cout << name << ": " << num_keys / insert_seconds / 1e6
+              << " M inserts/s, " << num_keys / lookup_seconds / 1e6
+              << " M lookups/s (checksum " << checksum << ")" << std::endl;
+}
+
+TEST(IntHashSetBenchmark, DISABLED_compare_insert_and_lookup_throughput)
+{
+    const int num_keys = 5000000;
+    std::vector<std::uint64_t> values = create_values(num_keys, num_keys);
+    {
+        int_hash_set::IntHashSet<ValueHash32, ValueEqual> hash_set(
+            ValueHash32{values},
+            ValueEqual{values});
+        run_benchmark("IntHashSet", hash_set, num_keys);
+    }
+    {
+        int_hash_set::IntHashSet64<ValueHash, ValueEqual> hash_set(
+            ValueHash{values},
+            ValueEqual{values});
+        run_benchmark("IntHashSet64", hash_set, num_keys);
+    }
+}
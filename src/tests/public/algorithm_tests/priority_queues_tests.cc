@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/priority_queues.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace priority_queues;
+
+/*
+  Dijkstra-like workload with monotone keys: every popped entry with key g
+  pushes successors with keys g + cost. The costs and numbers of successors
+  are drawn up front, so all queues see the same sequence of operations.
+*/
+struct Workload {
+    std::vector<int> num_successors;
+    std::vector<int> costs;
+};
+
+static Workload create_workload(int num_pushes, int min_cost, int max_cost)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> successor_dist(0, 4);
+    std::uniform_int_distribution<int> cost_dist(min_cost, max_cost);
+    Workload workload;
+    for (int i = 0; i < num_pushes; ++i) {
+        workload.num_successors.push_back(successor_dist(rng));
+        workload.costs.push_back(cost_dist(rng));
+    }
+    return workload;
+}
+
+// Return the popped keys in order.
+template <typename Queue>
+static std::vector<int> run_workload(Queue& queue, const Workload& workload)
+{
+    std::vector<int> popped_keys;
+    size_t next_cost = 0;
+    size_t next_expansion = 0;
+    queue.push(0, 0);
+    while (!queue.empty()) {
+        std::pair<int, int> entry = queue.pop();
+        popped_keys.push_back(entry.first);
+        // Keep the search alive until all costs are used.
+        int num_successors = std::max(
+            workload.num_successors[next_expansion],
+            queue.empty() ? 1 : 0);
+        next_expansion = (next_expansion + 1) % workload.num_successors.size();
+        for (int i = 0; i < num_successors; ++i) {
+            if (next_cost == workload.costs.size()) break;
+            queue.push(entry.first + workload.costs[next_cost++], entry.second);
+        }
+    }
+    return popped_keys;
+}
+
+TEST(PriorityQueuesTestsPublic, test_radix_heap_pops_like_heap)
+{
+    for (int max_cost : {1, 100, 100000}) {
+        Workload workload = create_workload(20000, 0, max_cost);
+        HeapQueue<int, int> heap;
+        RadixHeapQueue<int> radix_heap;
+        std::vector<int> expected = run_workload(heap, workload);
+        EXPECT_TRUE(std::is_sorted(expected.begin(), expected.end()));
+        EXPECT_EQ(run_workload(radix_heap, workload), expected);
+    }
+}
+
+TEST(PriorityQueuesTestsPublic, test_radix_heap_supports_negative_keys)
+{
+    RadixHeapQueue<int> queue;
+    std::vector<int> keys = {5, -3, 0, -2147483647 - 1, 2147483647, -3, 7};
+    for (int key : keys) {
+        queue.push(key, 0);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (int key : keys) {
+        ASSERT_FALSE(queue.empty());
+        EXPECT_EQ(queue.pop().first, key);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(PriorityQueuesTestsPublic, test_adaptive_queue_handles_non_monotone_keys)
+{
+    AdaptiveQueue<int> queue;
+    // Large keys switch the bucket queue to a radix heap.
+    for (int key : {1000, 5000, 3000, 2000}) {
+        queue.push(key, key);
+    }
+    EXPECT_EQ(queue.pop().first, 1000);
+    EXPECT_EQ(queue.pop().first, 2000);
+    // Keys below the last popped key switch it to a heap.
+    queue.push(10, 10);
+    queue.push(4000, 4000);
+    std::vector<int> popped_keys;
+    while (!queue.empty()) {
+        std::pair<int, int> entry = queue.pop();
+        EXPECT_EQ(entry.first, entry.second);
+        popped_keys.push_back(entry.first);
+    }
+    EXPECT_EQ(popped_keys, std::vector<int>({10, 3000, 4000, 5000}));
+}
+
+/*
+  Microbenchmark comparing the queues on monotone keys with unit costs,
+  small costs and large costs. Run it with
+  project_tests --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+*/
+template <typename Queue>
+static void
+run_benchmark(const std::string& name, Queue& queue, const Workload& workload)
+{
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    std::vector<int> popped_keys = run_workload(queue, workload);
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    std::int64_t checksum = 0;
+    for (int key : popped_keys) {
+        checksum += key;
+    }
+    std::cout << "  " << name << ": "
+              << popped_keys.size() / seconds / 1e6 << " M pops/s (checksum "
+              << checksum << ")" << std::endl;
+}
+
+TEST(PriorityQueuesBenchmark, DISABLED_compare_queues_on_monotone_keys)
+{
+    const int num_pushes = 5000000;
+    for (int max_cost : {1, 10, 1000, 100000}) {
+        std::cout << "Costs in [1, " << max_cost << "]:" << std::endl;
+        Workload workload = create_workload(num_pushes, 1, max_cost);
+        {
+            HeapQueue<int, int> queue;
+            run_benchmark("HeapQueue", queue, workload);
+        }
+        // Bucket queues with large keys need too much memory.
+        if (max_cost <= 10) {
+            BucketQueue<int> queue;
+            run_benchmark("BucketQueue", queue, workload);
+        }
+        {
+            RadixHeapQueue<int> queue;
+            run_benchmark("RadixHeapQueue", queue, workload);
+        }
+        {
+            AdaptiveQueue<int> queue;
+            run_benchmark("AdaptiveQueue", queue, workload);
+        }
+    }
+}
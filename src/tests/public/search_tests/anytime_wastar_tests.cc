@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/search_algorithms/anytime_wastar.h"
+
+#include "downward/heuristic.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+
+using namespace blind_search_heuristic;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+// Return the cost that is written at the end of the given plan file.
+static int read_plan_cost(const std::filesystem::path& plan_file)
+{
+    std::ifstream in(plan_file);
+    std::string line;
+    std::string last_line;
+    while (std::getline(in, line)) {
+        last_line = line;
+    }
+    std::string prefix = "; cost = ";
+    EXPECT_EQ(last_line.rfind(prefix, 0), 0u);
+    return std::stoi(last_line.substr(prefix.size()));
+}
+
+TEST(AnytimeWAstarTestsPublic, test_plans_improve_until_optimal)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    std::unique_ptr<SearchAlgorithm> astar =
+        create_astar_search_engine(task, create_blind_heuristic(task));
+    astar->search();
+    ASSERT_EQ(astar->get_status(), SOLVED);
+    int optimal_cost = calculate_plan_cost(astar->get_plan(), *task);
+
+    std::filesystem::path plan_file =
+        std::filesystem::temp_directory_path() / "anytime_wastar_test_plan";
+    for (bool reuse_search_space : {false, true}) {
+        anytime_wastar::AnytimeWAstarSearch search(
+            create_goal_count_heuristic(task),
+            {10, 5, 1},
+            true,
+            reuse_search_space,
+            task,
+            OperatorCost::NORMAL,
+            std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::infinity(),
+            StateHashing::PACKED_DATA,
+            std::make_shared<HeapStateStorage>(),
+            StatePacking::BINS,
+            SuccessorGeneratorType::TREE,
+            "anytime_wastar",
+            utils::Verbosity::SILENT);
+        search.get_plan_manager().set_plan_filename(plan_file.string());
+        search.search();
+        ASSERT_EQ(search.get_status(), SOLVED);
+        EXPECT_EQ(
+            calculate_plan_cost(search.get_plan(), *task),
+            optimal_cost);
+
+        // Each saved plan is cheaper than the one before.
+        int num_plans = 0;
+        int previous_cost = std::numeric_limits<int>::max();
+        while (true) {
+            std::filesystem::path numbered_plan_file =
+                plan_file.string() + "." + std::to_string(num_plans + 1);
+            if (!std::filesystem::exists(numbered_plan_file)) break;
+            int cost = read_plan_cost(numbered_plan_file);
+            EXPECT_LT(cost, previous_cost);
+            previous_cost = cost;
+            std::filesystem::remove(numbered_plan_file);
+            ++num_plans;
+        }
+        EXPECT_GE(num_plans, 1);
+        EXPECT_EQ(previous_cost, optimal_cost);
+    }
+}
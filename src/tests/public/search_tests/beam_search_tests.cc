@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/search_algorithms/beam_search.h"
+
+#include "downward/heuristic.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <limits>
+
+using namespace blind_search_heuristic;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+static int run_beam_search(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    const std::shared_ptr<Evaluator>& evaluator,
+    int width)
+{
+    beam_search::BeamSearch search(
+        evaluator,
+        width,
+        true,
+        task,
+        OperatorCost::NORMAL,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "beam",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    // States are not registered, apart from the initial state.
+    EXPECT_LE(search.get_state_registry().size(), 1);
+    return get_plan_cost(*task, search.get_plan());
+}
+
+TEST(BeamSearchTestsPublic, test_narrow_beam_finds_plan)
+{
+    Gripper domain(2, 6);
+    auto task = create_gripper_task(domain, 6);
+    run_beam_search(task, create_goal_count_heuristic(task), 10);
+}
+
+TEST(BeamSearchTestsPublic, test_unbounded_width_is_breadth_first)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+    int optimal_cost = compute_optimal_cost(task);
+
+    // Gripper has unit costs, so breadth-first search finds optimal plans.
+    EXPECT_EQ(
+        run_beam_search(task, create_blind_heuristic(task), 1000000),
+        optimal_cost);
+}
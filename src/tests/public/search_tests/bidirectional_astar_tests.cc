@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/search_algorithms/bidirectional_astar.h"
+
+#include "downward/heuristic.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/domains/blocksworld.h"
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <limits>
+
+using namespace blind_search_heuristic;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+static int run_bidirectional_astar(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    const std::shared_ptr<Evaluator>& evaluator)
+{
+    bidirectional_astar::BidirectionalAStarSearch search(
+        evaluator,
+        task,
+        OperatorCost::NORMAL,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "bidirectional_astar",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    EXPECT_TRUE(
+        task_properties::is_goal_state(*task, search.get_goal_state()));
+    return get_plan_cost(*task, search.get_plan());
+}
+
+TEST(BidirectionalAStarTestsPublic, test_gripper_optimal)
+{
+    Gripper domain(2, 4);
+    std::vector<FactPair> initial_state = {
+        domain.get_fact_robot_at_room(0),
+        domain.get_fact_carry_left_none(),
+        domain.get_fact_carry_right_none()};
+    std::vector<FactPair> goal;
+    for (int ball = 0; ball < 4; ++ball) {
+        initial_state.push_back(domain.get_fact_ball_at_room(ball, 0));
+        goal.push_back(domain.get_fact_ball_at_room(ball, 1));
+    }
+    auto task = create_task_from_domain(domain, initial_state, goal);
+
+    int optimal_cost = compute_optimal_cost(task);
+    EXPECT_EQ(
+        run_bidirectional_astar(task, create_blind_heuristic(task)),
+        optimal_cost);
+}
+
+TEST(BidirectionalAStarTestsPublic, test_blocksworld_optimal_with_costs)
+{
+    // Reverse a tower of 4 blocks with different pick and put costs.
+    BlocksWorld domain(4, 3, 1);
+    std::vector<FactPair> initial_state = {
+        domain.get_fact_is_hand_empty(true),
+        domain.get_fact_location_on_table(0),
+        domain.get_fact_location_on_block(1, 0),
+        domain.get_fact_location_on_block(2, 1),
+        domain.get_fact_location_on_block(3, 2),
+        domain.get_fact_is_clear(0, false),
+        domain.get_fact_is_clear(1, false),
+        domain.get_fact_is_clear(2, false),
+        domain.get_fact_is_clear(3, true)};
+    std::vector<FactPair> goal = {
+        domain.get_fact_location_on_table(3),
+        domain.get_fact_location_on_block(2, 3),
+        domain.get_fact_location_on_block(1, 2),
+        domain.get_fact_location_on_block(0, 1)};
+    auto task = create_task_from_domain(domain, initial_state, goal);
+
+    int optimal_cost = compute_optimal_cost(task);
+    EXPECT_EQ(
+        run_bidirectional_astar(task, create_blind_heuristic(task)),
+        optimal_cost);
+    EXPECT_EQ(
+        run_bidirectional_astar(task, create_goal_count_heuristic(task)),
+        optimal_cost);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "downward/concurrent_state_registry.h"
+#include "downward/per_state_information.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/task_utils.h"
+
+#include <deque>
+#include <set>
+#include <thread>
+
+using namespace tests;
+
+// Registers all reachable states and returns their IDs.
+template <typename Registry>
+static std::set<int>
+explore_state_space(const ClassicalPlanningTask& task, Registry& registry)
+{
+    std::set<int> reached;
+    std::deque<State> queue = {registry.get_initial_state()};
+    reached.insert(queue.front().get_id().get_value());
+    while (!queue.empty()) {
+        State state = queue.front();
+        queue.pop_front();
+        for (OperatorProxy op : task.get_operators()) {
+            if (task_properties::is_applicable(op, state)) {
+                State succ = registry.get_successor_state(state, op);
+                if (reached.insert(succ.get_id().get_value()).second) {
+                    queue.push_back(succ);
+                }
+            }
+        }
+    }
+    return reached;
+}
+
+TEST(ConcurrentStateRegistryTestsPublic, test_registers_states_once)
+{
+    Gripper domain(2, 4);
+    std::shared_ptr<ClassicalPlanningTask> task =
+        create_gripper_task(domain, 4);
+
+    StateRegistry sequential_registry(*task);
+    size_t num_states =
+        explore_state_space(*task, sequential_registry).size();
+    ASSERT_EQ(sequential_registry.size(), num_states);
+
+    // All threads explore the whole state space and must get the same IDs.
+    const int num_threads = 4;
+    ConcurrentStateRegistry registry(*task, 3);
+    std::vector<std::set<int>> reached(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&, i]() {
+            reached[i] = explore_state_space(*task, registry);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(registry.size(), num_states);
+    for (int i = 0; i < num_threads; ++i) {
+        EXPECT_EQ(reached[i], reached[0]);
+    }
+
+    PerStateInformation<int> ids(-1);
+    for (int id : reached[0]) {
+        ASSERT_LT(static_cast<size_t>(id), registry.get_state_id_bound());
+        State state = registry.lookup_state(StateID(id));
+        EXPECT_EQ(ids[state], -1);
+        ids[state] = id;
+        state.unpack();
+        std::vector<int> values = state.get_unpacked_values();
+        State copy = registry.insert_state(std::move(values));
+        EXPECT_EQ(copy.get_id(), state.get_id());
+        EXPECT_EQ(ids[copy], id);
+    }
+}
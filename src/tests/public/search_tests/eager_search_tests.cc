@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/search_algorithms/eager_search.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/heuristic.h"
+#include "downward/open_list_factory.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/nomystery.h"
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+using namespace blind_search_heuristic;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+
+static int run_astar(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    bool store_parent_pointers,
+    OperatorCost cost_type,
+    int incremental_successors = 0,
+    int batch_expansions = 0)
+{
+    std::shared_ptr<Evaluator> heuristic = create_blind_heuristic(task);
+    auto [open_list_factory, f_eval] =
+        search_common::create_astar_open_list_factory_and_f_eval(
+            heuristic,
+            utils::Verbosity::SILENT);
+    eager_search::EagerSearch search(
+        open_list_factory,
+        true,
+        f_eval,
+        {},
+        nullptr,
+        store_parent_pointers,
+        incremental_successors,
+        batch_expansions > 0 ? heuristic : nullptr,
+        std::max(batch_expansions, 1),
+        task,
+        cost_type,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "astar",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    return get_plan_cost(*task, search.get_plan());
+}
+
+TEST(EagerSearchTestsPublic, test_plans_without_parent_pointers_are_optimal)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    int optimal_cost = run_astar(task, true, OperatorCost::NORMAL);
+    EXPECT_EQ(run_astar(task, false, OperatorCost::NORMAL), optimal_cost);
+    EXPECT_EQ(run_astar(task, false, OperatorCost::PLUSONE), optimal_cost);
+}
+
+TEST(EagerSearchTestsPublic, test_incremental_successors_find_optimal_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    int optimal_cost = run_astar(task, true, OperatorCost::NORMAL);
+    // A cache of a single state forces falling back to full generation.
+    for (int cache_size : {1, 10, 100000}) {
+        EXPECT_EQ(
+            run_astar(task, true, OperatorCost::NORMAL, cache_size),
+            optimal_cost);
+    }
+}
+
+TEST(EagerSearchTestsPublic, test_batched_evaluation_finds_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    int optimal_cost = run_astar(task, true, OperatorCost::NORMAL);
+    EXPECT_EQ(run_astar(task, true, OperatorCost::NORMAL, 0, 1), optimal_cost);
+    // Larger windows expand states before all earlier successors are queued.
+    EXPECT_GE(run_astar(task, true, OperatorCost::NORMAL, 0, 7), optimal_cost);
+}
+
+static const int NUM_LOCATIONS = 8;
+static const int NUM_PACKAGES = 4;
+
+// A truck on a line of locations.
+static NoMystery create_line_domain()
+{
+    std::set<RoadMapEdge> roadmap;
+    for (int location = 0; location + 1 < NUM_LOCATIONS; ++location) {
+        roadmap.insert({location, location + 1});
+        roadmap.insert({location + 1, location});
+    }
+    return NoMystery(NUM_LOCATIONS, NUM_PACKAGES, 2, roadmap);
+}
+
+// The truck delivers all packages. The task refers to the domain.
+static std::shared_ptr<ClassicalPlanningTask>
+create_delivery_task(const NoMystery& domain)
+{
+    int num_locations = NUM_LOCATIONS;
+    int num_packages = NUM_PACKAGES;
+    std::vector<FactPair> initial_state = {
+        domain.get_fact_truck_at_location(num_locations / 2),
+        domain.get_fact_packages_loaded(0)};
+    std::vector<FactPair> goal;
+    for (int package = 0; package < num_packages; ++package) {
+        initial_state.push_back(domain.get_fact_package_at_location(
+            package,
+            (3 * package) % num_locations));
+        goal.push_back(domain.get_fact_package_at_location(
+            package,
+            (5 * package + num_locations - 1) % num_locations));
+    }
+    return create_task_from_domain(domain, initial_state, goal);
+}
+
+TEST(EagerSearchTestsPublic, test_batched_evaluation_handles_reopened_states)
+{
+    NoMystery domain = create_line_domain();
+    auto task = create_delivery_task(domain);
+
+    // Weighted A* with goal counting reopens states on this task.
+    for (int batch_expansions : {1, 20}) {
+        std::shared_ptr<Evaluator> heuristic =
+            create_goal_count_heuristic(task);
+        eager_search::EagerSearch search(
+            search_common::create_wastar_open_list_factory(
+                {heuristic},
+                {},
+                0,
+                5,
+                utils::Verbosity::SILENT),
+            true,
+            nullptr,
+            {},
+            nullptr,
+            true,
+            0,
+            heuristic,
+            batch_expansions,
+            task,
+            OperatorCost::NORMAL,
+            std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::infinity(),
+            StateHashing::PACKED_DATA,
+            std::make_shared<HeapStateStorage>(),
+            StatePacking::BINS,
+            SuccessorGeneratorType::TREE,
+            "wastar",
+            utils::Verbosity::SILENT);
+        search.search();
+        ASSERT_EQ(search.get_status(), SOLVED);
+        EXPECT_GT(search.get_statistics().get_reopened(), 0);
+        // Each package needs at least a load and an unload.
+        EXPECT_GE(get_plan_cost(*task, search.get_plan()), 2 * NUM_PACKAGES);
+    }
+}
+
+TEST(EagerSearchTestsPublic, test_batched_evaluation_keeps_updated_states)
+{
+    NoMystery domain = create_line_domain();
+    auto task = create_delivery_task(domain);
+
+    /*
+      Without reopening, states that are reached on a cheaper path before
+      their batch is evaluated only get a new parent. They must still be
+      inserted into the open list, so the bounded search expands every
+      state it registers.
+    */
+    for (int batch_expansions : {1, 20}) {
+        std::shared_ptr<Evaluator> heuristic =
+            create_goal_count_heuristic(task);
+        eager_search::EagerSearch search(
+            search_common::create_greedy_open_list_factory({heuristic}, {}, 0),
+            false,
+            nullptr,
+            {},
+            nullptr,
+            true,
+            0,
+            heuristic,
+            batch_expansions,
+            task,
+            OperatorCost::NORMAL,
+            12,
+            std::numeric_limits<double>::infinity(),
+            StateHashing::PACKED_DATA,
+            std::make_shared<HeapStateStorage>(),
+            StatePacking::BINS,
+            SuccessorGeneratorType::TREE,
+            "eager_greedy",
+            utils::Verbosity::SILENT);
+        search.search();
+        ASSERT_EQ(search.get_status(), FAILED);
+        EXPECT_EQ(
+            search.get_statistics().get_expanded(),
+            static_cast<int>(search.get_state_registry().size()));
+    }
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_algorithms/external_bfs.h"
+
+#include "downward/heuristic.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <filesystem>
+#include <limits>
+#include <utility>
+
+using namespace tests;
+
+TEST(ExternalBFSTestsPublic, test_finds_optimal_plan_with_small_buffers)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+    int optimal_cost = compute_optimal_cost(task);
+
+    std::filesystem::path scratch_dir =
+        std::filesystem::temp_directory_path() / "external_bfs_test";
+    std::filesystem::create_directories(scratch_dir);
+    // Gripper operators can be undone, so a locality of 2 suffices.
+    for (auto [locality, merge_fan_in] :
+         {std::pair(std::numeric_limits<int>::max(), 64), std::pair(2, 2)}) {
+        {
+            /*
+              Tiny buffers force many runs and refills. Merging two runs at
+              a time needs several passes per layer.
+            */
+            external_bfs::ExternalBFSSearch search(
+                scratch_dir.string(),
+                7,
+                3,
+                merge_fan_in,
+                locality,
+                task,
+                OperatorCost::NORMAL,
+                std::numeric_limits<int>::max(),
+                std::numeric_limits<double>::infinity(),
+                StateHashing::PACKED_DATA,
+                std::make_shared<HeapStateStorage>(),
+                StatePacking::BINS,
+                SuccessorGeneratorType::TREE,
+                "external_bfs",
+                utils::Verbosity::SILENT);
+            search.search();
+            ASSERT_EQ(search.get_status(), SOLVED);
+
+            EXPECT_EQ(get_plan_cost(*task, search.get_plan()), optimal_cost);
+
+            const SearchStatistics& statistics = search.get_statistics();
+            EXPECT_GT(statistics.get_bytes_written(), 0);
+            EXPECT_GT(statistics.get_bytes_read(), 0);
+        }
+        // The layer and run files are removed with the search.
+        EXPECT_TRUE(std::filesystem::is_empty(scratch_dir));
+    }
+    std::filesystem::remove(scratch_dir);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/search_algorithms/hda_astar.h"
+
+#include "downward/heuristic.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+using namespace blind_search_heuristic;
+using namespace tests;
+
+
+static int run_hda_astar(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    int num_threads)
+{
+    std::vector<std::shared_ptr<Evaluator>> evaluators;
+    for (int i = 0; i < num_threads; ++i) {
+        evaluators.push_back(create_blind_heuristic(task));
+    }
+    hda_astar::HDAStarSearch search(
+        evaluators,
+        task,
+        OperatorCost::NORMAL,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "hda_astar",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    return get_plan_cost(*task, search.get_plan());
+}
+
+TEST(HDAStarTestsPublic, test_optimal_like_astar)
+{
+    // 2 rooms, 4 balls
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    auto astar = create_astar_search_engine(task, create_blind_heuristic(task));
+    astar->search();
+    ASSERT_EQ(astar->get_status(), SOLVED);
+    int optimal_cost = get_plan_cost(*task, astar->get_plan());
+
+    ASSERT_EQ(run_hda_astar(task, 1), optimal_cost);
+    ASSERT_EQ(run_hda_astar(task, 4), optimal_cost);
+}
+
+TEST(HDAStarTestsPublic, test_stress_more_threads_than_cores)
+{
+    /*
+      With more threads than cores, workers are descheduled at arbitrary
+      points, so messages are often received while their senders are still
+      expanding. The search must neither terminate early nor lose messages.
+    */
+    Gripper domain(2, 6);
+    auto task = create_gripper_task(domain, 6);
+
+    auto astar = create_astar_search_engine(task, create_blind_heuristic(task));
+    astar->search();
+    ASSERT_EQ(astar->get_status(), SOLVED);
+    int optimal_cost = get_plan_cost(*task, astar->get_plan());
+
+    int num_cores = std::max(1U, std::thread::hardware_concurrency());
+    int num_threads = std::max(16, 4 * num_cores + 1);
+    for (int run = 0; run < 10; ++run) {
+        ASSERT_EQ(run_hda_astar(task, num_threads), optimal_cost);
+    }
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/search_algorithms/lazy_search.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/heuristic.h"
+#include "downward/open_list_factory.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <limits>
+
+using namespace blind_search_heuristic;
+using namespace tests;
+
+
+static int run_lazy_search(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    const std::shared_ptr<OpenListFactory>& open_list_factory,
+    bool reopen_closed,
+    bool randomize_successors,
+    int random_seed)
+{
+    lazy_search::LazySearch search(
+        open_list_factory,
+        reopen_closed,
+        randomize_successors,
+        random_seed,
+        task,
+        OperatorCost::NORMAL,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "lazy",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    return get_plan_cost(*task, search.get_plan());
+}
+
+TEST(LazySearchTestsPublic, test_lazy_greedy_finds_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    for (bool randomize_successors : {false, true}) {
+        for (int random_seed : {1, 2, 3}) {
+            auto open_list_factory =
+                search_common::create_greedy_open_list_factory(
+                    {create_blind_heuristic(task)},
+                    {},
+                    0);
+            run_lazy_search(
+                task,
+                open_list_factory,
+                false,
+                randomize_successors,
+                random_seed);
+        }
+    }
+}
+
+/*
+  With the blind heuristic and unit costs, the key g + h(parent) of an edge
+  equals g + 1 for all edges, so lazy A* expands the states in order of their
+  g values and finds optimal plans.
+*/
+TEST(LazySearchTestsPublic, test_lazy_wastar_finds_optimal_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    std::unique_ptr<SearchAlgorithm> astar =
+        create_astar_search_engine(task, create_blind_heuristic(task));
+    astar->search();
+    ASSERT_EQ(astar->get_status(), SOLVED);
+    int optimal_cost = get_plan_cost(*task, astar->get_plan());
+
+    auto open_list_factory = search_common::create_wastar_open_list_factory(
+        {create_blind_heuristic(task)},
+        {},
+        0,
+        1,
+        utils::Verbosity::SILENT);
+    EXPECT_EQ(
+        run_lazy_search(task, open_list_factory, true, false, -1),
+        optimal_cost);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/search_algorithms/idastar.h"
+#include "downward/search_algorithms/rbfs.h"
+
+#include "downward/heuristic.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/gripper.h"
+#include "tests/domains/nomystery.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <limits>
+#include <set>
+
+using namespace goal_count_heuristic;
+using namespace tests;
+
+// Estimates the cost of one state and 0 for all others.
+class SingleStateHeuristic : public Heuristic {
+    std::vector<int> values;
+    int h;
+
+public:
+    SingleStateHeuristic(
+        const std::shared_ptr<ClassicalPlanningTask>& task,
+        std::vector<int> values,
+        int h)
+        : Heuristic(task)
+        , values(std::move(values))
+        , h(h)
+    {
+    }
+
+    virtual int compute_heuristic(const State& state) override
+    {
+        state.unpack();
+        return state.get_unpacked_values() == values ? h : 0;
+    }
+};
+
+template <typename Search>
+static int run_linear_memory_search(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    int transposition_table_size)
+{
+    Search search(
+        create_goal_count_heuristic(task),
+        transposition_table_size,
+        task,
+        OperatorCost::NORMAL,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "linear_memory_search",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    // States are not registered, apart from the initial state.
+    EXPECT_LE(search.get_state_registry().size(), 1);
+    return get_plan_cost(*task, search.get_plan());
+}
+
+TEST(LinearMemorySearchTestsPublic, test_idastar_finds_optimal_plans)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+    int optimal_cost = compute_optimal_cost(task);
+    for (int transposition_table_size : {0, 16, 100000}) {
+        EXPECT_EQ(
+            run_linear_memory_search<idastar::IDAStarSearch>(
+                task,
+                transposition_table_size),
+            optimal_cost);
+    }
+}
+
+TEST(LinearMemorySearchTestsPublic, test_rbfs_finds_optimal_plans)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+    int optimal_cost = compute_optimal_cost(task);
+    for (int transposition_table_size : {0, 16, 100000}) {
+        EXPECT_EQ(
+            run_linear_memory_search<rbfs::RBFSSearch>(
+                task,
+                transposition_table_size),
+            optimal_cost);
+    }
+}
+
+TEST(LinearMemorySearchTestsPublic, test_rbfs_stores_path_independent_values)
+{
+    /*
+      The truck at location 1 must bring package 0 from location 0 to
+      location 2. Driving between 0 and 1 is free, driving to 2 costs 3.
+    */
+    std::set<RoadMapEdge> roadmap = {
+        {0, 1, 0},
+        {1, 0, 0},
+        {1, 2, 3},
+        {2, 1, 3}};
+    NoMystery domain(3, 2, 2, roadmap);
+    std::vector<FactPair> goal = {
+        domain.get_fact_package_at_location(0, 2),
+        domain.get_fact_package_at_location(1, 1)};
+    auto task = create_task_from_domain(
+        domain,
+        {domain.get_fact_truck_at_location(1),
+         domain.get_fact_packages_loaded(0),
+         domain.get_fact_package_at_location(0, 0),
+         domain.get_fact_package_at_location(1, 1)},
+        goal);
+
+    /*
+      The heuristic is admissible but inconsistent: it is exact for the
+      truck at location 0 before loading and 0 elsewhere. Then RBFS first
+      abandons a subtree in which the cheapest continuation leads back to a
+      state on the path. Storing its value overestimated the cost on the
+      next visit, and the search returned a plan of cost 7 instead of 5.
+    */
+    std::vector<int> truck_at_0(task->get_num_variables());
+    truck_at_0[domain.get_variable_truck_at()] = 0;
+    truck_at_0[domain.get_variable_packages_loaded()] = 0;
+    truck_at_0[domain.get_variable_package_at(0)] = 0;
+    truck_at_0[domain.get_variable_package_at(1)] = 1;
+    for (int transposition_table_size : {0, 1000}) {
+        rbfs::RBFSSearch search(
+            std::make_shared<SingleStateHeuristic>(task, truck_at_0, 5),
+            transposition_table_size,
+            task,
+            OperatorCost::NORMAL,
+            std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::infinity(),
+            StateHashing::PACKED_DATA,
+            std::make_shared<HeapStateStorage>(),
+            StatePacking::BINS,
+            SuccessorGeneratorType::TREE,
+            "rbfs",
+            utils::Verbosity::SILENT);
+        search.search();
+        ASSERT_EQ(search.get_status(), SOLVED);
+        EXPECT_EQ(get_plan_cost(*task, search.get_plan()), 5);
+    }
+}
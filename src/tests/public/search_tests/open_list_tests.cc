@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+
+#include "downward/evaluators/g_evaluator.h"
+#include "downward/evaluators/sum_evaluator.h"
+#include "downward/evaluators/weighted_evaluator.h"
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/open_lists/best_first_open_list.h"
+#include "downward/open_lists/bucket_open_list.h"
+#include "downward/open_lists/epsilon_greedy_open_list.h"
+#include "downward/open_lists/multi_queue_open_list.h"
+#include "downward/open_lists/pareto_open_list.h"
+#include "downward/open_lists/tiebreaking_open_list.h"
+#include "downward/open_lists/type_based_open_list.h"
+#include "downward/search_algorithms/eager_search.h"
+
+#include "downward/heuristic.h"
+#include "downward/open_list_factory.h"
+#include "downward/search_algorithm.h"
+#include "downward/task_proxy.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/task_utils.h"
+
+#include <limits>
+
+using namespace goal_count_heuristic;
+using namespace tests;
+
+struct SearchResult {
+    int plan_cost;
+    int expanded;
+    int evaluated;
+};
+
+static SearchResult run_search(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    const std::shared_ptr<OpenListFactory>& open_list_factory,
+    const std::shared_ptr<Evaluator>& f_eval)
+{
+    eager_search::EagerSearch search(
+        open_list_factory,
+        true,
+        f_eval,
+        {},
+        nullptr,
+        true,
+        0,
+        nullptr,
+        1,
+        task,
+        OperatorCost::NORMAL,
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::make_shared<HeapStateStorage>(),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
+        "eager",
+        utils::Verbosity::SILENT);
+    search.search();
+    EXPECT_EQ(search.get_status(), SOLVED);
+    const SearchStatistics& statistics = search.get_statistics();
+    return {
+        calculate_plan_cost(search.get_plan(), *task),
+        statistics.get_expanded(),
+        statistics.get_evaluated_states()};
+}
+
+static void expect_same_search(const SearchResult& lhs, const SearchResult& rhs)
+{
+    EXPECT_EQ(lhs.plan_cost, rhs.plan_cost);
+    EXPECT_EQ(lhs.expanded, rhs.expanded);
+    EXPECT_EQ(lhs.evaluated, rhs.evaluated);
+}
+
+/*
+  Return the evaluators [weight * g + h, h]. A large weight makes the first
+  key too sparse for the buckets.
+*/
+static std::vector<std::shared_ptr<Evaluator>> create_evaluators(
+    const std::shared_ptr<ClassicalPlanningTask>& task,
+    int weight)
+{
+    std::shared_ptr<Evaluator> h = create_goal_count_heuristic(task);
+    std::shared_ptr<Evaluator> g = std::make_shared<g_evaluator::GEvaluator>(
+        "g",
+        utils::Verbosity::SILENT);
+    std::shared_ptr<Evaluator> weighted_g =
+        std::make_shared<weighted_evaluator::WeightedEvaluator>(
+            g,
+            weight,
+            "weighted_g",
+            utils::Verbosity::SILENT);
+    std::shared_ptr<Evaluator> f =
+        std::make_shared<sum_evaluator::SumEvaluator>(
+            std::vector<std::shared_ptr<Evaluator>>({weighted_g, h}),
+            "f",
+            utils::Verbosity::SILENT);
+    return {f, h};
+}
+
+static void test_same_order_as_tiebreaking(int weight)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::vector<std::shared_ptr<Evaluator>> evals =
+        create_evaluators(task, weight);
+
+    SearchResult expected = run_search(
+        task,
+        std::make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(
+            evals,
+            false),
+        evals[0]);
+    SearchResult result = run_search(
+        task,
+        std::make_shared<bucket_open_list::BucketOpenListFactory>(evals, false),
+        evals[0]);
+    expect_same_search(result, expected);
+}
+
+TEST(BucketOpenListTestsPublic, test_astar_expands_like_tiebreaking)
+{
+    test_same_order_as_tiebreaking(1);
+}
+
+TEST(BucketOpenListTestsPublic, test_sparse_keys_expand_like_tiebreaking)
+{
+    test_same_order_as_tiebreaking(1000);
+}
+
+TEST(BucketOpenListTestsPublic, test_single_key_expands_like_best_first)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::shared_ptr<Evaluator> h = create_goal_count_heuristic(task);
+
+    SearchResult expected = run_search(
+        task,
+        std::make_shared<standard_scalar_open_list::BestFirstOpenListFactory>(
+            h),
+        nullptr);
+    SearchResult result = run_search(
+        task,
+        std::make_shared<bucket_open_list::BucketOpenListFactory>(
+            std::vector<std::shared_ptr<Evaluator>>({h}),
+            false),
+        nullptr);
+    expect_same_search(result, expected);
+}
+
+TEST(TieBreakingOpenListTestsPublic, test_key_arities_expand_alike)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::vector<std::shared_ptr<Evaluator>> evals = create_evaluators(task, 1);
+    std::shared_ptr<Evaluator> f = evals[0];
+    std::shared_ptr<Evaluator> h = evals[1];
+
+    SearchResult expected = run_search(
+        task,
+        std::make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(
+            evals,
+            false),
+        f);
+    /*
+      Repeating h does not change the order. Keys with three evaluators are
+      stored inline, keys with four fall back to vectors.
+    */
+    for (int num_evals : {3, 4}) {
+        std::vector<std::shared_ptr<Evaluator>> repeated_evals = evals;
+        repeated_evals.resize(num_evals, h);
+        SearchResult result = run_search(
+            task,
+            std::make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(
+                repeated_evals,
+                false),
+            f);
+        expect_same_search(result, expected);
+    }
+}
+
+TEST(ParetoOpenListTestsPublic, test_all_key_arities_find_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::vector<std::shared_ptr<Evaluator>> evals = create_evaluators(task, 1);
+    for (int num_evals : {1, 2, 3, 4}) {
+        std::vector<std::shared_ptr<Evaluator>> repeated_evals = evals;
+        repeated_evals.resize(num_evals, evals[1]);
+        run_search(
+            task,
+            std::make_shared<pareto_open_list::ParetoOpenListFactory>(
+                repeated_evals,
+                false,
+                42),
+            nullptr);
+    }
+}
+
+TEST(TypeBasedOpenListTestsPublic, test_all_key_arities_find_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::vector<std::shared_ptr<Evaluator>> evals = create_evaluators(task, 1);
+    std::shared_ptr<Evaluator> g = std::make_shared<g_evaluator::GEvaluator>(
+        "g",
+        utils::Verbosity::SILENT);
+    for (int num_evals : {1, 2, 4}) {
+        std::vector<std::shared_ptr<Evaluator>> type_evals = {g, evals[1]};
+        type_evals.resize(num_evals, evals[0]);
+        auto factory =
+            std::make_shared<type_based_open_list::TypeBasedOpenListFactory>(
+                type_evals,
+                42);
+        SearchResult result = run_search(task, factory, nullptr);
+        // The same seed leads to the same search.
+        expect_same_search(run_search(task, factory, nullptr), result);
+    }
+}
+
+TEST(MultiQueueOpenListTestsPublic, test_one_queue_expands_like_epsilon_greedy)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::shared_ptr<Evaluator> h = create_goal_count_heuristic(task);
+    for (double epsilon : {0.0, 0.2}) {
+        SearchResult expected = run_search(
+            task,
+            std::make_shared<
+                epsilon_greedy_open_list::EpsilonGreedyOpenListFactory>(
+                h,
+                epsilon,
+                42),
+            nullptr);
+        SearchResult result = run_search(
+            task,
+            std::make_shared<multi_queue_open_list::MultiQueueOpenListFactory>(
+                std::vector<std::shared_ptr<Evaluator>>({h}),
+                epsilon,
+                42),
+            nullptr);
+        expect_same_search(result, expected);
+    }
+}
+
+TEST(MultiQueueOpenListTestsPublic, test_multiple_queues_find_plans)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+    std::vector<std::shared_ptr<Evaluator>> evals = create_evaluators(task, 1);
+    std::shared_ptr<Evaluator> g = std::make_shared<g_evaluator::GEvaluator>(
+        "g",
+        utils::Verbosity::SILENT);
+    evals.push_back(g);
+    for (double epsilon : {0.0, 0.2}) {
+        auto factory =
+            std::make_shared<multi_queue_open_list::MultiQueueOpenListFactory>(
+                evals,
+                epsilon,
+                42);
+        SearchResult result = run_search(task, factory, nullptr);
+        expect_same_search(run_search(task, factory, nullptr), result);
+    }
+}
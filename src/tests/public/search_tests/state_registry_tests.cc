@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/flat_operator_table.h"
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/task_utils.h"
+
+#include <algorithm>
+#include <deque>
+
+using namespace tests;
+
+TEST(StateRegistryTestsPublic, test_zobrist_hashing_registers_same_states)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+
+    // Explore the state space in both registries in lockstep.
+    StateRegistry packed_registry(*task, StateHashing::PACKED_DATA);
+    StateRegistry zobrist_registry(*task, StateHashing::ZOBRIST);
+    std::deque<StateID> queue = {
+        packed_registry.get_initial_state().get_id()};
+    EXPECT_EQ(zobrist_registry.get_initial_state().get_id(), queue.front());
+    while (!queue.empty()) {
+        StateID id = queue.front();
+        queue.pop_front();
+        State packed_state = packed_registry.lookup_state(id);
+        State zobrist_state = zobrist_registry.lookup_state(id);
+        for (OperatorProxy op : task->get_operators()) {
+            if (!task_properties::is_applicable(op, packed_state)) {
+                continue;
+            }
+            size_t num_states = packed_registry.size();
+            State packed_succ =
+                packed_registry.get_successor_state(packed_state, op);
+            State zobrist_succ =
+                zobrist_registry.get_successor_state(zobrist_state, op);
+            ASSERT_EQ(packed_succ.get_id(), zobrist_succ.get_id());
+            if (packed_registry.size() > num_states) {
+                queue.push_back(packed_succ.get_id());
+            }
+
+            // The incremental hash must match the hash computed from scratch.
+            StateRegistry fresh_registry(*task, StateHashing::ZOBRIST);
+            zobrist_succ.unpack();
+            std::vector<int> values = zobrist_succ.get_unpacked_values();
+            State fresh_succ = fresh_registry.insert_state(std::move(values));
+            EXPECT_EQ(
+                fresh_registry.get_state_hash(fresh_succ),
+                zobrist_registry.get_state_hash(zobrist_succ));
+        }
+    }
+    EXPECT_EQ(packed_registry.size(), zobrist_registry.size());
+}
+
+TEST(StateRegistryTestsPublic, test_state_packings_register_same_states)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+
+    for (StatePacking packing :
+         {StatePacking::MINIMAL, StatePacking::DICTIONARY}) {
+        // Explore the state space in both registries in lockstep.
+        StateRegistry bins_registry(*task);
+        StateRegistry registry(
+            *task,
+            StateHashing::PACKED_DATA,
+            nullptr,
+            packing);
+        EXPECT_LE(
+            registry.get_state_size_in_bytes(),
+            bins_registry.get_state_size_in_bytes());
+        std::deque<StateID> queue = {
+            bins_registry.get_initial_state().get_id()};
+        EXPECT_EQ(registry.get_initial_state().get_id(), queue.front());
+        while (!queue.empty()) {
+            StateID id = queue.front();
+            queue.pop_front();
+            State bins_state = bins_registry.lookup_state(id);
+            State state = registry.lookup_state(id);
+            for (int var = 0; var < task->get_num_variables(); ++var) {
+                ASSERT_EQ(state[var], bins_state[var]);
+            }
+            for (OperatorProxy op : task->get_operators()) {
+                if (!task_properties::is_applicable(op, bins_state)) {
+                    continue;
+                }
+                size_t num_states = bins_registry.size();
+                State bins_succ =
+                    bins_registry.get_successor_state(bins_state, op);
+                State succ = registry.get_successor_state(state, op);
+                ASSERT_EQ(bins_succ.get_id(), succ.get_id());
+                if (bins_registry.size() > num_states) {
+                    queue.push_back(bins_succ.get_id());
+                }
+            }
+        }
+        EXPECT_EQ(registry.size(), bins_registry.size());
+    }
+}
+
+TEST(StateRegistryTestsPublic, test_packed_states_compare_like_values)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+
+    for (StatePacking packing :
+         {StatePacking::BINS,
+          StatePacking::MINIMAL,
+          StatePacking::DICTIONARY}) {
+        StateRegistry registry(
+            *task,
+            StateHashing::PACKED_DATA,
+            nullptr,
+            packing);
+        // Unpack separate copies so that the compared states stay packed.
+        auto get_values = [&](const State& state) {
+            State copy = registry.lookup_state(state.get_id());
+            copy.unpack();
+            return copy.get_unpacked_values();
+        };
+        State initial_state = registry.get_initial_state();
+        std::vector<int> values = get_values(initial_state);
+        EXPECT_EQ(initial_state, State(values));
+        EXPECT_EQ(State(values), initial_state);
+        EXPECT_EQ(
+            initial_state <=> State(values),
+            std::strong_ordering::equal);
+
+        for (OperatorProxy op : task->get_operators()) {
+            if (!task_properties::is_applicable(op, initial_state)) {
+                continue;
+            }
+            State succ = registry.get_successor_state(initial_state, op);
+            std::vector<int> succ_values = get_values(succ);
+            EXPECT_EQ(
+                initial_state == State(succ_values),
+                values == succ_values);
+            EXPECT_EQ(succ, State(succ_values));
+            EXPECT_EQ(
+                initial_state <=> State(succ_values),
+                values <=> succ_values);
+            EXPECT_EQ(
+                State(succ_values) <=> initial_state,
+                succ_values <=> values);
+        }
+    }
+}
+
+TEST(StateRegistryTestsPublic, test_straddling_packer_round_trips_values)
+{
+    // 7 variables of 9 bits each do not fit into two 32-bit bins.
+    std::vector<int> ranges(7, 300);
+    int_packer::IntPacker bins_packer(ranges);
+    int_packer::IntPacker straddling_packer(ranges, true);
+    EXPECT_EQ(bins_packer.get_num_bins(), 3);
+    EXPECT_EQ(straddling_packer.get_num_bins(), 2);
+
+    std::vector<PackedStateBin> buffer(straddling_packer.get_num_bins(), 0);
+    for (int var = 0; var < 7; ++var) {
+        straddling_packer.set(buffer.data(), var, 299 - 40 * var);
+    }
+    // Overwriting a value must not change its neighbours.
+    straddling_packer.set(buffer.data(), 3, 0);
+    straddling_packer.set(buffer.data(), 3, 137);
+    for (int var = 0; var < 7; ++var) {
+        int expected = var == 3 ? 137 : 299 - 40 * var;
+        EXPECT_EQ(straddling_packer.get(buffer.data(), var), expected);
+    }
+}
+
+TEST(StateRegistryTestsPublic, test_bulk_packing_matches_single_variables)
+{
+    std::vector<int> ranges = {2, 300, 1, 5, 70000, 3, 1000, 2, 2, 17, 40000};
+    std::vector<std::vector<int>> possible_values;
+    for (int range : ranges) {
+        if (range == 1) {
+            possible_values.push_back({0});
+        } else {
+            possible_values.push_back({range - 1, 0});
+        }
+    }
+    possible_values[1].push_back(150);
+    int_packer::IntPacker bins_packer(ranges);
+    int_packer::IntPacker straddling_packer(ranges, true);
+    int_packer::IntPacker dictionary_packer(ranges, possible_values);
+
+    for (const int_packer::IntPacker* packer :
+         {&bins_packer, &straddling_packer, &dictionary_packer}) {
+        int num_bins = packer->get_num_bins();
+        for (int i = 0; i < 3; ++i) {
+            std::vector<int> values;
+            for (size_t var = 0; var < ranges.size(); ++var) {
+                const std::vector<int>& var_values = possible_values[var];
+                values.push_back(var_values[(var + i) % var_values.size()]);
+            }
+
+            std::vector<PackedStateBin> single_buffer(num_bins, 0);
+            for (size_t var = 0; var < ranges.size(); ++var) {
+                packer->set(single_buffer.data(), var, values[var]);
+            }
+            // Garbage in the buffer must be overwritten.
+            std::vector<PackedStateBin> bulk_buffer(num_bins, ~0U);
+            packer->pack_all(values.data(), bulk_buffer.data());
+            EXPECT_EQ(bulk_buffer, single_buffer);
+            EXPECT_TRUE(
+                packer->equal(bulk_buffer.data(), single_buffer.data()));
+
+            std::vector<int> unpacked(ranges.size(), -1);
+            packer->unpack_all(bulk_buffer.data(), unpacked.data());
+            EXPECT_EQ(unpacked, values);
+
+            packer->set(single_buffer.data(), 1, values[1] == 0 ? 299 : 0);
+            EXPECT_FALSE(
+                packer->equal(bulk_buffer.data(), single_buffer.data()));
+        }
+    }
+}
+
+TEST(StateRegistryTestsPublic, test_flat_operator_table_matches_task)
+{
+    Gripper domain(2, 3);
+    auto task = create_gripper_task(domain, 3);
+    const flat_operator_table::FlatOperatorTable& flat_operators =
+        flat_operator_table::get_flat_operator_table(*task);
+
+    StateRegistry registry(*task);
+    EXPECT_EQ(registry.get_flat_operators(), &flat_operators);
+    ASSERT_EQ(flat_operators.get_num_operators(), task->get_num_operators());
+    for (OperatorProxy op : task->get_operators()) {
+        int id = op.get_id();
+        EXPECT_EQ(flat_operators.get_cost(id), op.get_cost());
+        std::vector<FactPair> preconditions;
+        for (FactProxy precondition : op.get_preconditions()) {
+            preconditions.push_back(precondition.get_pair());
+        }
+        std::vector<FactPair> effects;
+        for (FactProxy effect : op.get_effects()) {
+            effects.push_back(effect.get_pair());
+        }
+        EXPECT_TRUE(std::ranges::equal(
+            flat_operators.get_preconditions(id),
+            preconditions));
+        EXPECT_TRUE(
+            std::ranges::equal(flat_operators.get_effects(id), effects));
+    }
+}
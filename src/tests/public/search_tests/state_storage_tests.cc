@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/state_storages/mmap_state_storage.h"
+
+#include "downward/heuristic.h"
+#include "downward/per_state_information.h"
+#include "downward/search_algorithm.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/search_utils.h"
+#include "tests/utils/task_utils.h"
+
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+using namespace blind_search_heuristic;
+using namespace tests;
+
+static std::shared_ptr<StateStorage> create_mmap_storage(int chunk_size_in_mb)
+{
+    // The storage removes the file as soon as it has created it.
+    static int num_files = 0;
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("downward_state_storage_test_" + std::to_string(getpid()) + "_" +
+         std::to_string(num_files++));
+    return std::make_shared<mmap_state_storage::MmapStateStorage>(
+        path.string(),
+        chunk_size_in_mb);
+}
+
+TEST(StateStorageTestsPublic, test_mmap_allocations_span_chunks)
+{
+    std::shared_ptr<StateStorage> storage = create_mmap_storage(1);
+    // Each allocation needs a new chunk of 1 MB.
+    const size_t num_bytes = 600 * 1024;
+    std::vector<char*> blocks;
+    for (int i = 0; i < 4; ++i) {
+        char* block = static_cast<char*>(storage->allocate(num_bytes));
+        std::memset(block, 'a' + i, num_bytes);
+        blocks.push_back(block);
+    }
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(blocks[i][0], 'a' + i);
+        EXPECT_EQ(blocks[i][num_bytes - 1], 'a' + i);
+    }
+}
+
+TEST(StateStorageTestsPublic, test_mmap_registry_registers_same_states)
+{
+    Gripper domain(2, 5);
+    auto task = create_gripper_task(domain, 5);
+
+    // Explore the state space in both registries in lockstep.
+    StateRegistry heap_registry(*task);
+    StateRegistry mmap_registry(
+        *task,
+        StateHashing::PACKED_DATA,
+        create_mmap_storage(1));
+    PerStateInformation<int> depths(-1);
+    std::deque<StateID> queue = {heap_registry.get_initial_state().get_id()};
+    EXPECT_EQ(mmap_registry.get_initial_state().get_id(), queue.front());
+    depths[mmap_registry.get_initial_state()] = 0;
+    while (!queue.empty()) {
+        StateID id = queue.front();
+        queue.pop_front();
+        State heap_state = heap_registry.lookup_state(id);
+        State mmap_state = mmap_registry.lookup_state(id);
+        heap_state.unpack();
+        mmap_state.unpack();
+        ASSERT_EQ(
+            heap_state.get_unpacked_values(),
+            mmap_state.get_unpacked_values());
+        int depth = depths[mmap_state];
+        ASSERT_GE(depth, 0);
+        for (OperatorProxy op : task->get_operators()) {
+            if (!task_properties::is_applicable(op, heap_state)) {
+                continue;
+            }
+            size_t num_states = heap_registry.size();
+            State heap_succ = heap_registry.get_successor_state(heap_state, op);
+            State mmap_succ = mmap_registry.get_successor_state(mmap_state, op);
+            ASSERT_EQ(heap_succ.get_id(), mmap_succ.get_id());
+            if (heap_registry.size() > num_states) {
+                depths[mmap_succ] = depth + 1;
+                queue.push_back(heap_succ.get_id());
+            }
+        }
+    }
+    EXPECT_EQ(heap_registry.size(), mmap_registry.size());
+}
+
+TEST(StateStorageTestsPublic, test_mmap_search_expands_like_heap)
+{
+    Gripper domain(2, 4);
+    auto task = create_gripper_task(domain, 4);
+
+    auto heap_search =
+        create_astar_search_engine(task, create_blind_heuristic(task));
+    heap_search->search();
+    ASSERT_EQ(heap_search->get_status(), SOLVED);
+
+    auto mmap_search = create_astar_search_engine(
+        task,
+        create_blind_heuristic(task),
+        create_mmap_storage(1));
+    mmap_search->search();
+    ASSERT_EQ(mmap_search->get_status(), SOLVED);
+
+    EXPECT_EQ(
+        get_plan_cost(*task, mmap_search->get_plan()),
+        get_plan_cost(*task, heap_search->get_plan()));
+    EXPECT_EQ(
+        mmap_search->get_statistics().get_expanded(),
+        heap_search->get_statistics().get_expanded());
+}
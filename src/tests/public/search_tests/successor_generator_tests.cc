@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/incremental_successor_generator.h"
+#include "downward/task_utils/successor_generator.h"
+
+#include "tests/domains/gripper.h"
+
+#include "tests/utils/task_utils.h"
+
+#include <algorithm>
+#include <deque>
+
+using namespace tests;
+
+TEST(SuccessorGeneratorTestsPublic, test_generators_match_tree)
+{
+    Gripper domain(3, 3);
+    auto task = create_gripper_task(domain, 3);
+    successor_generator::SuccessorGenerator tree_generator(
+        *task,
+        SuccessorGeneratorType::TREE);
+    successor_generator::SuccessorGenerator compiled_generator(
+        *task,
+        SuccessorGeneratorType::COMPILED);
+    successor_generator::SuccessorGenerator bitset_generator(
+        *task,
+        SuccessorGeneratorType::BITSET);
+
+    for (StatePacking packing :
+         {StatePacking::BINS,
+          StatePacking::MINIMAL,
+          StatePacking::DICTIONARY}) {
+        StateRegistry registry(
+            *task,
+            StateHashing::PACKED_DATA,
+            nullptr,
+            packing);
+        std::deque<StateID> queue = {registry.get_initial_state().get_id()};
+        while (!queue.empty()) {
+            // The compiled generator reads packed states without unpacking.
+            State state = registry.lookup_state(queue.front());
+            queue.pop_front();
+            std::vector<OperatorID> compiled_ops;
+            compiled_generator.generate_applicable_ops(state, compiled_ops);
+            std::vector<OperatorID> tree_ops;
+            tree_generator.generate_applicable_ops(state, tree_ops);
+            ASSERT_EQ(compiled_ops, tree_ops);
+
+            std::vector<OperatorID> unpacked_ops;
+            compiled_generator.generate_applicable_ops(state, unpacked_ops);
+            EXPECT_EQ(unpacked_ops, tree_ops);
+
+            // The bitset generator sorts the operators by ID.
+            std::vector<OperatorID> bitset_ops;
+            bitset_generator.generate_applicable_ops(
+                registry.lookup_state(state.get_id()),
+                bitset_ops);
+            std::vector<OperatorID> sorted_tree_ops = tree_ops;
+            std::sort(sorted_tree_ops.begin(), sorted_tree_ops.end());
+            EXPECT_EQ(bitset_ops, sorted_tree_ops);
+            bitset_ops.clear();
+            bitset_generator.generate_applicable_ops(state, bitset_ops);
+            EXPECT_EQ(bitset_ops, sorted_tree_ops);
+
+            for (OperatorID op_id : tree_ops) {
+                size_t num_states = registry.size();
+                State succ = registry.get_successor_state(
+                    state,
+                    task->get_operators()[op_id]);
+                if (registry.size() > num_states) {
+                    queue.push_back(succ.get_id());
+                }
+            }
+        }
+    }
+}
+
+TEST(SuccessorGeneratorTestsPublic, test_incremental_generator_matches_tree)
+{
+    Gripper domain(3, 3);
+    auto task = create_gripper_task(domain, 3);
+    successor_generator::SuccessorGenerator tree_generator(*task);
+    successor_generator::IncrementalSuccessorGenerator incremental_generator(
+        *task,
+        tree_generator,
+        100);
+
+    // Explore the state space breadth-first, remembering the first parent.
+    struct Entry {
+        StateID id;
+        StateID parent_id;
+        OperatorID creating_operator;
+    };
+    StateRegistry registry(*task);
+    std::deque<Entry> queue = {
+        {registry.get_initial_state().get_id(),
+         StateID::no_state,
+         OperatorID::no_operator}};
+    while (!queue.empty()) {
+        Entry entry = queue.front();
+        queue.pop_front();
+        State state = registry.lookup_state(entry.id);
+        std::vector<OperatorID> incremental_ops;
+        incremental_generator.generate_applicable_ops(
+            state,
+            entry.parent_id,
+            entry.creating_operator,
+            incremental_ops);
+        std::vector<OperatorID> tree_ops;
+        tree_generator.generate_applicable_ops(state, tree_ops);
+        std::sort(incremental_ops.begin(), incremental_ops.end());
+        std::sort(tree_ops.begin(), tree_ops.end());
+        ASSERT_EQ(incremental_ops, tree_ops);
+
+        for (OperatorID op_id : tree_ops) {
+            size_t num_states = registry.size();
+            State succ = registry.get_successor_state(
+                state,
+                task->get_operators()[op_id]);
+            if (registry.size() > num_states) {
+                queue.push_back({succ.get_id(), state.get_id(), op_id});
+            }
+        }
+    }
+}
@@ -1,8 +1,14 @@
 #include "tests/utils/search_utils.h"
 
+#include <gtest/gtest.h>
+
+#include "downward/heuristics/blind_search_heuristic.h"
 #include "downward/search_algorithms/eager_search.h"
 #include "downward/search_algorithms/search_common.h"
 
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/heuristic.h"
 #include "downward/open_list_factory.h"
 
 #include <set>
@@ -11,8 +17,12 @@ namespace tests {
 
 std::unique_ptr<SearchAlgorithm> create_astar_search_engine(
     std::shared_ptr<ClassicalPlanningTask> task,
-    std::shared_ptr<Evaluator> evaluator)
+    std::shared_ptr<Evaluator> evaluator,
+    std::shared_ptr<StateStorage> state_storage)
 {
+    if (!state_storage) {
+        state_storage = std::make_shared<HeapStateStorage>();
+    }
     auto [open_list_factory, eval] =
         search_common::create_astar_open_list_factory_and_f_eval(
             evaluator,
@@ -23,12 +33,46 @@ std::unique_ptr<SearchAlgorithm> create_astar_search_engine(
         eval,
         std::vector<std::shared_ptr<Evaluator>>{},
         std::shared_ptr<CachedHeuristic>(),
+        true,
+        0,
+        nullptr,
+        1,
         std::move(task),
         OperatorCost::NORMAL,
         std::numeric_limits<int>::max(),
         std::numeric_limits<double>::infinity(),
+        StateHashing::PACKED_DATA,
+        std::move(state_storage),
+        StatePacking::BINS,
+        SuccessorGeneratorType::TREE,
         "astar",
         utils::Verbosity::SILENT);
 }
 
+int compute_optimal_cost(const std::shared_ptr<ClassicalPlanningTask>& task)
+{
+    std::unique_ptr<SearchAlgorithm> astar = create_astar_search_engine(
+        task,
+        blind_search_heuristic::create_blind_heuristic(task));
+    astar->search();
+    EXPECT_EQ(astar->get_status(), SOLVED);
+    return calculate_plan_cost(astar->get_plan(), *task);
+}
+
+int get_plan_cost(
+    const ClassicalPlanningTask& task,
+    const std::vector<OperatorID>& plan)
+{
+    State state = task.get_initial_state();
+    int cost = 0;
+    for (OperatorID op_id : plan) {
+        OperatorProxy op = task.get_operators()[op_id];
+        EXPECT_TRUE(task_properties::is_applicable(op, state));
+        state = get_unregistered_successor(state, op);
+        cost += op.get_cost();
+    }
+    EXPECT_TRUE(task_properties::is_goal_state(task, state));
+    return cost;
+}
+
 }
\ No newline at end of file
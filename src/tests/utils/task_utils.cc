@@ -1,6 +1,7 @@
 #include "tests/utils/task_utils.h"
 
 #include "tests/domains/classical_planning_domain.h"
+#include "tests/domains/gripper.h"
 
 #include "probfd/probabilistic_task.h"
 
@@ -236,6 +237,21 @@ std::shared_ptr<ClassicalPlanningTask> create_task_from_domain(
         std::move(goal));
 }
 
+std::shared_ptr<ClassicalPlanningTask>
+create_gripper_task(const Gripper& domain, int num_balls)
+{
+    std::vector<FactPair> initial_state = {
+        domain.get_fact_robot_at_room(0),
+        domain.get_fact_carry_left_none(),
+        domain.get_fact_carry_right_none()};
+    std::vector<FactPair> goal;
+    for (int ball = 0; ball < num_balls; ++ball) {
+        initial_state.push_back(domain.get_fact_ball_at_room(ball, 0));
+        goal.push_back(domain.get_fact_ball_at_room(ball, 1));
+    }
+    return create_task_from_domain(domain, initial_state, goal);
+}
+
 std::unique_ptr<ProbabilisticPlanningTask>
 to_probabilistic_task(std::shared_ptr<ClassicalPlanningTask> deterministic_task)
 {